@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace bdn
+{
+    /** Opt-in instrumentation for Notifier and property Backing notifications.
+
+        While enabled() is false, a Notifier only pays for a single relaxed atomic load per notify() call.
+        Once enabled, every notification is counted per notifier, the time spent in subscriber
+        callbacks is measured and notification storms (more than stormThreshold() notifications of
+        a single notifier within one dispatch cycle) are reported. A dispatch cycle is the cascade
+        of notifications that is started by a top-level notify() call on the current thread.
+
+        Notifiers are identified by their address. Backings register their notifier together with
+        an optional debug name (see Backing::setDebugName()) and record an edge for every
+        Backing::bind() call, so that the live binding graph can be dumped with toDot() or
+        toJson().
+    */
+    class BindingInstrumentation
+    {
+      public:
+        using Duration = std::chrono::duration<double>;
+
+        struct Statistics
+        {
+            std::string debugName;
+            size_t notificationCount = 0;
+            size_t subscriberCallCount = 0;
+            size_t maximumFanOut = 0;
+            size_t stormCount = 0;
+            Duration callbackTime{0};
+        };
+
+        using StatisticsMap = std::map<const void *, Statistics>;
+        using StormHandler = std::function<void(const void *notifier, const std::string &debugName, size_t count)>;
+
+      public:
+        static std::atomic<bool> &enabled();
+        static std::atomic<size_t> &stormThreshold();
+
+        /** Sets the function that is called when a storm is detected. By default storms are logged
+            via bdn::logInfo. Pass nullptr to restore the default. */
+        static void setStormHandler(StormHandler handler);
+
+      public:
+        static void setDebugName(const void *notifier, std::string debugName);
+        static std::string debugName(const void *notifier);
+
+        static void addEdge(const void *sourceNotifier, const void *targetNotifier);
+        static void removeEdge(const void *sourceNotifier, const void *targetNotifier);
+
+        /** Removes all data recorded for a notifier that is about to be destroyed.*/
+        static void forget(const void *notifier);
+
+      public:
+        static StatisticsMap statistics();
+        static void reset();
+
+        static std::string toDot();
+        static std::string toJson();
+
+      public:
+        /** Records a single notify() call. Created by Notifier while instrumentation is enabled.*/
+        class Dispatch
+        {
+          public:
+            Dispatch(const void *notifier, size_t subscriberCount);
+            ~Dispatch();
+
+            Dispatch(const Dispatch &) = delete;
+            Dispatch &operator=(const Dispatch &) = delete;
+
+            void subscriberCalled(Duration duration);
+
+          private:
+            const void *_notifier;
+            size_t _subscriberCalls = 0;
+            Duration _callbackTime{0};
+        };
+    };
+}
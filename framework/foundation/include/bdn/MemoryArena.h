@@ -0,0 +1,205 @@
+#pragma once
+
+#include <bdn/GlobalStack.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace bdn
+{
+    /** A memory resource that groups the many small allocations made while building a screen.
+
+        Allocations are routed into an arena by creating objects with allocateShared() or containers
+        with ArenaAllocator while a MemoryArena::Scope is active on the current thread. Properties,
+        notifiers and view cores use the current arena automatically, views remember the arena that
+        was active when they were constructed and use it again when their core is created lazily.
+
+        A Monotonic arena never frees individual allocations; all memory is released at once when the
+        last object allocated from it is destroyed. A Pooled arena reuses freed blocks of the same
+        size. Both are backed by std::pmr resources where the standard library provides them and fall
+        back to the global heap otherwise.
+
+        Every object allocated from an arena keeps the arena alive, so it is safe to let objects
+        outlive the scope they were created in.
+
+        Arenas are not synchronized: an arena and the objects allocated from it must only be used by
+        one thread at a time. Handing them to another thread through a DispatchQueue is fine.
+        buildViewTreeAsync() gives the worker its own arena for that reason.
+
+        Without an active scope allocations go to the global heap and cost the same as with
+        std::allocator and std::make_shared: ArenaAllocator only holds a plain pointer and touches
+        no reference count while it has no arena.
+    */
+    class MemoryArena : public std::enable_shared_from_this<MemoryArena>
+    {
+        template <class T> friend class ArenaAllocator;
+
+      public:
+        enum class Kind
+        {
+            Monotonic,
+            Pooled
+        };
+
+        struct Statistics
+        {
+            size_t allocationCount = 0;
+            size_t deallocationCount = 0;
+            size_t bytesAllocated = 0;
+            size_t bytesInUse = 0;
+            size_t peakBytesInUse = 0;
+        };
+
+        /** Activates an arena for allocations made on the current thread until the scope ends.*/
+        class Scope
+        {
+          public:
+            explicit Scope(std::shared_ptr<MemoryArena> arena) { Stack::push(std::move(arena)); }
+            ~Scope() { Stack::pop(); }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+        };
+
+      public:
+        static std::shared_ptr<MemoryArena> create(Kind kind = Kind::Pooled, size_t initialSize = 64 * 1024);
+
+        /** Returns the arena of the innermost active Scope on the current thread, or nullptr.*/
+        static std::shared_ptr<MemoryArena> current() { return Stack::top(); }
+
+        /** Like current(), but returns a plain pointer and does not copy the std::shared_ptr.*/
+        static MemoryArena *active() { return Stack::top().get(); }
+
+      public:
+        MemoryArena(const MemoryArena &) = delete;
+        MemoryArena &operator=(const MemoryArena &) = delete;
+        virtual ~MemoryArena() = default;
+
+        virtual void *allocate(size_t bytes, size_t alignment) = 0;
+        virtual void deallocate(void *pointer, size_t bytes, size_t alignment) = 0;
+
+        virtual Statistics statistics() const = 0;
+
+        Kind kind() const { return _kind; }
+
+      protected:
+        MemoryArena(Kind kind) : _kind(kind) {}
+
+      private:
+        static std::shared_ptr<MemoryArena> noArena() { return nullptr; }
+        using Stack = GlobalStack<std::shared_ptr<MemoryArena>, &noArena>;
+
+        // Allocators keep the arena alive through a single std::shared_ptr to itself, which is held
+        // while at least one allocator refers to the arena.
+        void retain();
+        // For allocators copied from one that already retains the arena
+        void retainAgain() noexcept { _retainCount.fetch_add(1, std::memory_order_relaxed); }
+        void release() noexcept;
+
+      private:
+        Kind _kind;
+
+        std::atomic<size_t> _retainCount{0};
+        std::shared_ptr<MemoryArena> _self;
+    };
+
+    /** Standard allocator that allocates from a MemoryArena, or from the global heap if it has none.
+
+        A default constructed ArenaAllocator uses MemoryArena::active(). Copies of an allocator with an
+        arena keep the arena alive; an allocator without one is a plain null pointer.*/
+    template <class T> class ArenaAllocator
+    {
+        template <class U> friend class ArenaAllocator;
+
+      public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+      public:
+        ArenaAllocator() : ArenaAllocator(MemoryArena::active()) {}
+        explicit ArenaAllocator(MemoryArena *arena) : _arena(arena)
+        {
+            if (_arena) {
+                _arena->retain();
+            }
+        }
+        explicit ArenaAllocator(const std::shared_ptr<MemoryArena> &arena) : ArenaAllocator(arena.get()) {}
+
+        // Copies and moves only increment the retain count of the arena. A moved-from allocator keeps
+        // its arena, as the standard allocator requirements demand.
+        ArenaAllocator(const ArenaAllocator &other) noexcept : ArenaAllocator(other, 0) {}
+        ArenaAllocator(ArenaAllocator &&other) noexcept : ArenaAllocator(other, 0) {}
+        template <class U> ArenaAllocator(const ArenaAllocator<U> &other) noexcept : ArenaAllocator(other, 0) {}
+
+        ~ArenaAllocator()
+        {
+            if (_arena) {
+                _arena->release();
+            }
+        }
+
+        ArenaAllocator &operator=(const ArenaAllocator &other) noexcept
+        {
+            if (other._arena) {
+                other._arena->retainAgain();
+            }
+            if (_arena) {
+                _arena->release();
+            }
+            _arena = other._arena;
+            return *this;
+        }
+
+        ArenaAllocator &operator=(ArenaAllocator &&other) noexcept
+        {
+            return *this = static_cast<const ArenaAllocator &>(other);
+        }
+
+        T *allocate(size_t count)
+        {
+            if (_arena) {
+                return static_cast<T *>(_arena->allocate(count * sizeof(T), alignof(T)));
+            }
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T *pointer, size_t count)
+        {
+            if (_arena) {
+                _arena->deallocate(pointer, count * sizeof(T), alignof(T));
+            } else {
+                std::allocator<T>().deallocate(pointer, count);
+            }
+        }
+
+        MemoryArena *arena() const { return _arena; }
+
+        template <class U> bool operator==(const ArenaAllocator<U> &other) const { return _arena == other._arena; }
+        template <class U> bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other._arena; }
+
+      private:
+        template <class U> ArenaAllocator(const ArenaAllocator<U> &other, int /*copy*/) noexcept : _arena(other._arena)
+        {
+            if (_arena) {
+                _arena->retainAgain();
+            }
+        }
+
+      private:
+        MemoryArena *_arena;
+    };
+
+    /** Like std::make_shared, but allocates from MemoryArena::active() if a scope is active.*/
+    template <class T, class... Arguments> std::shared_ptr<T> allocateShared(Arguments &&... arguments)
+    {
+        if (auto *arena = MemoryArena::active()) {
+            return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Arguments>(arguments)...);
+        }
+        return std::make_shared<T>(std::forward<Arguments>(arguments)...);
+    }
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <bdn/BindingInstrumentation.h>
+#include <bdn/MemoryArena.h>
+
 #include <functional>
 #include <list>
 #include <map>
@@ -35,9 +38,24 @@ namespace bdn
         using Target = std::function<void(Arguments...)>;
 
       private:
-        using SubscriptionMap = std::map<Subscription, Target>;
+        using SubscriptionMap = std::map<Subscription, Target, std::less<Subscription>,
+                                         ArenaAllocator<std::pair<const Subscription, Target>>>;
         using NotificationRun = typename SubscriptionMap::iterator;
 
+      public:
+        Notifier() = default;
+        Notifier(const Notifier &) = default;
+        Notifier(Notifier &&) = default;
+        Notifier &operator=(const Notifier &) = default;
+        Notifier &operator=(Notifier &&) = default;
+
+        ~Notifier()
+        {
+            if (_instrumented) {
+                BindingInstrumentation::forget(this);
+            }
+        }
+
       public:
         Subscription subscribe(Target target)
         {
@@ -126,6 +144,23 @@ namespace bdn
 
       private:
         void notifyFrom(typename SubscriptionMap::iterator itStart, Arguments... arguments)
+        {
+            if (!BindingInstrumentation::enabled().load(std::memory_order_relaxed)) {
+                run(itStart, [&](const Target &target) { target(arguments...); });
+                return;
+            }
+
+            // The statistics are keyed by address and must be forgotten when this notifier goes away
+            _instrumented = true;
+            BindingInstrumentation::Dispatch dispatch(this, _subscriptions.size());
+            run(itStart, [&](const Target &target) {
+                auto start = std::chrono::steady_clock::now();
+                target(arguments...);
+                dispatch.subscriberCalled(std::chrono::steady_clock::now() - start);
+            });
+        }
+
+        template <class Call> void run(typename SubscriptionMap::iterator itStart, Call &&call)
         {
             auto itRun = _notificationRuns.insert(_notificationRuns.end(), itStart);
 
@@ -133,7 +168,7 @@ namespace bdn
             auto it = notificationRun;
             do {
                 notificationRun++;
-                it->second(arguments...);
+                call(it->second);
                 it = notificationRun;
             } while (it != _subscriptions.end());
 
@@ -149,10 +184,11 @@ namespace bdn
             return 0;
         }
 
-        Subscription createSubscription() { return std::make_shared<_Subscription>(_Subscription{nextId()}); }
+        Subscription createSubscription() { return allocateShared<_Subscription>(_Subscription{nextId()}); }
 
       private:
         SubscriptionMap _subscriptions;
         std::list<NotificationRun> _notificationRuns;
+        bool _instrumented = false;
     };
 }
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <bdn/Notifier.h>
+
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace bdn
+{
+    /** Describes which keys of a keyed collection were inserted, removed or updated.*/
+    template <class Key> struct KeyChangeSet
+    {
+        std::vector<Key> inserted;
+        std::vector<Key> removed;
+        std::vector<Key> updated;
+
+        bool empty() const { return inserted.empty() && removed.empty() && updated.empty(); }
+    };
+
+    /** A map that notifies subscribers about which keys changed.
+
+        Every mutating call notifies onChange() with a KeyChangeSet describing only the affected keys.
+        Mutations made between beginUpdates() and endUpdates() (or inside update()) are coalesced into
+        a single change set: a key that is inserted and removed again within the same batch is not
+        reported at all, a key that is removed and inserted again is reported as updated.
+    */
+    template <class Key, class Value, class Compare = std::less<Key>> class ObservableMap
+    {
+      public:
+        using map_t = std::map<Key, Value, Compare>;
+        using const_iterator = typename map_t::const_iterator;
+        using change_set_t = KeyChangeSet<Key>;
+        using notifier_t = Notifier<const ObservableMap &, const change_set_t &>;
+
+      public:
+        ObservableMap() = default;
+        ObservableMap(map_t items) : _items(std::move(items)) {}
+
+        ObservableMap(const ObservableMap &) = delete;
+        ObservableMap &operator=(const ObservableMap &) = delete;
+
+      public:
+        notifier_t &onChange() { return _onChange; }
+
+        size_t size() const { return _items.size(); }
+        bool empty() const { return _items.empty(); }
+        bool contains(const Key &key) const { return _items.find(key) != _items.end(); }
+
+        const Value &at(const Key &key) const { return _items.at(key); }
+        const_iterator find(const Key &key) const { return _items.find(key); }
+
+        const_iterator begin() const { return _items.begin(); }
+        const_iterator end() const { return _items.end(); }
+
+        const map_t &items() const { return _items; }
+
+      public:
+        /** Inserts or replaces the value for key.*/
+        void set(const Key &key, Value value)
+        {
+            auto it = _items.find(key);
+            if (it == _items.end()) {
+                _items.emplace(key, std::move(value));
+                changed(key, Change::Inserted);
+            } else {
+                it->second = std::move(value);
+                changed(key, Change::Updated);
+            }
+        }
+
+        /** Modifies the value for an existing key in place and reports it as updated.*/
+        template <class Function> void modify(const Key &key, Function &&function)
+        {
+            auto it = _items.find(key);
+            if (it == _items.end()) {
+                throw std::out_of_range("ObservableMap key not found");
+            }
+            function(it->second);
+            changed(key, Change::Updated);
+        }
+
+        bool erase(const Key &key)
+        {
+            auto it = _items.find(key);
+            if (it == _items.end()) {
+                return false;
+            }
+            _items.erase(it);
+            changed(key, Change::Removed);
+            return true;
+        }
+
+        void clear()
+        {
+            update([this]() {
+                while (!_items.empty()) {
+                    erase(_items.begin()->first);
+                }
+            });
+        }
+
+      public:
+        void beginUpdates() { _updateDepth++; }
+
+        void endUpdates()
+        {
+            if (_updateDepth == 0) {
+                throw std::logic_error("ObservableMap::endUpdates() called without beginUpdates()");
+            }
+            if (--_updateDepth > 0) {
+                return;
+            }
+
+            change_set_t changeSet;
+            for (const auto &[key, state] : _pending) {
+                bool existsNow = _items.find(key) != _items.end();
+                if (state.existedBefore && !existsNow) {
+                    changeSet.removed.push_back(key);
+                } else if (!state.existedBefore && existsNow) {
+                    changeSet.inserted.push_back(key);
+                } else if (state.existedBefore && existsNow) {
+                    changeSet.updated.push_back(key);
+                }
+            }
+            _pending.clear();
+
+            if (!changeSet.empty()) {
+                _onChange.notify(*this, changeSet);
+            }
+        }
+
+        template <class Function> void update(Function &&function)
+        {
+            beginUpdates();
+            try {
+                function();
+            }
+            catch (...) {
+                endUpdates();
+                throw;
+            }
+            endUpdates();
+        }
+
+        bool isUpdating() const { return _updateDepth > 0; }
+
+      private:
+        enum class Change
+        {
+            Inserted,
+            Removed,
+            Updated
+        };
+
+        struct PendingState
+        {
+            bool existedBefore;
+        };
+
+        void changed(const Key &key, Change change)
+        {
+            if (_updateDepth > 0) {
+                // Only the first change of a key within a batch tells us whether it existed before
+                _pending.emplace(key, PendingState{change != Change::Inserted});
+                return;
+            }
+
+            change_set_t changeSet;
+            switch (change) {
+            case Change::Inserted:
+                changeSet.inserted.push_back(key);
+                break;
+            case Change::Removed:
+                changeSet.removed.push_back(key);
+                break;
+            case Change::Updated:
+                changeSet.updated.push_back(key);
+                break;
+            }
+            _onChange.notify(*this, changeSet);
+        }
+
+      private:
+        map_t _items;
+        notifier_t _onChange;
+
+        size_t _updateDepth = 0;
+        std::map<Key, PendingState, Compare> _pending;
+    };
+}
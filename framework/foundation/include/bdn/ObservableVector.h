@@ -0,0 +1,356 @@
+#pragma once
+
+#include <bdn/Notifier.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace bdn
+{
+    /** Describes the difference between two states of an indexed collection.
+
+        Removed ranges refer to indices in the old collection, inserted ranges and updated indices refer
+        to indices in the new collection. A move describes an element that was kept but changed its
+        relative order, from its old index to its new index. Kept elements that are neither moved nor
+        removed keep their relative order.
+
+        To mirror the change in another list, remove the removed ranges (from the back), then insert the
+        inserted ranges (from the front) and apply the moves.
+    */
+    struct IndexChangeSet
+    {
+        struct Range
+        {
+            size_t index;
+            size_t count;
+
+            bool operator==(const Range &other) const { return index == other.index && count == other.count; }
+        };
+
+        struct Move
+        {
+            size_t from;
+            size_t to;
+
+            bool operator==(const Move &other) const { return from == other.from && to == other.to; }
+        };
+
+        std::vector<Range> removed;
+        std::vector<Range> inserted;
+        std::vector<Move> moved;
+        std::vector<size_t> updated;
+
+        bool empty() const { return removed.empty() && inserted.empty() && moved.empty() && updated.empty(); }
+    };
+
+    /** A vector that notifies subscribers about which elements changed.
+
+        Every mutating call notifies onChange() with an IndexChangeSet describing only the affected
+        elements. Mutations made between beginUpdates() and endUpdates() (or inside update()) are
+        coalesced into a single change set that is sent when the outermost endUpdates() is called.
+    */
+    template <class T> class ObservableVector
+    {
+      public:
+        using value_type = T;
+        using const_iterator = typename std::vector<T>::const_iterator;
+        using notifier_t = Notifier<const ObservableVector &, const IndexChangeSet &>;
+
+      public:
+        ObservableVector() = default;
+        ObservableVector(std::vector<T> items) : _items(std::move(items)) {}
+        ObservableVector(std::initializer_list<T> items) : _items(items) {}
+
+        ObservableVector(const ObservableVector &) = delete;
+        ObservableVector &operator=(const ObservableVector &) = delete;
+
+      public:
+        notifier_t &onChange() { return _onChange; }
+
+        size_t size() const { return _items.size(); }
+        bool empty() const { return _items.empty(); }
+
+        const T &operator[](size_t index) const { return _items[index]; }
+        const T &at(size_t index) const { return _items.at(index); }
+
+        const_iterator begin() const { return _items.begin(); }
+        const_iterator end() const { return _items.end(); }
+
+        const std::vector<T> &items() const { return _items; }
+
+      public:
+        void push_back(T value) { insert(_items.size(), std::move(value)); }
+
+        void insert(size_t index, T value)
+        {
+            checkIndex(index, _items.size() + 1);
+            _items.insert(_items.begin() + index, std::move(value));
+            inserted(index, 1);
+        }
+
+        template <class InputIt> void insert(size_t index, InputIt first, InputIt last)
+        {
+            checkIndex(index, _items.size() + 1);
+            size_t oldSize = _items.size();
+            _items.insert(_items.begin() + index, first, last);
+            size_t count = _items.size() - oldSize;
+            if (count > 0) {
+                inserted(index, count);
+            }
+        }
+
+        void erase(size_t index, size_t count = 1)
+        {
+            if (count == 0) {
+                return;
+            }
+            checkIndex(index + count - 1, _items.size());
+            _items.erase(_items.begin() + index, _items.begin() + index + count);
+            removed(index, count);
+        }
+
+        /** Moves the element at index from so that it ends up at index to.*/
+        void move(size_t from, size_t to)
+        {
+            checkIndex(from, _items.size());
+            checkIndex(to, _items.size());
+            if (from == to) {
+                return;
+            }
+            rotate(_items, from, to);
+            moved(from, to);
+        }
+
+        void set(size_t index, T value)
+        {
+            checkIndex(index, _items.size());
+            _items[index] = std::move(value);
+            updated(index);
+        }
+
+        /** Modifies the element at index in place and reports it as updated.*/
+        template <class Function> void modify(size_t index, Function &&function)
+        {
+            checkIndex(index, _items.size());
+            function(_items[index]);
+            updated(index);
+        }
+
+        void clear() { erase(0, _items.size()); }
+
+        void assign(std::vector<T> items)
+        {
+            beginUpdates();
+            clear();
+            _items = std::move(items);
+            if (!_items.empty()) {
+                inserted(0, _items.size());
+            }
+            endUpdates();
+        }
+
+      public:
+        void beginUpdates()
+        {
+            if (_updateDepth++ == 0) {
+                _batchOldSize = _items.size();
+                _origin.resize(_items.size());
+                for (size_t i = 0; i < _origin.size(); i++) {
+                    _origin[i] = i;
+                }
+                _updatedFlags.assign(_items.size(), 0);
+                _batchHasMoves = false;
+            }
+        }
+
+        void endUpdates()
+        {
+            if (_updateDepth == 0) {
+                throw std::logic_error("ObservableVector::endUpdates() called without beginUpdates()");
+            }
+            if (--_updateDepth == 0) {
+                IndexChangeSet changeSet = batchChangeSet();
+                _origin.clear();
+                _updatedFlags.clear();
+                if (!changeSet.empty()) {
+                    _onChange.notify(*this, changeSet);
+                }
+            }
+        }
+
+        template <class Function> void update(Function &&function)
+        {
+            beginUpdates();
+            try {
+                function();
+            }
+            catch (...) {
+                endUpdates();
+                throw;
+            }
+            endUpdates();
+        }
+
+        bool isUpdating() const { return _updateDepth > 0; }
+
+      private:
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        static void checkIndex(size_t index, size_t limit)
+        {
+            if (index >= limit) {
+                throw std::out_of_range("ObservableVector index out of range");
+            }
+        }
+
+        template <class V> static void rotate(std::vector<V> &vector, size_t from, size_t to)
+        {
+            if (from < to) {
+                std::rotate(vector.begin() + from, vector.begin() + from + 1, vector.begin() + to + 1);
+            } else {
+                std::rotate(vector.begin() + to, vector.begin() + from, vector.begin() + from + 1);
+            }
+        }
+
+        void inserted(size_t index, size_t count)
+        {
+            if (_updateDepth > 0) {
+                _origin.insert(_origin.begin() + index, count, npos);
+                _updatedFlags.insert(_updatedFlags.begin() + index, count, 0);
+                return;
+            }
+            IndexChangeSet changeSet;
+            changeSet.inserted.push_back({index, count});
+            _onChange.notify(*this, changeSet);
+        }
+
+        void removed(size_t index, size_t count)
+        {
+            if (_updateDepth > 0) {
+                _origin.erase(_origin.begin() + index, _origin.begin() + index + count);
+                _updatedFlags.erase(_updatedFlags.begin() + index, _updatedFlags.begin() + index + count);
+                return;
+            }
+            IndexChangeSet changeSet;
+            changeSet.removed.push_back({index, count});
+            _onChange.notify(*this, changeSet);
+        }
+
+        void moved(size_t from, size_t to)
+        {
+            if (_updateDepth > 0) {
+                rotate(_origin, from, to);
+                rotate(_updatedFlags, from, to);
+                _batchHasMoves = true;
+                return;
+            }
+            IndexChangeSet changeSet;
+            changeSet.moved.push_back({from, to});
+            _onChange.notify(*this, changeSet);
+        }
+
+        void updated(size_t index)
+        {
+            if (_updateDepth > 0) {
+                _updatedFlags[index] = 1;
+                return;
+            }
+            IndexChangeSet changeSet;
+            changeSet.updated.push_back(index);
+            _onChange.notify(*this, changeSet);
+        }
+
+        static void appendToRanges(std::vector<IndexChangeSet::Range> &ranges, size_t index)
+        {
+            if (!ranges.empty() && ranges.back().index + ranges.back().count == index) {
+                ranges.back().count++;
+            } else {
+                ranges.push_back({index, 1});
+            }
+        }
+
+        IndexChangeSet batchChangeSet() const
+        {
+            IndexChangeSet changeSet;
+
+            std::vector<char> kept(_batchOldSize, 0);
+            std::vector<size_t> keptPositions;
+
+            for (size_t i = 0; i < _origin.size(); i++) {
+                if (_origin[i] == npos) {
+                    appendToRanges(changeSet.inserted, i);
+                } else {
+                    kept[_origin[i]] = 1;
+                    if (_batchHasMoves) {
+                        keptPositions.push_back(i);
+                    }
+                    if (_updatedFlags[i]) {
+                        changeSet.updated.push_back(i);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < _batchOldSize; i++) {
+                if (!kept[i]) {
+                    appendToRanges(changeSet.removed, i);
+                }
+            }
+
+            if (!_batchHasMoves) {
+                return changeSet;
+            }
+
+            // Kept elements on the longest increasing subsequence of old indices stay in place,
+            // all others are reported as moves.
+            std::vector<bool> stable = longestIncreasingSubsequence(keptPositions);
+            for (size_t i = 0; i < keptPositions.size(); i++) {
+                if (!stable[i]) {
+                    changeSet.moved.push_back({_origin[keptPositions[i]], keptPositions[i]});
+                }
+            }
+
+            return changeSet;
+        }
+
+        std::vector<bool> longestIncreasingSubsequence(const std::vector<size_t> &positions) const
+        {
+            std::vector<size_t> tails;
+            std::vector<size_t> tailIndices;
+            std::vector<size_t> predecessors(positions.size(), npos);
+
+            for (size_t i = 0; i < positions.size(); i++) {
+                size_t value = _origin[positions[i]];
+                size_t length = std::lower_bound(tails.begin(), tails.end(), value) - tails.begin();
+                if (length == tails.size()) {
+                    tails.push_back(value);
+                    tailIndices.push_back(i);
+                } else {
+                    tails[length] = value;
+                    tailIndices[length] = i;
+                }
+                predecessors[i] = length > 0 ? tailIndices[length - 1] : npos;
+            }
+
+            std::vector<bool> result(positions.size(), false);
+            size_t current = tailIndices.empty() ? npos : tailIndices.back();
+            while (current != npos) {
+                result[current] = true;
+                current = predecessors[current];
+            }
+            return result;
+        }
+
+      private:
+        std::vector<T> _items;
+        notifier_t _onChange;
+
+        size_t _updateDepth = 0;
+        size_t _batchOldSize = 0;
+        bool _batchHasMoves = false;
+        std::vector<size_t> _origin;
+        std::vector<char> _updatedFlags;
+    };
+}
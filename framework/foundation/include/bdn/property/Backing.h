@@ -1,7 +1,9 @@
 #pragma once
 
+#include <bdn/BindingInstrumentation.h>
 #include <bdn/Notifier.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -31,7 +33,13 @@ namespace bdn
 
       public:
         Backing() {}
-        virtual ~Backing() { unbind(); }
+        virtual ~Backing()
+        {
+            unbind();
+            if (_instrumented) {
+                BindingInstrumentation::forget(&_onChange);
+            }
+        }
 
         virtual ValType get() const = 0;
         virtual void set(const ValType &value, bool notify = true) = 0;
@@ -40,6 +48,13 @@ namespace bdn
 
         notifier_t &onChange() { return _onChange; }
 
+        /** Names this backing in the output of BindingInstrumentation. */
+        void setDebugName(std::string debugName)
+        {
+            _instrumented = true;
+            BindingInstrumentation::setDebugName(&_onChange, std::move(debugName));
+        }
+
         template <typename OtherType> void bind(std::shared_ptr<Backing<OtherType>> sourceBacking)
         {
             static_assert(std::is_convertible<OtherType, ValType>::value ||
@@ -51,10 +66,20 @@ namespace bdn
 
             std::weak_ptr<Backing<OtherType>> weakSourceBacking = sourceBacking;
 
-            Binding binding = [subscription, weakSourceBacking]() {
+            const void *sourceNotifier = &sourceBacking->onChange();
+            bool instrumented = BindingInstrumentation::enabled();
+            if (instrumented) {
+                _instrumented = true;
+                BindingInstrumentation::addEdge(sourceNotifier, &_onChange);
+            }
+
+            Binding binding = [this, subscription, weakSourceBacking, sourceNotifier, instrumented]() {
                 if (auto source = weakSourceBacking.lock()) {
                     source->onChange().unsubscribe(subscription);
                 }
+                if (instrumented) {
+                    BindingInstrumentation::removeEdge(sourceNotifier, &_onChange);
+                }
             };
 
             _bindings.push_back(binding);
@@ -62,6 +87,9 @@ namespace bdn
             bindSourceChanged(sourceBacking);
         }
 
+        /** Returns the number of backings this backing is bound to.*/
+        size_t bindingCount() const { return _bindings.size(); }
+
         void unbind()
         {
             for (const auto &unbind : _bindings) {
@@ -82,5 +110,8 @@ namespace bdn
         using Binding = std::function<void()>;
 
         std::vector<Binding> _bindings;
+
+      private:
+        bool _instrumented = false;
     };
 }
@@ -46,7 +46,7 @@ namespace bdn
       public:
         using backing_t = Backing<ValType>;
 
-        Property() : _backing(std::make_shared<value_backing_t>()) { init(); }
+        Property() : _backing(allocateShared<value_backing_t>()) { init(); }
         Property(Property &other) : _backing(other.backing()) { init(); }
         Property(const Property &) = delete;
         ~Property()
@@ -56,7 +56,7 @@ namespace bdn
             }
         }
 
-        Property(ValType value) : _backing(std::make_shared<value_backing_t>())
+        Property(ValType value) : _backing(allocateShared<value_backing_t>())
         {
             init();
             set(value, false /* do not notify on initial set */);
@@ -64,25 +64,25 @@ namespace bdn
 
         Property(const GetterSetterBacking<ValType> &getterSetter)
         {
-            _backing = std::make_shared<gs_backing_t>(getterSetter);
+            _backing = allocateShared<gs_backing_t>(getterSetter);
             init();
         }
 
         Property(const SetterBacking<ValType> &setter)
         {
-            _backing = std::make_shared<setter_backing_t>(setter);
+            _backing = allocateShared<setter_backing_t>(setter);
             init();
         }
 
         Property(const StreamBacking &stream)
         {
-            _backing = std::make_shared<StreamBacking>(stream);
+            _backing = allocateShared<StreamBacking>(stream);
             init();
         }
 
         template <class U> Property(const TransformBacking<ValType, U> &transform)
         {
-            _backing = std::make_shared<TransformBacking<ValType, U>>(transform);
+            _backing = allocateShared<TransformBacking<ValType, U>>(transform);
             init();
         }
 
@@ -93,7 +93,7 @@ namespace bdn
         }
 
         template <class _Rep, class _Period>
-        Property(const std::chrono::duration<_Rep, _Period> &duration) : _backing(std::make_shared<value_backing_t>())
+        Property(const std::chrono::duration<_Rep, _Period> &duration) : _backing(allocateShared<value_backing_t>())
         {
             init();
             set(std::chrono::duration_cast<ValType>(duration), false);
@@ -105,6 +105,8 @@ namespace bdn
 
         const auto backing() const { return _backing; }
 
+        void setDebugName(std::string debugName) { _backing->setDebugName(std::move(debugName)); }
+
       public:
         template <class OtherType>
         void bind(const Property<OtherType> &sourceProperty, BindMode bindMode = BindMode::bidirectional)
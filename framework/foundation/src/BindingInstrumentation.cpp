@@ -0,0 +1,245 @@
+#include <bdn/BindingInstrumentation.h>
+#include <bdn/Json.h>
+#include <bdn/log.h>
+
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+namespace bdn
+{
+    namespace
+    {
+        struct InstrumentationData
+        {
+            std::mutex mutex;
+            BindingInstrumentation::StatisticsMap statistics;
+            std::set<std::pair<const void *, const void *>> edges;
+            BindingInstrumentation::StormHandler stormHandler;
+        };
+
+        InstrumentationData &data()
+        {
+            static InstrumentationData instance;
+            return instance;
+        }
+
+        struct DispatchCycle
+        {
+            size_t depth = 0;
+            std::unordered_map<const void *, size_t> notificationCounts;
+        };
+
+        DispatchCycle &currentCycle()
+        {
+            static thread_local DispatchCycle cycle;
+            return cycle;
+        }
+
+        std::string nodeId(const void *notifier)
+        {
+            std::ostringstream stream;
+            stream << "n" << reinterpret_cast<uintptr_t>(notifier);
+            return stream.str();
+        }
+
+        std::string nodeLabel(const void *notifier, const std::string &debugName)
+        {
+            if (!debugName.empty()) {
+                return debugName;
+            }
+            std::ostringstream stream;
+            stream << notifier;
+            return stream.str();
+        }
+
+        std::string escapeDot(const std::string &text)
+        {
+            std::string result;
+            for (char c : text) {
+                if (c == '"' || c == '\\') {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result;
+        }
+    }
+
+    std::atomic<bool> &BindingInstrumentation::enabled()
+    {
+        static std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    std::atomic<size_t> &BindingInstrumentation::stormThreshold()
+    {
+        static std::atomic<size_t> threshold{100};
+        return threshold;
+    }
+
+    void BindingInstrumentation::setStormHandler(StormHandler handler)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        data().stormHandler = std::move(handler);
+    }
+
+    void BindingInstrumentation::setDebugName(const void *notifier, std::string debugName)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        data().statistics[notifier].debugName = std::move(debugName);
+    }
+
+    std::string BindingInstrumentation::debugName(const void *notifier)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        auto it = data().statistics.find(notifier);
+        return it != data().statistics.end() ? it->second.debugName : std::string();
+    }
+
+    void BindingInstrumentation::addEdge(const void *sourceNotifier, const void *targetNotifier)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        data().edges.emplace(sourceNotifier, targetNotifier);
+        data().statistics[sourceNotifier];
+        data().statistics[targetNotifier];
+    }
+
+    void BindingInstrumentation::removeEdge(const void *sourceNotifier, const void *targetNotifier)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        data().edges.erase(std::make_pair(sourceNotifier, targetNotifier));
+    }
+
+    void BindingInstrumentation::forget(const void *notifier)
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        data().statistics.erase(notifier);
+        auto &edges = data().edges;
+        for (auto it = edges.begin(); it != edges.end();) {
+            if (it->first == notifier || it->second == notifier) {
+                it = edges.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    BindingInstrumentation::StatisticsMap BindingInstrumentation::statistics()
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        return data().statistics;
+    }
+
+    void BindingInstrumentation::reset()
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+        for (auto &entry : data().statistics) {
+            Statistics cleared;
+            cleared.debugName = std::move(entry.second.debugName);
+            entry.second = std::move(cleared);
+        }
+    }
+
+    std::string BindingInstrumentation::toDot()
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+
+        std::ostringstream stream;
+        stream << "digraph bindings {\n";
+        for (const auto &[notifier, stats] : data().statistics) {
+            stream << "    " << nodeId(notifier) << " [label=\"" << escapeDot(nodeLabel(notifier, stats.debugName))
+                   << "\\nnotifications: " << stats.notificationCount << "\\ncallbacks: " << stats.subscriberCallCount
+                   << "\\ntime: " << stats.callbackTime.count() * 1000.0 << "ms\"";
+            if (stats.stormCount > 0) {
+                stream << " color=red";
+            }
+            stream << "];\n";
+        }
+        for (const auto &[source, target] : data().edges) {
+            stream << "    " << nodeId(source) << " -> " << nodeId(target) << ";\n";
+        }
+        stream << "}\n";
+        return stream.str();
+    }
+
+    std::string BindingInstrumentation::toJson()
+    {
+        std::lock_guard<std::mutex> lock(data().mutex);
+
+        json nodes = json::array();
+        for (const auto &[notifier, stats] : data().statistics) {
+            nodes.push_back({{"id", nodeId(notifier)},
+                             {"name", nodeLabel(notifier, stats.debugName)},
+                             {"notifications", stats.notificationCount},
+                             {"subscriberCalls", stats.subscriberCallCount},
+                             {"maximumFanOut", stats.maximumFanOut},
+                             {"storms", stats.stormCount},
+                             {"callbackTimeMs", stats.callbackTime.count() * 1000.0}});
+        }
+
+        json edges = json::array();
+        for (const auto &[source, target] : data().edges) {
+            edges.push_back({{"from", nodeId(source)}, {"to", nodeId(target)}});
+        }
+
+        return json{{"nodes", nodes}, {"edges", edges}}.dump(4);
+    }
+
+    BindingInstrumentation::Dispatch::Dispatch(const void *notifier, size_t subscriberCount) : _notifier(notifier)
+    {
+        auto &cycle = currentCycle();
+        cycle.depth++;
+        size_t cycleCount = ++cycle.notificationCounts[notifier];
+
+        bool storm = cycleCount == stormThreshold() + 1;
+        StormHandler handler;
+        std::string name;
+
+        {
+            std::lock_guard<std::mutex> lock(data().mutex);
+            auto &stats = data().statistics[notifier];
+            stats.notificationCount++;
+            stats.maximumFanOut = std::max(stats.maximumFanOut, subscriberCount);
+            if (storm) {
+                stats.stormCount++;
+                handler = data().stormHandler;
+                name = stats.debugName;
+            }
+        }
+
+        if (storm) {
+            if (handler) {
+                handler(notifier, name, cycleCount);
+            } else {
+                logstream() << "Binding storm: " << nodeLabel(notifier, name) << " notified more than "
+                            << stormThreshold().load() << " times in a single dispatch cycle";
+            }
+        }
+    }
+
+    BindingInstrumentation::Dispatch::~Dispatch()
+    {
+        {
+            std::lock_guard<std::mutex> lock(data().mutex);
+            // The notifier may have been forgotten by one of its own subscribers
+            auto it = data().statistics.find(_notifier);
+            if (it != data().statistics.end()) {
+                it->second.subscriberCallCount += _subscriberCalls;
+                it->second.callbackTime += _callbackTime;
+            }
+        }
+
+        auto &cycle = currentCycle();
+        if (--cycle.depth == 0) {
+            cycle.notificationCounts.clear();
+        }
+    }
+
+    void BindingInstrumentation::Dispatch::subscriberCalled(Duration duration)
+    {
+        _subscriberCalls++;
+        _callbackTime += duration;
+    }
+}
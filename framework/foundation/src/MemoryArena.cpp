@@ -0,0 +1,115 @@
+#include <bdn/MemoryArena.h>
+
+#include <algorithm>
+#include <new>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#if defined(__cpp_lib_memory_resource)
+#define BDN_HAS_MEMORY_RESOURCE 1
+#endif
+#endif
+
+namespace bdn
+{
+    namespace
+    {
+        class StatisticsArena : public MemoryArena
+        {
+          public:
+            using MemoryArena::MemoryArena;
+
+            Statistics statistics() const override { return _statistics; }
+
+          protected:
+            void countAllocation(size_t bytes)
+            {
+                _statistics.allocationCount++;
+                _statistics.bytesAllocated += bytes;
+                _statistics.bytesInUse += bytes;
+                _statistics.peakBytesInUse = std::max(_statistics.peakBytesInUse, _statistics.bytesInUse);
+            }
+
+            void countDeallocation(size_t bytes)
+            {
+                _statistics.deallocationCount++;
+                _statistics.bytesInUse -= bytes;
+            }
+
+          protected:
+            Statistics _statistics;
+        };
+
+#ifdef BDN_HAS_MEMORY_RESOURCE
+        class ResourceArena : public StatisticsArena
+        {
+          public:
+            ResourceArena(Kind kind, size_t initialSize) : StatisticsArena(kind)
+            {
+                if (kind == Kind::Monotonic) {
+                    _resource = std::make_unique<std::pmr::monotonic_buffer_resource>(initialSize);
+                } else {
+                    std::pmr::pool_options options;
+                    options.max_blocks_per_chunk = std::max<size_t>(initialSize / 64, 16);
+                    _resource = std::make_unique<std::pmr::unsynchronized_pool_resource>(options);
+                }
+            }
+
+            void *allocate(size_t bytes, size_t alignment) override
+            {
+                countAllocation(bytes);
+                return _resource->allocate(bytes, alignment);
+            }
+
+            void deallocate(void *pointer, size_t bytes, size_t alignment) override
+            {
+                countDeallocation(bytes);
+                _resource->deallocate(pointer, bytes, alignment);
+            }
+
+          private:
+            std::unique_ptr<std::pmr::memory_resource> _resource;
+        };
+#else
+        // The standard library of this platform has no <memory_resource>. Keep the
+        // statistics but take the memory from the global heap.
+        class ResourceArena : public StatisticsArena
+        {
+          public:
+            ResourceArena(Kind kind, size_t /*initialSize*/) : StatisticsArena(kind) {}
+
+            void *allocate(size_t bytes, size_t alignment) override
+            {
+                countAllocation(bytes);
+                return ::operator new(bytes, std::align_val_t(alignment));
+            }
+
+            void deallocate(void *pointer, size_t bytes, size_t alignment) override
+            {
+                countDeallocation(bytes);
+                ::operator delete(pointer, std::align_val_t(alignment));
+            }
+        };
+#endif
+    }
+
+    std::shared_ptr<MemoryArena> MemoryArena::create(Kind kind, size_t initialSize)
+    {
+        return std::make_shared<ResourceArena>(kind, initialSize);
+    }
+
+    void MemoryArena::retain()
+    {
+        if (_retainCount.fetch_add(1, std::memory_order_relaxed) == 0) {
+            _self = shared_from_this();
+        }
+    }
+
+    void MemoryArena::release() noexcept
+    {
+        if (_retainCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // The arena may be destroyed with the last reference, so _self must not be touched afterwards
+            auto self = std::move(_self);
+        }
+    }
+}
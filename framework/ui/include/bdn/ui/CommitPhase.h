@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace bdn::ui
+{
+    class View;
+
+    /** Coalesces the changes that views make to their cores.
+
+        While enabled, changes of View::geometry, View::visible and the background color from the
+        stylesheet are not forwarded to the core immediately. They are recorded per view and property
+        instead, so that a property that changes several times (for example because layout runs more
+        than once) only reaches the core with its last value. The recorded changes are committed once
+        per iteration of the application's dispatch queue, or when flush() is called. They are
+        committed in tree order: parents before their children and siblings in the order that
+        View::indexOfChildView() reports.
+
+        Changes that originate in a core (for example a window that is resized by the user) still
+        reach the view immediately. The commit phase must only be used from the main thread.*/
+    class CommitPhase
+    {
+      public:
+        enum class Target
+        {
+            geometry,
+            visible,
+            backgroundColor
+        };
+
+        struct Statistics
+        {
+            size_t recordedCount = 0;
+            size_t committedCount = 0;
+            /** Recorded changes that were replaced by a later change before they were committed.*/
+            size_t elidedCount = 0;
+            size_t flushCount = 0;
+        };
+
+      public:
+        /** Disabled by default, in which case changes are applied to the core immediately.*/
+        static bool &enabled();
+
+        /** Records apply as the pending change of target on view, replacing a pending change of the
+            same target. If the commit phase is disabled apply is called immediately.*/
+        static void record(const View *view, Target target, std::function<void()> apply);
+
+        /** Commits all pending changes now, including the ones recorded while doing so.*/
+        static void flush();
+
+        static bool hasPendingChanges();
+
+        static Statistics statistics();
+        static void resetStatistics();
+    };
+}
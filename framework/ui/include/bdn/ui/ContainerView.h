@@ -3,7 +3,11 @@
 #include <bdn/ui/View.h>
 #include <bdn/ui/ViewUtilities.h>
 
+#include <functional>
 #include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace bdn::ui
 {
@@ -14,6 +18,9 @@ namespace bdn::ui
 
     class ContainerView : public View
     {
+      public:
+        using ChildrenChangedFunction = std::function<void(size_t index, size_t count, bool inserted)>;
+
       public:
         ContainerView(std::shared_ptr<ViewCoreFactory> viewCoreFactory = nullptr);
 
@@ -22,19 +29,91 @@ namespace bdn::ui
         void removeChildView(const std::shared_ptr<View> &childView);
         void removeAllChildViews();
 
+        /** Adds all views of the range as children. Their parent, layout and core are set up in a
+            single pass, see beginUpdates().*/
+        template <class Iterator> void addChildViews(Iterator first, Iterator last)
+        {
+            beginUpdates();
+            for (auto it = first; it != last; ++it) {
+                addChildView(*it);
+            }
+            endUpdates();
+        }
+        void addChildViews(const std::vector<std::shared_ptr<View>> &childViews)
+        {
+            addChildViews(childViews.begin(), childViews.end());
+        }
+
+        /** Replaces all children with the given views in a single update.*/
+        void replaceChildViews(const std::vector<std::shared_ptr<View>> &childViews);
+
+        /** Starts a transaction. Children added until the matching endUpdates() call are collected
+            and only attached when the outermost transaction ends: their parent is set and they are
+            added to the core. The layout registers them all at once when the container is laid out
+            next. Until then they are not returned by childViews(). Transactions can be nested.*/
+        void beginUpdates();
+        void endUpdates();
+
         std::vector<std::shared_ptr<View>> childViews() const override;
+        void visitChildViews(const std::function<void(View &)> &visitor) const override;
+        std::optional<size_t> indexOfChildView(const View &child) const override;
 
-        std::optional<std::vector<std::shared_ptr<View>>::size_type> childIndex(const std::shared_ptr<View> &child)
-        {
-            const auto children = childViews();
+        size_t childViewCount() const { return _children.size(); }
+        const std::shared_ptr<View> &childViewAt(size_t index) const { return _children.at(index); }
 
-            const auto it = std::find(children.begin(), children.end(), child);
-            if (it == children.end()) {
-                return std::nullopt;
-            }
+        /** Returns the index of child in constant time.*/
+        std::optional<std::vector<std::shared_ptr<View>>::size_type>
+        childIndex(const std::shared_ptr<View> &child) const;
 
-            return std::distance(children.begin(), it);
-        }
+        /** Makes the container virtualized: only the children in the materialized range are visited
+            by visitChildViews(), registered with the layout and given cores. The placeholders are
+            visited before and after them and stand in for the other children, which stay in the
+            container (see childViews()). childrenChanged is called with the index and count of
+            children that were inserted or removed. Initially all children are materialized. Used by
+            ScrollView::virtualizeContent.*/
+        void setVirtualization(std::shared_ptr<View> leadingPlaceholder, std::shared_ptr<View> trailingPlaceholder,
+                               ChildrenChangedFunction childrenChanged);
+
+        /** Materializes all children again and removes the placeholders. The children that were not
+            materialized are attached to the core with the next iteration of the dispatch queue, and
+            not at all if the container is destroyed or loses its core until then.*/
+        void clearVirtualization();
+
+        bool isVirtualized() const { return _virtualization != nullptr; }
+
+        /** Materializes the children in [first, last). Children that leave the range are
+            unregistered from the layout together with their descendants and release their cores.
+            Children that enter it are inserted into the core at their position.*/
+        void setMaterializedRange(size_t first, size_t last);
+
+        /** The range of materialized children, all children if the container is not virtualized.*/
+        std::pair<size_t, size_t> materializedRange() const;
+
+      protected:
+        void bindViewCore() override;
+
+      private:
+        void attachPendingChildViews();
+        void attachMissingChildViewsToCore();
+        void appendChildView(const std::shared_ptr<View> &childView);
+        bool isMaterialized(size_t index) const;
+
+      private:
+        struct Virtualization
+        {
+            std::shared_ptr<View> leadingPlaceholder;
+            std::shared_ptr<View> trailingPlaceholder;
+            ChildrenChangedFunction childrenChanged;
+            size_t first = 0;
+            size_t last = 0;
+        };
+
+      private:
+        std::vector<std::shared_ptr<View>> _children;
+        std::unordered_map<const View *, size_t> _childIndices;
+        std::vector<std::shared_ptr<View>> _pendingChildren;
+        int _updateDepth = 0;
+        std::unique_ptr<Virtualization> _virtualization;
 
       public:
         class Core
@@ -46,6 +125,10 @@ namespace bdn::ui
             virtual void addChildView(std::shared_ptr<View> child) = 0;
             virtual void removeChildView(std::shared_ptr<View> child) = 0;
 
+            /** Inserts child before the child at index of childViews(). The default implementation
+                removes the children from index on and adds them again after child.*/
+            virtual void insertChildView(std::shared_ptr<View> child, size_t index);
+
             virtual std::vector<std::shared_ptr<View>> childViews() const = 0;
         };
     };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <bdn/Rect.h>
+#include <bdn/ui/ContainerView.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace bdn::ui
+{
+    /** Materializes only those children of a ContainerView that intersect a visible rect extended by
+        an overscan, see ScrollView::virtualizeContent.
+
+        The children are assumed to be stacked along the scrolling axis, like the rows of a list. A
+        child's extent is taken from its geometry once it has been laid out, children that were never
+        materialized use the estimated extent. Two placeholder views stand in for the children before
+        and after the materialized range, so the content's layout gives the content its estimated
+        total size. The extents are kept in a Fenwick tree, so finding the children at an offset and
+        updating an extent take logarithmic time.*/
+    class ContentVirtualizer
+    {
+      public:
+        struct Statistics
+        {
+            size_t updateCount = 0;
+            size_t materializedCount = 0;
+            size_t releasedCount = 0;
+        };
+
+      public:
+        explicit ContentVirtualizer(std::shared_ptr<ContainerView> content);
+        ~ContentVirtualizer();
+
+        ContentVirtualizer(const ContentVirtualizer &) = delete;
+        ContentVirtualizer &operator=(const ContentVirtualizer &) = delete;
+
+        const std::shared_ptr<ContainerView> &content() const { return _content; }
+
+        /** Materializes the children that intersect visibleRect, extended by overscan at both ends
+            of the scrolling axis.*/
+        void update(const Rect &visibleRect, double overscan, double estimatedExtent, bool vertical);
+
+        std::pair<size_t, size_t> materializedRange() const { return _content->materializedRange(); }
+
+        /** The offset of the child at index along the scrolling axis, based on the extents known so
+            far.*/
+        double offsetOfChild(size_t index) const { return prefix(index); }
+        double totalExtent() const { return prefix(_extents.size()); }
+
+        /** How often update() ran, and how many children were materialized and released in total.*/
+        Statistics statistics() const { return _statistics; }
+
+      private:
+        class Placeholder;
+
+      private:
+        void childrenChanged(size_t index, size_t count, bool inserted);
+        void collectExtents();
+        void materialize();
+
+        void setExtent(size_t index, double extent);
+        void appendExtent(double extent);
+        void rebuildTree();
+        double prefix(size_t count) const;
+        size_t countBefore(double offset) const;
+
+      private:
+        std::shared_ptr<ContainerView> _content;
+        std::shared_ptr<Placeholder> _leadingPlaceholder;
+        std::shared_ptr<Placeholder> _trailingPlaceholder;
+
+        std::vector<double> _extents;
+        std::vector<bool> _measured;
+        // One based Fenwick tree over _extents
+        std::vector<double> _tree;
+
+        Rect _visibleRect;
+        double _overscan = 0;
+        double _estimatedExtent = 0;
+        bool _vertical = true;
+
+        Statistics _statistics;
+    };
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <bdn/Size.h>
+
+#include <optional>
 #include <string>
 
 namespace bdn::ui
@@ -18,6 +21,24 @@ namespace bdn::ui
         virtual void markDirty(View *view) = 0;
         virtual void updateStylesheet(View *view) = 0;
 
+        /** Called when the view was shown or hidden. Layouts that do not distinguish the two cases
+            treat it like a stylesheet change.*/
+        virtual void updateVisibility(View *view) { updateStylesheet(view); }
+
         virtual void layout(View *view) = 0;
+
+        /** Called before several children are registered with parent at once. Layouts can defer
+            rebuilding the parent's child list until endUpdates() is called.*/
+        virtual void beginUpdates(View * /*parent*/) {}
+        virtual void endUpdates(View * /*parent*/) {}
+
+        /** Returns the size view would like to have in availableSpace, if this layout determines it.
+            Used for views whose parent uses a different layout: the parent's layout treats the view
+            like a leaf and measures it through View::sizeForSpace(), which asks the view's own layout
+            first.*/
+        virtual std::optional<Size> sizeForSpace(const View & /*view*/, Size /*availableSpace*/)
+        {
+            return std::nullopt;
+        }
     };
 }
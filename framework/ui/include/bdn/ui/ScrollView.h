@@ -1,8 +1,11 @@
 #pragma once
 
+#include <bdn/ui/ContentVirtualizer.h>
 #include <bdn/ui/View.h>
 #include <bdn/ui/ViewUtilities.h>
 
+#include <memory>
+
 namespace bdn::ui
 {
     namespace detail
@@ -18,20 +21,36 @@ namespace bdn::ui
         Property<bool> horizontalScrollingEnabled;
         Property<Rect> visibleClientRect;
 
+        /** Only keeps the children of a ContainerView content that are near the visible client rect
+            materialized, see ContentVirtualizer.*/
+        Property<bool> virtualizeContent = false;
+        Property<double> virtualizationOverscan = 250.;
+        Property<double> estimatedChildExtent = 44.;
+
       public:
         void scrollClientRectToVisible(const Rect &area);
 
+        /** The virtualizer of the content, nullptr if the content is not virtualized.*/
+        const ContentVirtualizer *contentVirtualizer() const { return _contentVirtualizer.get(); }
+
       public:
         ScrollView(std::shared_ptr<ViewCoreFactory> viewCoreFactory = nullptr);
+        ~ScrollView() override;
 
       public:
         std::vector<std::shared_ptr<View>> childViews() const override;
+        void visitChildViews(const std::function<void(View &)> &visitor) const override;
 
       protected:
         void bindViewCore() override;
 
+      private:
+        void updateContentVirtualization();
+        void updateVirtualizedContent();
+
       private:
         SingleChildHelper _contentView;
+        std::unique_ptr<ContentVirtualizer> _contentVirtualizer;
 
       public:
         class Core
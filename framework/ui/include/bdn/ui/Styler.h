@@ -2,18 +2,35 @@
 
 #include <bdn/Json.h>
 #include <bdn/ui/View.h>
+#include <cstdint>
 #include <map>
 #include <memory>
-#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace bdn::ui
 {
     class Styler
     {
-        struct Data // TODO: Find better name
+      public:
+        struct Statistics
         {
-            json json;
-            std::set<std::string> usedMatchers;
+            /** Views whose matching options changed, so that their stylesheet was merged again.*/
+            size_t rematchedViewCount = 0;
+            /** Distinct stylesheets that were compiled.*/
+            size_t compiledProgramCount = 0;
+            /** Stylesheets that were set and shared the program of an equal one.*/
+            size_t sharedProgramCount = 0;
+            /** Results that were merged because no cached result existed for the matching options.*/
+            size_t mergedResultCount = 0;
+            /** Calls of a condition's operator().*/
+            size_t evaluatedConditionCount = 0;
+            size_t assignedStylesheetCount = 0;
+            /** Merged stylesheets that were not assigned because they equal the view's current one.*/
+            size_t unchangedStylesheetCount = 0;
         };
 
       public:
@@ -50,12 +67,89 @@ namespace bdn::ui
         void setStyleSheet(std::shared_ptr<View> view, json stylesheet);
         void setCondition(std::string name, std::shared_ptr<condition> condition);
 
+        /** Calls function in an update, see beginUpdates().*/
+        template <class Function> void update(Function &&function)
+        {
+            beginUpdates();
+            try {
+                function();
+            } catch (...) {
+                endUpdates();
+                throw;
+            }
+            endUpdates();
+        }
+
+        /** Starts an update. Conditions and stylesheets set until the matching endUpdates() call take
+            effect when the outermost update ends: each affected view is matched once and gets at most
+            one new stylesheet, no matter how many of its conditions changed. Updates can be nested.*/
+        void beginUpdates();
+        void endUpdates();
+
+        Statistics statistics() const { return _statistics; }
+        void resetStatistics() { _statistics = Statistics{}; }
+
       private:
-        void rematchView(const std::shared_ptr<View> &view);
-        void rematchAllViews(const std::string &matcherName);
+        // One bit per test or patch of a program
+        using Mask = std::vector<uint64_t>;
+
+        /** A conditional option of a stylesheet, without its "if" object.*/
+        struct Patch
+        {
+            /** The tests of the program that must all pass for the patch to apply.*/
+            Mask required;
+            json values;
+        };
+
+        /** A stylesheet compiled once and shared by all views that use an equal stylesheet.
+
+            The leading unconditional options are merged into base. Each following option becomes a
+            patch, applied in order when all of its tests pass. Equal tests of different options are
+            evaluated once. Merged results are cached per set of matching patches.*/
+        struct Program
+        {
+            std::vector<std::pair<std::string, json>> tests;
+            std::unordered_map<std::string, std::vector<size_t>> testsByCondition;
+            json base;
+            std::vector<Patch> patches;
+
+            // The state for the current conditions of the styler
+            Mask testResults;
+            Mask matchingPatches;
+            std::map<Mask, json> results;
+            const json *result = nullptr;
+
+            std::unordered_map<const View *, std::weak_ptr<View>> views;
+        };
+
+        using Programs = std::map<json, Program>;
+
+      private:
+        Program compile(const json &stylesheet);
+        void index(Program &program);
+        void unindex(Program &program);
+        void detach(const View *view, Programs::iterator programIt);
+
+        /** Matches the programs whose conditions changed and assigns the stylesheets of their views
+            and of the views whose stylesheet was set during an update.*/
+        void applyPendingChanges();
+
+        /** Determines the matching patches and the merged result. Returns true if they changed.*/
+        bool updateResult(Program &program);
+
+        /** Assigns the program's result to the view if it differs from the view's stylesheet.*/
+        void applyResult(const std::shared_ptr<View> &view, const Program &program);
 
       private:
-        std::map<std::weak_ptr<View>, Data, std::owner_less<std::weak_ptr<View>>> _data;
+        Programs _programs;
+        std::unordered_map<const View *, Programs::iterator> _entries;
+        // Condition name to the programs that test it
+        std::unordered_map<std::string, std::unordered_set<Program *>> _conditionUsers;
         std::map<std::string, std::shared_ptr<condition>> _conditions;
+        Statistics _statistics;
+
+        size_t _updateDepth = 0;
+        std::unordered_set<Program *> _pendingPrograms;
+        std::unordered_map<const View *, std::weak_ptr<View>> _pendingViews;
     };
 }
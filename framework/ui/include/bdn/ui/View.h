@@ -4,13 +4,15 @@
 
 #include <bdn/Color.h>
 #include <bdn/Json.h>
+#include <bdn/MemoryArena.h>
 #include <bdn/Rect.h>
-#include <bdn/ValueWithFallback.h>
 #include <bdn/WeakCallback.h>
 #include <bdn/property/Property.h>
 #include <bdn/ui/Layout.h>
 
 #include <list>
+#include <optional>
+#include <vector>
 
 namespace bdn::ui
 {
@@ -37,6 +39,11 @@ namespace bdn::ui
         static bool &debugViewEnabled();
         static bool &debugViewBaselineEnabled();
 
+        /** If enabled, a view releases its core (and those of its children) when it is removed from
+            its parent. The parent removes the view from its own core first, so the core is released
+            unconditionally. A new core is created when the view is attached again.*/
+        static bool &releaseCoresOnDetach();
+
       public:
         View() = delete;
         View(std::shared_ptr<ViewCoreFactory> viewCoreFactory = nullptr);
@@ -49,22 +56,61 @@ namespace bdn::ui
         virtual float baseline(Size forSize) const;
         virtual float pointScaleFactor() const;
 
+        /** Returns the view's own layout, or the one it inherits from its parent (or its fallback
+            layout if it has no parent). Inherited layouts are looked up lazily and cached until the
+            layout of any view or the hierarchy changes.*/
         std::shared_ptr<Layout> getLayout();
         void setLayout(std::shared_ptr<Layout> layout);
         void setFallbackLayout(std::shared_ptr<Layout> layout);
 
+        /** Registers the view, and those of its descendants that were added or moved since, with
+            the layout they use and unregisters them from the one they used before. Called before the
+            view is laid out, so views are only registered with a layout once they need to be.*/
+        void ensureLayoutRegistration();
+
         std::shared_ptr<ViewCoreFactory> viewCoreFactory() { return _viewCoreFactory; }
 
+        /** The MemoryArena that was active when the view was constructed. The view core is
+            allocated from it as well, even if it is created later.*/
+        const std::shared_ptr<MemoryArena> &memoryArena() const { return _memoryArena; }
+
         virtual std::vector<std::shared_ptr<View>> childViews() const { return {}; }
 
+        /** Calls visitor for every child view. Unlike childViews() this does not copy the list of
+            children, so prefer it for traversals.*/
+        virtual void visitChildViews(const std::function<void(View &)> &visitor) const;
+
+        /** Returns the position of child in the order visitChildViews() visits the children, or
+            std::nullopt if it is not a child of this view.*/
+        virtual std::optional<size_t> indexOfChildView(const View &child) const;
+
         void scheduleLayout();
 
+        /** Tells the layout of the parent that the preferred size of this view may have changed. Only
+            has an effect if the parent uses a different layout than the view, see
+            Layout::sizeForSpace().*/
+        void invalidateSizeInParentLayout();
+
         template <class T> auto core() { return std::dynamic_pointer_cast<T>(viewCore()); }
         template <class T> auto core() const { return std::dynamic_pointer_cast<T>(viewCore()); }
 
+        /** Like core(), but returns nullptr instead of creating the core if it does not exist yet.*/
+        template <class T> auto existingCore() const { return std::dynamic_pointer_cast<T>(_core); }
+
         std::shared_ptr<View::Core> viewCore();
         std::shared_ptr<View::Core> viewCore() const;
 
+        /** Returns true if the core has been created. Cores are created on demand, typically when the
+            view becomes part of a window; until then the view only keeps its state.*/
+        bool hasViewCore() const { return _core != nullptr; }
+
+        /** Destroys the core of this view and its children. Property values stay with the view and
+            are applied again when a new core is created.
+
+            The core of the parent would keep the released core as its child, so the view must be
+            removed from its parent first, or the parent must not have a core.*/
+        void releaseViewCore();
+
         virtual const std::type_info &typeInfoForCoreCreation() const;
 
         virtual void updateFromStylesheet();
@@ -73,25 +119,62 @@ namespace bdn::ui
         virtual void bindViewCore();
         static void setParentViewOfView(const std::shared_ptr<View> &view, const std::shared_ptr<View> &parentView);
 
+        /** Unregisters view from its layouts while it stays a child of its parent, for children that
+            are temporarily not visited by visitChildViews(). Its descendants stay registered.*/
+        static void unregisterFromLayouts(View &view);
+
+        /** Unregisters view and all of its descendants from their layouts, for children whose layout
+            data should be released. They are registered again when the parent is laid out after
+            childLayoutRegistrationChanged().*/
+        static void unregisterSubtreeFromLayouts(View &view);
+
+        /** Like releaseViewCore(), for a child that its parent already removed from the parent's core.*/
+        static void releaseDetachedViewCore(View &view);
+
+        /** Makes the next layout pass register all children that visitChildViews() returns.*/
+        void childLayoutRegistrationChanged();
+
       protected:
         void onCoreLayout();
         void onCoreDirty();
 
       private:
-        void updateLayout(const std::shared_ptr<Layout> &oldLayout, const std::shared_ptr<Layout> &newLayout);
+        void layoutChanged();
+        void markLayoutSyncPending();
+        void markChildLayoutSyncPending(const std::shared_ptr<View> &child);
 
       private:
         void lazyInitCore() const;
-
-      protected:
-        ValueWithFallback<std::shared_ptr<Layout>> _layout;
+        void unsubscribeFromCore();
 
       private:
+        std::shared_ptr<Layout> _ownLayout;
+        std::shared_ptr<Layout> _fallbackLayout;
+        std::shared_ptr<Layout> _inheritedLayout;
+        uint64_t _inheritedLayoutGeneration = 0;
+
+        std::shared_ptr<Layout> _registeredLayout;
+        // The parent's layout if it differs from the view's own. The view is registered with it as
+        // well, so that the parent's layout can size it like a leaf.
+        std::shared_ptr<Layout> _parentLayout;
+        // The layout generation for which _parentLayout was determined
+        uint64_t _parentLayoutGeneration = 0;
+        // The next layout pass visits the children in _pendingLayoutChildren, or all of them if
+        // _layoutSyncAllChildren is set
+        bool _layoutSyncPending = false;
+        bool _layoutSyncAllChildren = false;
+        std::vector<std::weak_ptr<View>> _pendingLayoutChildren;
+
         mutable std::shared_ptr<View::Core> _core;
         WeakCallback<void()>::Receiver _layoutCallbackReceiver;
         WeakCallback<void()>::Receiver _dirtyCallbackReceiver;
+        Notifier<>::Subscription _visibleSubscription;
+        Notifier<>::Subscription _geometrySubscription;
+        Notifier<>::Subscription _coreVisibleSubscription;
+        Notifier<>::Subscription _coreGeometrySubscription;
 
         std::shared_ptr<ViewCoreFactory> _viewCoreFactory;
+        std::shared_ptr<MemoryArena> _memoryArena = MemoryArena::current();
         bool _hasLayoutSchedulePending{false};
 
       public:
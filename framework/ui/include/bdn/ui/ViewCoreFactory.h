@@ -6,25 +6,57 @@ namespace bdn::ui
 }
 
 #include <bdn/Context.h>
-#include <bdn/Factory.h>
+#include <bdn/MemoryArena.h>
 #include <bdn/ui/View.h>
 #include <bdn/ui/ViewCoreTypeNotSupportedError.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
 namespace bdn::ui
 {
-    class ViewCoreFactory : public bdn::Factory<std::shared_ptr<View::Core>, std::shared_ptr<ViewCoreFactory>>,
-                            public std::enable_shared_from_this<ViewCoreFactory>
+    class ViewCoreFactory : public std::enable_shared_from_this<ViewCoreFactory>
     {
       public:
         using ContextStack = std::vector<std::shared_ptr<Context>>;
+        using CoreConstructor = std::shared_ptr<View::Core> (*)(const std::shared_ptr<ViewCoreFactory> &);
+        using RegisterFunction = void (*)(const std::shared_ptr<ViewCoreFactory> &);
+
+      public:
+        ViewCoreFactory();
+        virtual ~ViewCoreFactory() = default;
 
       public:
         std::shared_ptr<View::Core> createViewCore(const std::type_info &viewType);
 
       public:
-        template <class CoreType, class ViewType> void registerCoreType()
+        template <class CoreType, class ViewType> bool registerCoreType()
         {
-            registerConstruction(typeid(ViewType).name(), &makeCore<CoreType>);
+            return registerCoreConstructor(typeid(ViewType), &makeCore<CoreType>);
+        }
+
+        /** Associates constructor with the given view type. The first registration for a view type
+            wins, later ones are ignored and false is returned.*/
+        bool registerCoreConstructor(const std::type_info &viewType, CoreConstructor constructor);
+
+        /** Calls registerFunction the first time it is passed to this factory with the given key.
+            Used by VIEW_CORE_REGISTER so that views only register their core types once per factory
+            instead of once per view instance.
+
+            Lookups read an immutable, sorted registry without locking, so constructing views and
+            creating cores on worker threads (see buildViewTreeAsync()) does not contend. Registrations
+            are serialized and publish a new registry.*/
+        void registerOnce(const void *key, RegisterFunction registerFunction)
+        {
+            const auto &keys = _registry.load(std::memory_order_acquire)->keys;
+            if (!std::binary_search(keys.begin(), keys.end(), key)) {
+                registerOnceLocked(key, registerFunction);
+            }
         }
 
       public:
@@ -48,12 +80,30 @@ namespace bdn::ui
         template <class CoreType>
         static std::shared_ptr<View::Core> makeCore(const std::shared_ptr<ViewCoreFactory> &ViewCoreFactory)
         {
-            auto viewCore = std::make_shared<CoreType>(ViewCoreFactory);
+            auto viewCore = allocateShared<CoreType>(ViewCoreFactory);
             viewCore->init();
             return viewCore;
         }
 
       private:
         static ContextStack *contextStack();
+
+      private:
+        struct Registry
+        {
+            // Sorted by view type and by key, registries only grow
+            std::vector<std::pair<std::type_index, CoreConstructor>> coreConstructors;
+            std::vector<const void *> keys;
+        };
+
+        void registerOnceLocked(const void *key, RegisterFunction registerFunction);
+        void publish(std::unique_ptr<Registry> registry);
+
+      private:
+        std::atomic<const Registry *> _registry;
+        // Every published registry, as readers may still use an older one. There is one per
+        // registration and registrations only happen once per view type.
+        std::vector<std::unique_ptr<const Registry>> _registries;
+        std::recursive_mutex _mutex;
     };
 }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <bdn/DispatchQueue.h>
+#include <bdn/ui/View.h>
+
+#include <functional>
+#include <memory>
+
+namespace bdn::ui
+{
+    using ViewTreeBuildFunction = std::function<std::shared_ptr<View>()>;
+    using ViewTreeAttachFunction = std::function<void(std::shared_ptr<View>)>;
+
+    /** Builds a detached view tree on workerQueue and hands it to the main thread.
+
+        build is called on workerQueue with viewCoreFactory (or, if it is null, the factory that is
+        current on the calling thread). If a MemoryArena is active on the calling thread, a new arena
+        of the same kind is active during build, as arenas must not be shared between threads. build
+        may construct views, set their properties and stylesheets and add children, but must not touch
+        views that are already part of a window. Layouts are inherited when the returned root is attached.
+
+        Afterwards the cores of the whole tree are created on the main dispatch queue and attach is
+        called there with the root. If build throws, the exception is rethrown on the main queue.*/
+    void buildViewTreeAsync(const std::shared_ptr<DispatchQueue> &workerQueue, ViewTreeBuildFunction build,
+                            ViewTreeAttachFunction attach, std::shared_ptr<ViewCoreFactory> viewCoreFactory = nullptr);
+}
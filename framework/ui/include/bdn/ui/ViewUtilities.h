@@ -3,7 +3,12 @@
 #include <bdn/ui/ViewCoreFactory.h>
 
 #define VIEW_CORE_REGISTRY_DECLARATION_STATIC(NAME)                                                                    \
-    void NAME##_registerViewCore(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory);
+    void NAME##_registerViewCore(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory);                    \
+    inline void NAME##_registerViewCoreOnce(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory)          \
+    {                                                                                                                  \
+        static const char s_registrationKey = 0;                                                                       \
+        viewCoreFactory->registerOnce(&s_registrationKey, &NAME##_registerViewCore);                                   \
+    }
 
 #define VIEW_CORE_REGISTRY_DECLARATION_SHARED(NAME)                                                                    \
     class NAME##_RegisterMe                                                                                            \
@@ -24,7 +29,15 @@
                                                                                                                        \
       private:                                                                                                         \
         std::function<void(std::shared_ptr<bdn::ui::ViewCoreFactory>)> _registerFunction;                              \
-    };
+    };                                                                                                                 \
+    inline void NAME##_registerViewCoreOnce(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory)          \
+    {                                                                                                                  \
+        static const char s_registrationKey = 0;                                                                       \
+        viewCoreFactory->registerOnce(&s_registrationKey,                                                              \
+                                      [](const std::shared_ptr<bdn::ui::ViewCoreFactory> &factory) {                   \
+                                          NAME##_Registrar::get().call(factory);                                       \
+                                      });                                                                              \
+    }
 
 #define VIEW_CORE_REGISTRY_IMPLEMENTATION_SHARED(NAME)                                                                 \
     NAME##_RegisterMe::NAME##_RegisterMe(std::function<void(std::shared_ptr<bdn::ui::ViewCoreFactory>)> callMe)        \
@@ -49,8 +62,8 @@
         _registerFunction = std::move(function);                                                                       \
     }
 
-#define VIEW_CORE_REGISTER_STATIC(NAME, VIEWCORE_FACTORY) NAME##_registerViewCore(VIEWCORE_FACTORY);
-#define VIEW_CORE_REGISTER_SHARED(NAME, VIEWCORE_FACTORY) NAME##_Registrar::get().call(VIEWCORE_FACTORY);
+#define VIEW_CORE_REGISTER_STATIC(NAME, VIEWCORE_FACTORY) NAME##_registerViewCoreOnce(VIEWCORE_FACTORY);
+#define VIEW_CORE_REGISTER_SHARED(NAME, VIEWCORE_FACTORY) NAME##_registerViewCoreOnce(VIEWCORE_FACTORY);
 
 #define CORE_REGISTER_STATIC(NAME, CORETYPE, VIEWTYPE)                                                                 \
     void NAME##_registerViewCore(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory)                     \
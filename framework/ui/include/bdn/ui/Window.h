@@ -44,6 +44,7 @@ namespace bdn::ui
 
       public:
         std::vector<std::shared_ptr<View>> childViews() const override;
+        void visitChildViews(const std::function<void(View &)> &visitor) const override;
 
       protected:
         void bindViewCore() override;
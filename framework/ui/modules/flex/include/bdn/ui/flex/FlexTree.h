@@ -0,0 +1,201 @@
+#pragma once
+
+#include <bdn/ui/View.h>
+#include <bdn/ui/yoga/FlexStylesheet.h>
+#include <bdn/ui/yoga/MeasureCache.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bdn::ui::flex
+{
+    using yoga::FlexStylesheet;
+
+    /** The flex tree of one layout root, stored as a structure of arrays.
+
+        Nodes are numbered in breadth first order, so the children of a node are a contiguous range
+        of indices, and the style, child range, computed frame and cached results of a node are kept
+        in separate arrays instead of one heap object per node. Frames are relative to the parent,
+        like View::geometry.
+
+        The results of a node are cached until the node or one of its descendants is marked dirty, so
+        laying out a tree in which a single view changed only recalculates the path to it.*/
+    class FlexTree
+    {
+      public:
+        enum class MeasureMode : uint8_t
+        {
+            Undefined,
+            Exactly,
+            AtMost
+        };
+
+        struct Frame
+        {
+            float x = 0;
+            float y = 0;
+            float width = 0;
+            float height = 0;
+        };
+
+        struct Range
+        {
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        struct ApplyStatistics
+        {
+            /** Nodes whose frame was compared with their view's geometry.*/
+            size_t visitedCount = 0;
+            /** Views whose geometry actually changed.*/
+            size_t changedCount = 0;
+        };
+
+        /** Returns the style and measure cache of a registered view, or false if the view (and with it
+            its subtree) is not part of the tree.*/
+        using DescribeFunction =
+            std::function<bool(View *view, const FlexStylesheet *&style, yoga::MeasureCache *&measureCache)>;
+
+      public:
+        /** Rebuilds the tree from root and its visible descendants.*/
+        void build(View *root, const DescribeFunction &describe);
+
+        bool contains(const View *view) const { return _indices.count(view) != 0; }
+        size_t size() const { return _views.size(); }
+        /** The views of the tree in breadth first order, the root first.*/
+        const std::vector<View *> &views() const { return _views; }
+
+        /** Drops the cached results of view and its ancestors.*/
+        void markDirty(const View *view);
+
+        /** Replaces the style of view, which marks it dirty.*/
+        void updateStyle(const View *view, const FlexStylesheet *style);
+
+        /** Lays out the tree in a root of the given size. Positions are rounded to pointScaleFactor
+            when they are applied.
+
+            Like yoga, the calculation recurses once per nesting level of the tree, so its depth is
+            bounded by the stack of the calling thread. Building and applying the tree are iterative.*/
+        void calculate(float width, float height, float pointScaleFactor);
+
+        /** Sets the geometry of the views whose frame changed since the last call. Subtrees that were
+            not laid out again are skipped, and so are nested layout roots.*/
+        ApplyStatistics apply();
+
+        const Frame &frameOf(uint32_t index) const { return _frames[index]; }
+
+      private:
+        struct Constraint
+        {
+            float width;
+            MeasureMode widthMode;
+            float height;
+            MeasureMode heightMode;
+            float ownerWidth;
+            float ownerHeight;
+            bool rtl;
+
+            bool operator==(const Constraint &other) const;
+        };
+
+        struct Result
+        {
+            Constraint constraint;
+            float width;
+            float height;
+        };
+
+        // Measured sizes are kept for a few constraints, as a node is usually measured for its flex
+        // basis and for its cross size before it is laid out
+        static constexpr size_t measuredResultCount = 4;
+
+        struct Results
+        {
+            Result measured[measuredResultCount];
+            uint8_t measuredCount = 0;
+            uint8_t nextMeasured = 0;
+            bool hasLaidOut = false;
+            Result laidOut;
+        };
+
+        // Per child scratch data of one flex pass
+        struct Item
+        {
+            uint32_t index;
+            const FlexStylesheet *style;
+            float marginMainStart;
+            float marginMainEnd;
+            float marginCrossStart;
+            float marginCrossEnd;
+            float basis;
+            float hypotheticalMain;
+            float minMain;
+            float maxMain;
+            float minCross;
+            float maxCross;
+            float main;
+            float cross;
+            float ascent;
+            float violation;
+            bool frozen;
+            bool stretch;
+            FlexStylesheet::Align align;
+        };
+
+        struct Line
+        {
+            size_t first;
+            size_t end;
+            float cross;
+            float maxAscent;
+        };
+
+        enum Flags : uint8_t
+        {
+            hasNewLayout = 1u << 0u,
+            isNestedRoot = 1u << 1u,
+            isLeaf = 1u << 2u
+        };
+
+      private:
+        /** Returns the size of node index for constraint. If performLayout is true the frames of its
+            children are calculated as well.*/
+        std::pair<float, float> layoutNode(uint32_t index, const Constraint &constraint, bool performLayout,
+                                           size_t depth);
+
+        std::pair<float, float> measureLeaf(uint32_t index, const Constraint &constraint);
+        std::pair<float, float> layoutChildren(uint32_t index, const Constraint &constraint, bool performLayout,
+                                               size_t depth);
+
+        float baselineOf(uint32_t index);
+
+        const Result *findResult(uint32_t index, const Constraint &constraint, bool performLayout) const;
+        void storeResult(uint32_t index, const Constraint &constraint, bool performLayout, float width, float height);
+
+      private:
+        std::vector<View *> _views;
+        std::vector<const FlexStylesheet *> _styles;
+        std::vector<yoga::MeasureCache *> _measureCaches;
+        std::vector<uint32_t> _parents;
+        std::vector<Range> _children;
+        std::vector<Frame> _frames;
+        std::vector<Results> _results;
+        std::vector<uint8_t> _flags;
+
+        // Unrounded absolute positions of the last apply(), to tell whether a subtree moved
+        std::vector<std::pair<float, float>> _absolutePositions;
+
+        std::unordered_map<const View *, uint32_t> _indices;
+
+        float _pointScaleFactor = 1.0f;
+
+        // One scratch buffer per nesting depth, so that passes do not allocate
+        std::deque<std::vector<Item>> _items;
+        std::deque<std::vector<Line>> _lines;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <bdn/Rect.h>
+#include <bdn/property/Property.h>
+#include <bdn/ui/Layout.h>
+#include <bdn/ui/flex/FlexTree.h>
+#include <bdn/ui/yoga/MeasureCache.h>
+#include <bdn/ui/yoga/StylesheetCache.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace bdn::ui::flex
+{
+    /** A flexbox layout that keeps the tree of each layout root in contiguous arrays (see FlexTree)
+        instead of one yoga node per view.
+
+        It reads the same "flex" stylesheets as yoga::Layout, so a window can switch between the two
+        with setLayout(). The tree of a root is rebuilt lazily when views are added, removed, shown or
+        hidden; style and content changes only invalidate the cached results of the affected path.*/
+    class Layout : public ui::Layout
+    {
+      public:
+        void registerView(View *view) override;
+        void unregisterView(View *view) override;
+
+        void markDirty(View *view) override;
+        void updateStylesheet(View *view) override;
+        void updateVisibility(View *view) override;
+
+        void layout(View *view) override;
+
+        const yoga::StylesheetCache &stylesheetCache() const { return _stylesheetCache; }
+
+        /** How many nodes the last layout pass visited and how many geometries it changed.*/
+        FlexTree::ApplyStatistics lastApplyStatistics() const { return _lastApplyStatistics; }
+
+        /** How often the tree of a root was rebuilt because its views changed.*/
+        size_t rebuildCount() const { return _rebuildCount; }
+
+      private:
+        struct ViewEntry
+        {
+            std::shared_ptr<const FlexStylesheet> style;
+            yoga::MeasureCache measureCache;
+            bool visible = false;
+        };
+
+        struct Root
+        {
+            FlexTree tree;
+            bool needsRebuild = true;
+            Property<Rect> geometry;
+        };
+
+      private:
+        /** Marks the trees that contain view or its parent for rebuilding and schedules their layout.*/
+        void structureChanged(View *view);
+
+        /** The roots whose trees contain view. A view below a nested root is part of two trees.*/
+        std::vector<View *> rootsContaining(const View *view) const;
+        void forgetTree(View *rootView, const Root &root);
+
+      private:
+        std::unordered_map<View *, ViewEntry> _views;
+        std::unordered_map<View *, std::unique_ptr<Root>> _roots;
+        // The roots of the built trees that each view is part of
+        std::unordered_multimap<const View *, View *> _rootsOf;
+        yoga::StylesheetCache _stylesheetCache;
+        FlexTree::ApplyStatistics _lastApplyStatistics;
+        size_t _rebuildCount = 0;
+    };
+}
@@ -0,0 +1,960 @@
+#include <bdn/ui/flex/FlexTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bdn::ui::flex
+{
+    namespace
+    {
+        using Mode = FlexTree::MeasureMode;
+
+        struct ResolvedEdges
+        {
+            float left = 0;
+            float top = 0;
+            float right = 0;
+            float bottom = 0;
+        };
+
+        bool isDefined(float value) { return !std::isnan(value); }
+
+        bool sameValue(float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+
+        float resolve(const std::optional<FlexStylesheet::ValueWithUnit> &value, float ownerSize)
+        {
+            if (!value || std::isnan(value->value)) {
+                return NAN;
+            }
+            if (value->isPercent()) {
+                return isDefined(ownerSize) ? value->value * ownerSize / 100.0f : NAN;
+            }
+            return value->value;
+        }
+
+        // Padding and margin percentages refer to the width of the owner on both axes
+        ResolvedEdges resolveEdges(const FlexStylesheet::Edges &edges, float ownerWidth)
+        {
+            auto edge = [&](const std::optional<FlexStylesheet::ValueWithUnit> &value) {
+                float resolved = resolve(value ? value : edges.all, ownerWidth);
+                return isDefined(resolved) ? resolved : 0.0f;
+            };
+            return {edge(edges.left), edge(edges.top), edge(edges.right), edge(edges.bottom)};
+        }
+
+        float resolveInset(const FlexStylesheet::Edges &position,
+                           const std::optional<FlexStylesheet::ValueWithUnit> &edge, float ownerSize)
+        {
+            return resolve(edge ? edge : position.all, ownerSize);
+        }
+
+        float bound(float value, float minimum, float maximum)
+        {
+            if (isDefined(maximum)) {
+                value = std::min(value, maximum);
+            }
+            if (isDefined(minimum)) {
+                value = std::max(value, minimum);
+            }
+            return value;
+        }
+
+        float sizeForMode(Mode mode, float available, float content, float padding, float minimum, float maximum)
+        {
+            if (mode == Mode::Exactly) {
+                return std::max(bound(available, minimum, maximum), padding);
+            }
+
+            float size = bound(content + padding, minimum, maximum);
+            if (mode == Mode::AtMost) {
+                size = std::min(size, available);
+            }
+            return std::max(size, padding);
+        }
+
+        constexpr bool isRow(FlexStylesheet::Direction direction)
+        {
+            return direction == FlexStylesheet::Direction::Row || direction == FlexStylesheet::Direction::RowReverse;
+        }
+
+        constexpr bool isReverse(FlexStylesheet::Direction direction)
+        {
+            return direction == FlexStylesheet::Direction::RowReverse ||
+                   direction == FlexStylesheet::Direction::ColumnReverse;
+        }
+
+        constexpr YGMeasureMode toYGMeasureMode(Mode mode)
+        {
+            switch (mode) {
+            case Mode::Undefined:
+                return YGMeasureModeUndefined;
+            case Mode::Exactly:
+                return YGMeasureModeExactly;
+            case Mode::AtMost:
+                return YGMeasureModeAtMost;
+            }
+            return YGMeasureModeUndefined;
+        }
+
+        FlexStylesheet::Align resolveAlign(const FlexStylesheet &parent, const FlexStylesheet &child)
+        {
+            return child.alignSelf == FlexStylesheet::Align::Auto ? parent.alignItems : child.alignSelf;
+        }
+    }
+
+    bool FlexTree::Constraint::operator==(const Constraint &other) const
+    {
+        return widthMode == other.widthMode && heightMode == other.heightMode && rtl == other.rtl &&
+               sameValue(width, other.width) && sameValue(height, other.height) &&
+               sameValue(ownerWidth, other.ownerWidth) && sameValue(ownerHeight, other.ownerHeight);
+    }
+
+    void FlexTree::build(View *root, const DescribeFunction &describe)
+    {
+        _views.clear();
+        _styles.clear();
+        _measureCaches.clear();
+        _parents.clear();
+        _children.clear();
+        _frames.clear();
+        _results.clear();
+        _flags.clear();
+        _absolutePositions.clear();
+        _indices.clear();
+
+        auto addNode = [this](View *view, uint32_t parent, const FlexStylesheet *style,
+                              yoga::MeasureCache *measureCache) {
+            auto index = static_cast<uint32_t>(_views.size());
+            bool nestedRoot = index != 0 && view->isLayoutRoot.get();
+
+            _views.push_back(view);
+            _styles.push_back(style);
+            _measureCaches.push_back(measureCache);
+            _parents.push_back(parent);
+            _children.emplace_back();
+            _frames.emplace_back();
+            _results.emplace_back();
+            _flags.push_back(nestedRoot ? isNestedRoot : 0);
+            _absolutePositions.emplace_back(NAN, NAN);
+            _indices[view] = index;
+        };
+
+        const FlexStylesheet *style = nullptr;
+        yoga::MeasureCache *measureCache = nullptr;
+        if (!describe(root, style, measureCache)) {
+            return;
+        }
+        addNode(root, 0, style, measureCache);
+
+        // Breadth first, so that the children of each node are appended as one range
+        for (uint32_t index = 0; index < _views.size(); index++) {
+            View *view = _views[index];
+            auto first = static_cast<uint32_t>(_views.size());
+
+            view->visitChildViews([&](View &child) {
+                if (child.visible.get() && describe(&child, style, measureCache)) {
+                    addNode(&child, index, style, measureCache);
+                }
+            });
+
+            _children[index] = Range{first, static_cast<uint32_t>(_views.size()) - first};
+            if (_children[index].count == 0) {
+                _flags[index] |= isLeaf;
+            }
+        }
+    }
+
+    void FlexTree::markDirty(const View *view)
+    {
+        auto it = _indices.find(view);
+        if (it == _indices.end()) {
+            return;
+        }
+
+        for (uint32_t index = it->second;; index = _parents[index]) {
+            _results[index] = Results{};
+            if (index == 0) {
+                break;
+            }
+        }
+    }
+
+    void FlexTree::updateStyle(const View *view, const FlexStylesheet *style)
+    {
+        if (auto it = _indices.find(view); it != _indices.end()) {
+            _styles[it->second] = style;
+            markDirty(view);
+        }
+    }
+
+    void FlexTree::calculate(float width, float height, float pointScaleFactor)
+    {
+        if (_views.empty()) {
+            return;
+        }
+
+        if (pointScaleFactor != _pointScaleFactor) {
+            // Leaves are measured per scale factor
+            _pointScaleFactor = pointScaleFactor;
+            std::fill(_results.begin(), _results.end(), Results{});
+        }
+
+        layoutNode(0, Constraint{width, MeasureMode::Exactly, height, MeasureMode::Exactly, width, height, false}, true,
+                   0);
+        _frames[0].x = 0;
+        _frames[0].y = 0;
+    }
+
+    FlexTree::ApplyStatistics FlexTree::apply()
+    {
+        ApplyStatistics statistics;
+        if (_views.empty()) {
+            return statistics;
+        }
+
+        struct Entry
+        {
+            uint32_t index;
+            // Unrounded and rounded absolute position of the parent
+            float parentX;
+            float parentY;
+            float parentRoundedX;
+            float parentRoundedY;
+        };
+
+        auto round = [scale = _pointScaleFactor](float value) { return std::round(value * scale) / scale; };
+
+        // Depth first, in the order of the children, without recursion
+        std::vector<Entry> stack;
+        auto pushChildren = [&](uint32_t parent, float x, float y, float roundedX, float roundedY) {
+            auto range = _children[parent];
+            for (auto i = range.count; i > 0; i--) {
+                stack.push_back(Entry{range.first + i - 1, x, y, roundedX, roundedY});
+            }
+        };
+
+        _flags[0] &= ~hasNewLayout;
+        pushChildren(0, 0, 0, 0, 0);
+
+        while (!stack.empty()) {
+            auto entry = stack.back();
+            stack.pop_back();
+
+            auto index = entry.index;
+            if ((_flags[index] & isNestedRoot) != 0) {
+                continue;
+            }
+
+            const Frame &frame = _frames[index];
+            float x = entry.parentX + frame.x;
+            float y = entry.parentY + frame.y;
+
+            // Both edges are rounded, so that adjacent views do not overlap or leave gaps
+            float left = round(x);
+            float top = round(y);
+            Rect r{left - entry.parentRoundedX, top - entry.parentRoundedY, round(x + frame.width) - left,
+                   round(y + frame.height) - top};
+
+            statistics.visitedCount++;
+            if (_views[index]->geometry.get() != r) {
+                _views[index]->geometry = r;
+                statistics.changedCount++;
+            }
+
+            // Children are positioned relative to their parent, so their geometry only changes if
+            // they were laid out again or if rounding may have changed because the subtree moved
+            bool moved =
+                !sameValue(_absolutePositions[index].first, x) || !sameValue(_absolutePositions[index].second, y);
+            bool descend = (_flags[index] & hasNewLayout) != 0 || moved;
+
+            _absolutePositions[index] = {x, y};
+            _flags[index] &= ~hasNewLayout;
+
+            if (descend) {
+                pushChildren(index, x, y, left, top);
+            }
+        }
+
+        return statistics;
+    }
+
+    const FlexTree::Result *FlexTree::findResult(uint32_t index, const Constraint &constraint,
+                                                 bool performLayout) const
+    {
+        const auto &results = _results[index];
+        if (results.hasLaidOut && results.laidOut.constraint == constraint) {
+            return &results.laidOut;
+        }
+
+        // Measuring a leaf is all there is to laying it out
+        if (!performLayout || (_flags[index] & isLeaf) != 0) {
+            for (size_t i = 0; i < results.measuredCount; i++) {
+                if (results.measured[i].constraint == constraint) {
+                    return &results.measured[i];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void FlexTree::storeResult(uint32_t index, const Constraint &constraint, bool performLayout, float width,
+                               float height)
+    {
+        auto &results = _results[index];
+        if (performLayout) {
+            results.laidOut = Result{constraint, width, height};
+            results.hasLaidOut = true;
+            return;
+        }
+
+        results.measured[results.nextMeasured] = Result{constraint, width, height};
+        results.nextMeasured = static_cast<uint8_t>((results.nextMeasured + 1) % measuredResultCount);
+        results.measuredCount = static_cast<uint8_t>(std::min<size_t>(results.measuredCount + 1u, measuredResultCount));
+    }
+
+    std::pair<float, float> FlexTree::layoutNode(uint32_t index, const Constraint &constraint, bool performLayout,
+                                                 size_t depth)
+    {
+        if (auto cached = findResult(index, constraint, performLayout)) {
+            if (performLayout && (_flags[index] & isLeaf) != 0) {
+                _frames[index].width = cached->width;
+                _frames[index].height = cached->height;
+            }
+            return {cached->width, cached->height};
+        }
+
+        auto size = (_flags[index] & isLeaf) != 0 ? measureLeaf(index, constraint)
+                                                  : layoutChildren(index, constraint, performLayout, depth);
+
+        if (performLayout) {
+            _frames[index].width = size.first;
+            _frames[index].height = size.second;
+            _flags[index] |= hasNewLayout;
+        }
+
+        storeResult(index, constraint, performLayout, size.first, size.second);
+        return size;
+    }
+
+    std::pair<float, float> FlexTree::measureLeaf(uint32_t index, const Constraint &constraint)
+    {
+        const FlexStylesheet &style = *_styles[index];
+        auto padding = resolveEdges(style.padding, constraint.ownerWidth);
+        float paddingWidth = padding.left + padding.right;
+        float paddingHeight = padding.top + padding.bottom;
+
+        float minWidth = resolve(style.minimumSize.width, constraint.ownerWidth);
+        float maxWidth = resolve(style.maximumSize.width, constraint.ownerWidth);
+        float minHeight = resolve(style.minimumSize.height, constraint.ownerHeight);
+        float maxHeight = resolve(style.maximumSize.height, constraint.ownerHeight);
+
+        if (constraint.widthMode == Mode::Exactly && constraint.heightMode == Mode::Exactly) {
+            return {std::max(bound(constraint.width, minWidth, maxWidth), paddingWidth),
+                    std::max(bound(constraint.height, minHeight, maxHeight), paddingHeight)};
+        }
+
+        float innerWidth =
+            constraint.widthMode == Mode::Undefined ? NAN : std::max(0.0f, constraint.width - paddingWidth);
+        float innerHeight =
+            constraint.heightMode == Mode::Undefined ? NAN : std::max(0.0f, constraint.height - paddingHeight);
+
+        auto measureCache = _measureCaches[index];
+        auto widthMode = toYGMeasureMode(constraint.widthMode);
+        auto heightMode = toYGMeasureMode(constraint.heightMode);
+
+        YGSize measured{};
+        if (auto cached = measureCache->findSize(innerWidth, widthMode, innerHeight, heightMode, _pointScaleFactor)) {
+            measured = *cached;
+        } else {
+            Size constraintSize(constraint.widthMode == Mode::Undefined ? Size::componentNone() : innerWidth,
+                                constraint.heightMode == Mode::Undefined ? Size::componentNone() : innerHeight);
+
+            Size s = _views[index]->sizeForSpace(constraintSize);
+            measured = YGSize{(float)s.width, (float)s.height};
+            measureCache->storeSize(innerWidth, widthMode, innerHeight, heightMode, _pointScaleFactor, measured);
+        }
+
+        float width = constraint.widthMode == Mode::Exactly ? constraint.width : measured.width + paddingWidth;
+        float height = constraint.heightMode == Mode::Exactly ? constraint.height : measured.height + paddingHeight;
+
+        return {std::max(bound(width, minWidth, maxWidth), paddingWidth),
+                std::max(bound(height, minHeight, maxHeight), paddingHeight)};
+    }
+
+    std::pair<float, float> FlexTree::layoutChildren(uint32_t index, const Constraint &constraint, bool performLayout,
+                                                     size_t depth)
+    {
+        const FlexStylesheet &style = *_styles[index];
+
+        const bool row = isRow(style.flexDirection);
+        const bool rtl = style.layoutDirection == FlexStylesheet::LayoutDirection::Inherit
+                             ? constraint.rtl
+                             : style.layoutDirection == FlexStylesheet::LayoutDirection::RTL;
+        const bool wrap = style.flexWrap != FlexStylesheet::Wrap::NoWrap;
+
+        // Positions are calculated from the start of each axis and mirrored afterwards if the axis
+        // runs the other way
+        const bool reverseMain = isReverse(style.flexDirection) != (row && rtl);
+        const bool reverseCross = (style.flexWrap == FlexStylesheet::Wrap::WrapReverse) != (!row && rtl);
+
+        auto padding = resolveEdges(style.padding, constraint.ownerWidth);
+        float paddingWidth = padding.left + padding.right;
+        float paddingHeight = padding.top + padding.bottom;
+
+        float minWidth = resolve(style.minimumSize.width, constraint.ownerWidth);
+        float maxWidth = resolve(style.maximumSize.width, constraint.ownerWidth);
+        float minHeight = resolve(style.minimumSize.height, constraint.ownerHeight);
+        float maxHeight = resolve(style.maximumSize.height, constraint.ownerHeight);
+
+        // A maximum size limits an undefined or larger available size
+        float width = constraint.width;
+        Mode widthMode = constraint.widthMode;
+        if (isDefined(maxWidth) && widthMode != Mode::Exactly && (widthMode == Mode::Undefined || maxWidth < width)) {
+            width = maxWidth;
+            widthMode = Mode::AtMost;
+        }
+        float height = constraint.height;
+        Mode heightMode = constraint.heightMode;
+        if (isDefined(maxHeight) && heightMode != Mode::Exactly &&
+            (heightMode == Mode::Undefined || maxHeight < height)) {
+            height = maxHeight;
+            heightMode = Mode::AtMost;
+        }
+
+        if (!performLayout && widthMode == Mode::Exactly && heightMode == Mode::Exactly) {
+            return {std::max(bound(width, minWidth, maxWidth), paddingWidth),
+                    std::max(bound(height, minHeight, maxHeight), paddingHeight)};
+        }
+
+        float innerWidth = widthMode == Mode::Undefined ? NAN : std::max(0.0f, width - paddingWidth);
+        float innerHeight = heightMode == Mode::Undefined ? NAN : std::max(0.0f, height - paddingHeight);
+
+        const float paddingMain = row ? paddingWidth : paddingHeight;
+        const float paddingCross = row ? paddingHeight : paddingWidth;
+        const float innerMain = row ? innerWidth : innerHeight;
+        const float innerCross = row ? innerHeight : innerWidth;
+        const Mode mainMode = row ? widthMode : heightMode;
+        const Mode crossMode = row ? heightMode : widthMode;
+        const float minInnerMain = (row ? minWidth : minHeight) - paddingMain;
+        const float maxInnerMain = (row ? maxWidth : maxHeight) - paddingMain;
+
+        auto axisConstraint = [row, rtl](float main, Mode mainMode, float cross, Mode crossMode, float ownerWidth,
+                                         float ownerHeight) {
+            return row ? Constraint{main, mainMode, cross, crossMode, ownerWidth, ownerHeight, rtl}
+                       : Constraint{cross, crossMode, main, mainMode, ownerWidth, ownerHeight, rtl};
+        };
+
+        if (_items.size() <= depth) {
+            _items.resize(depth + 1);
+            _lines.resize(depth + 1);
+        }
+        auto &items = _items[depth];
+        auto &lines = _lines[depth];
+        items.clear();
+        lines.clear();
+
+        // Flex basis of the children in flow
+        auto children = _children[index];
+        for (uint32_t child = children.first; child < children.first + children.count; child++) {
+            const FlexStylesheet &childStyle = *_styles[child];
+            if (childStyle.positionType == FlexStylesheet::PositionType::Absolute) {
+                continue;
+            }
+
+            Item item{};
+            item.index = child;
+            item.style = &childStyle;
+            item.align = resolveAlign(style, childStyle);
+
+            auto margin = resolveEdges(childStyle.margin, innerWidth);
+            item.marginMainStart = row ? margin.left : margin.top;
+            item.marginMainEnd = row ? margin.right : margin.bottom;
+            if (reverseMain) {
+                std::swap(item.marginMainStart, item.marginMainEnd);
+            }
+            item.marginCrossStart = row ? margin.top : margin.left;
+            item.marginCrossEnd = row ? margin.bottom : margin.right;
+            if (reverseCross) {
+                std::swap(item.marginCrossStart, item.marginCrossEnd);
+            }
+
+            float childWidth = resolve(childStyle.size.width, innerWidth);
+            float childHeight = resolve(childStyle.size.height, innerHeight);
+            if (childStyle.aspectRatio && *childStyle.aspectRatio > 0) {
+                if (isDefined(childWidth) && !isDefined(childHeight)) {
+                    childHeight = childWidth / *childStyle.aspectRatio;
+                } else if (isDefined(childHeight) && !isDefined(childWidth)) {
+                    childWidth = childHeight * *childStyle.aspectRatio;
+                }
+            }
+
+            float childMain = row ? childWidth : childHeight;
+            float childCross = row ? childHeight : childWidth;
+
+            item.minMain = resolve(row ? childStyle.minimumSize.width : childStyle.minimumSize.height, innerMain);
+            item.maxMain = resolve(row ? childStyle.maximumSize.width : childStyle.maximumSize.height, innerMain);
+            item.minCross = resolve(row ? childStyle.minimumSize.height : childStyle.minimumSize.width, innerCross);
+            item.maxCross = resolve(row ? childStyle.maximumSize.height : childStyle.maximumSize.width, innerCross);
+            item.stretch = item.align == FlexStylesheet::Align::Stretch && !isDefined(childCross);
+            item.cross = childCross;
+
+            float basis = resolve(childStyle.flexBasis, innerMain);
+            if (!isDefined(basis)) {
+                basis = childMain;
+            }
+            if (!isDefined(basis)) {
+                float cross = childCross;
+                Mode mode = Mode::Exactly;
+                if (!isDefined(cross)) {
+                    if (isDefined(innerCross)) {
+                        cross = std::max(0.0f, innerCross - item.marginCrossStart - item.marginCrossEnd);
+                        mode = item.stretch && crossMode == Mode::Exactly && !wrap ? Mode::Exactly : Mode::AtMost;
+                    } else {
+                        mode = Mode::Undefined;
+                    }
+                }
+
+                auto basisConstraint = axisConstraint(NAN, Mode::Undefined, cross, mode, innerWidth, innerHeight);
+                auto size = layoutNode(child, basisConstraint, false, depth + 1);
+                basis = row ? size.first : size.second;
+            }
+
+            item.basis = basis;
+            item.hypotheticalMain = bound(basis, item.minMain, item.maxMain);
+            items.push_back(item);
+        }
+
+        // Lines
+        size_t lineStart = 0;
+        float lineMain = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            float itemMain = items[i].hypotheticalMain + items[i].marginMainStart + items[i].marginMainEnd;
+            if (wrap && isDefined(innerMain) && i > lineStart && lineMain + itemMain > innerMain) {
+                lines.push_back(Line{lineStart, i, 0, 0});
+                lineStart = i;
+                lineMain = 0;
+            }
+            lineMain += itemMain;
+        }
+        lines.push_back(Line{lineStart, items.size(), 0, 0});
+
+        // Flexible lengths, with the items that violate their minimum or maximum size frozen one
+        // round at a time
+        float maxLineMain = 0;
+        for (auto &line : lines) {
+            float hypotheticalSum = 0;
+            float growSum = 0;
+            for (size_t i = line.first; i < line.end; i++) {
+                hypotheticalSum += items[i].hypotheticalMain + items[i].marginMainStart + items[i].marginMainEnd;
+                growSum += items[i].style->flexGrow;
+            }
+
+            float available = innerMain;
+            if (mainMode != Mode::Exactly) {
+                if (isDefined(minInnerMain) && hypotheticalSum < minInnerMain) {
+                    available = minInnerMain;
+                } else if (isDefined(maxInnerMain) && hypotheticalSum > maxInnerMain) {
+                    available = maxInnerMain;
+                } else if (!isDefined(available) || growSum == 0) {
+                    available = hypotheticalSum;
+                }
+            }
+
+            const bool growing = available > hypotheticalSum;
+            for (size_t i = line.first; i < line.end; i++) {
+                auto &item = items[i];
+                float factor = growing ? item.style->flexGrow : item.style->flexShrink;
+                item.main = item.hypotheticalMain;
+                item.frozen = factor <= 0 || (growing && item.basis > item.hypotheticalMain) ||
+                              (!growing && item.basis < item.hypotheticalMain);
+            }
+
+            for (;;) {
+                float used = 0;
+                float factors = 0;
+                bool hasUnfrozen = false;
+                for (size_t i = line.first; i < line.end; i++) {
+                    auto &item = items[i];
+                    used += item.marginMainStart + item.marginMainEnd + (item.frozen ? item.main : item.basis);
+                    if (!item.frozen) {
+                        hasUnfrozen = true;
+                        factors += growing ? item.style->flexGrow : item.style->flexShrink * item.basis;
+                    }
+                }
+                if (!hasUnfrozen) {
+                    break;
+                }
+
+                float freeSpace = available - used;
+                float totalViolation = 0;
+                for (size_t i = line.first; i < line.end; i++) {
+                    auto &item = items[i];
+                    if (item.frozen) {
+                        continue;
+                    }
+
+                    float target = item.basis;
+                    if (factors > 0) {
+                        float factor = growing ? item.style->flexGrow : item.style->flexShrink * item.basis;
+                        target += freeSpace * factor / factors;
+                    }
+                    float clamped = std::max(0.0f, bound(target, item.minMain, item.maxMain));
+                    item.violation = clamped - target;
+                    item.main = clamped;
+                    totalViolation += item.violation;
+                }
+
+                for (size_t i = line.first; i < line.end; i++) {
+                    auto &item = items[i];
+                    if (!item.frozen && (totalViolation == 0 || (totalViolation > 0 && item.violation > 0) ||
+                                         (totalViolation < 0 && item.violation < 0))) {
+                        item.frozen = true;
+                    }
+                }
+            }
+
+            float lineUsed = 0;
+            for (size_t i = line.first; i < line.end; i++) {
+                lineUsed += items[i].main + items[i].marginMainStart + items[i].marginMainEnd;
+            }
+            maxLineMain = std::max(maxLineMain, lineUsed);
+        }
+
+        // Cross sizes of the items and lines
+        bool performedForBaseline = false;
+        float totalCross = 0;
+        for (auto &line : lines) {
+            float lineCross = 0;
+            float maxDescent = 0;
+            for (size_t i = line.first; i < line.end; i++) {
+                auto &item = items[i];
+                float margins = item.marginCrossStart + item.marginCrossEnd;
+
+                if (isDefined(item.cross)) {
+                    item.cross = bound(item.cross, item.minCross, item.maxCross);
+                } else if (item.style->aspectRatio && *item.style->aspectRatio > 0) {
+                    item.cross = row ? item.main / *item.style->aspectRatio : item.main * *item.style->aspectRatio;
+                } else if (item.stretch && crossMode == Mode::Exactly && !wrap) {
+                    item.cross = bound(std::max(0.0f, innerCross - margins), item.minCross, item.maxCross);
+                } else {
+                    bool crossDefined = isDefined(innerCross);
+                    auto size = layoutNode(item.index,
+                                           axisConstraint(item.main, Mode::Exactly,
+                                                          crossDefined ? std::max(0.0f, innerCross - margins) : NAN,
+                                                          crossDefined ? Mode::AtMost : Mode::Undefined, innerWidth,
+                                                          innerHeight),
+                                           false, depth + 1);
+                    item.cross = row ? size.second : size.first;
+                }
+
+                if (row && item.align == FlexStylesheet::Align::Baseline) {
+                    layoutNode(item.index,
+                               axisConstraint(item.main, Mode::Exactly, item.cross, Mode::Exactly, innerWidth,
+                                              innerHeight),
+                               true, depth + 1);
+                    performedForBaseline = true;
+
+                    item.ascent = item.marginCrossStart + baselineOf(item.index);
+                    line.maxAscent = std::max(line.maxAscent, item.ascent);
+                    maxDescent = std::max(maxDescent, item.cross + margins - item.ascent);
+                } else {
+                    lineCross = std::max(lineCross, item.cross + margins);
+                }
+            }
+            line.cross = std::max(lineCross, line.maxAscent + maxDescent);
+            totalCross += line.cross;
+        }
+
+        if (!wrap && crossMode == Mode::Exactly) {
+            totalCross = innerCross;
+        }
+
+        float mainSize = sizeForMode(mainMode, row ? width : height, maxLineMain, paddingMain,
+                                     row ? minWidth : minHeight, row ? maxWidth : maxHeight);
+        float crossSize = sizeForMode(crossMode, row ? height : width, totalCross, paddingCross,
+                                      row ? minHeight : minWidth, row ? maxHeight : maxWidth);
+
+        float resultWidth = row ? mainSize : crossSize;
+        float resultHeight = row ? crossSize : mainSize;
+
+        if (!performLayout) {
+            if (performedForBaseline) {
+                // Laying out the children for their baselines replaced the frames of the last layout
+                _results[index].hasLaidOut = false;
+            }
+            return {resultWidth, resultHeight};
+        }
+
+        const float finalInnerWidth = resultWidth - paddingWidth;
+        const float finalInnerHeight = resultHeight - paddingHeight;
+        const float finalInnerMain = mainSize - paddingMain;
+        const float finalInnerCross = crossSize - paddingCross;
+
+        // A single line always fills the container
+        if (!wrap) {
+            lines.front().cross = finalInnerCross;
+        }
+
+        float crossOffset = 0;
+        float lineGap = 0;
+        if (wrap) {
+            float freeCross = finalInnerCross - totalCross;
+            switch (style.alignContents) {
+            case FlexStylesheet::Align::Center:
+                crossOffset = freeCross / 2;
+                break;
+            case FlexStylesheet::Align::FlexEnd:
+                crossOffset = freeCross;
+                break;
+            case FlexStylesheet::Align::Stretch:
+                if (freeCross > 0) {
+                    for (auto &line : lines) {
+                        line.cross += freeCross / static_cast<float>(lines.size());
+                    }
+                }
+                break;
+            case FlexStylesheet::Align::SpaceBetween:
+                if (freeCross > 0 && lines.size() > 1) {
+                    lineGap = freeCross / static_cast<float>(lines.size() - 1);
+                }
+                break;
+            case FlexStylesheet::Align::SpaceAround:
+                if (freeCross > 0) {
+                    lineGap = freeCross / static_cast<float>(lines.size());
+                    crossOffset = lineGap / 2;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        for (auto &line : lines) {
+            size_t count = line.end - line.first;
+            float used = 0;
+            for (size_t i = line.first; i < line.end; i++) {
+                used += items[i].main + items[i].marginMainStart + items[i].marginMainEnd;
+            }
+
+            float freeMain = finalInnerMain - used;
+            float leading = 0;
+            float between = 0;
+            switch (style.justifyContent) {
+            case FlexStylesheet::Justify::FlexStart:
+                break;
+            case FlexStylesheet::Justify::Center:
+                leading = freeMain / 2;
+                break;
+            case FlexStylesheet::Justify::FlexEnd:
+                leading = freeMain;
+                break;
+            case FlexStylesheet::Justify::SpaceBetween:
+                if (freeMain > 0 && count > 1) {
+                    between = freeMain / static_cast<float>(count - 1);
+                }
+                break;
+            case FlexStylesheet::Justify::SpaceAround:
+                if (freeMain > 0 && count > 0) {
+                    between = freeMain / static_cast<float>(count);
+                    leading = between / 2;
+                }
+                break;
+            case FlexStylesheet::Justify::SpaceEvenly:
+                if (freeMain > 0) {
+                    between = freeMain / static_cast<float>(count + 1);
+                    leading = between;
+                }
+                break;
+            }
+
+            float mainPosition = leading;
+            for (size_t i = line.first; i < line.end; i++) {
+                auto &item = items[i];
+                float crossMargins = item.marginCrossStart + item.marginCrossEnd;
+
+                float cross = item.cross;
+                if (item.stretch && !item.style->aspectRatio) {
+                    cross = bound(std::max(0.0f, line.cross - crossMargins), item.minCross, item.maxCross);
+                }
+
+                auto size = layoutNode(item.index,
+                                       axisConstraint(item.main, Mode::Exactly, cross, Mode::Exactly, finalInnerWidth,
+                                                      finalInnerHeight),
+                                       true, depth + 1);
+                float itemMain = row ? size.first : size.second;
+                float itemCross = row ? size.second : size.first;
+
+                float crossPosition = item.marginCrossStart;
+                float freeInLine = line.cross - itemCross - crossMargins;
+                switch (item.align) {
+                case FlexStylesheet::Align::Center:
+                    crossPosition += freeInLine / 2;
+                    break;
+                case FlexStylesheet::Align::FlexEnd:
+                    crossPosition += freeInLine;
+                    break;
+                case FlexStylesheet::Align::Baseline:
+                    if (row) {
+                        crossPosition = line.maxAscent - item.ascent + item.marginCrossStart;
+                    }
+                    break;
+                default:
+                    break;
+                }
+
+                float main = mainPosition + item.marginMainStart;
+                mainPosition = main + itemMain + item.marginMainEnd + between;
+                crossPosition += crossOffset;
+
+                if (reverseMain) {
+                    main = finalInnerMain - main - itemMain;
+                }
+                if (reverseCross) {
+                    crossPosition = finalInnerCross - crossPosition - itemCross;
+                }
+
+                auto &frame = _frames[item.index];
+                frame.x = padding.left + (row ? main : crossPosition);
+                frame.y = padding.top + (row ? crossPosition : main);
+
+                // Relative offsets move the view without affecting its siblings
+                const auto &position = item.style->position;
+                float left = resolveInset(position, position.left, finalInnerWidth);
+                float right = resolveInset(position, position.right, finalInnerWidth);
+                float top = resolveInset(position, position.top, finalInnerHeight);
+                float bottom = resolveInset(position, position.bottom, finalInnerHeight);
+                frame.x += isDefined(left) ? left : (isDefined(right) ? -right : 0.0f);
+                frame.y += isDefined(top) ? top : (isDefined(bottom) ? -bottom : 0.0f);
+            }
+
+            crossOffset += line.cross + lineGap;
+        }
+
+        // Absolutely positioned children are placed in the padding box
+        for (uint32_t child = children.first; child < children.first + children.count; child++) {
+            const FlexStylesheet &childStyle = *_styles[child];
+            if (childStyle.positionType != FlexStylesheet::PositionType::Absolute) {
+                continue;
+            }
+
+            auto margin = resolveEdges(childStyle.margin, resultWidth);
+            const auto &position = childStyle.position;
+            float left = resolveInset(position, position.left, resultWidth);
+            float right = resolveInset(position, position.right, resultWidth);
+            float top = resolveInset(position, position.top, resultHeight);
+            float bottom = resolveInset(position, position.bottom, resultHeight);
+
+            float childWidth = resolve(childStyle.size.width, resultWidth);
+            float childHeight = resolve(childStyle.size.height, resultHeight);
+            if (!isDefined(childWidth) && isDefined(left) && isDefined(right)) {
+                childWidth = std::max(0.0f, resultWidth - left - right - margin.left - margin.right);
+            }
+            if (!isDefined(childHeight) && isDefined(top) && isDefined(bottom)) {
+                childHeight = std::max(0.0f, resultHeight - top - bottom - margin.top - margin.bottom);
+            }
+            if (childStyle.aspectRatio && *childStyle.aspectRatio > 0) {
+                if (isDefined(childWidth) && !isDefined(childHeight)) {
+                    childHeight = childWidth / *childStyle.aspectRatio;
+                } else if (isDefined(childHeight) && !isDefined(childWidth)) {
+                    childWidth = childHeight * *childStyle.aspectRatio;
+                }
+            }
+
+            if (!isDefined(childWidth) || !isDefined(childHeight)) {
+                bool widthDefined = isDefined(childWidth);
+                auto size = layoutNode(
+                    child,
+                    Constraint{widthDefined ? childWidth : std::max(0.0f, resultWidth - margin.left - margin.right),
+                               widthDefined ? Mode::Exactly : Mode::AtMost, childHeight,
+                               isDefined(childHeight) ? Mode::Exactly : Mode::Undefined, resultWidth, resultHeight,
+                               rtl},
+                    false, depth + 1);
+                childWidth = widthDefined ? childWidth : size.first;
+                childHeight = isDefined(childHeight) ? childHeight : size.second;
+            }
+
+            auto size = layoutNode(child,
+                                   Constraint{childWidth, Mode::Exactly, childHeight, Mode::Exactly, resultWidth,
+                                              resultHeight, rtl},
+                                   true, depth + 1);
+
+            // Without insets the child is placed like a single item of the container
+            auto place = [](bool center, bool atEnd, float size, float paddingStart, float paddingEnd,
+                            float marginStart, float marginEnd, float childSize) {
+                if (center) {
+                    return paddingStart + marginStart +
+                           (size - paddingStart - paddingEnd - marginStart - marginEnd - childSize) / 2;
+                }
+                return atEnd ? size - paddingEnd - marginEnd - childSize : paddingStart + marginStart;
+            };
+
+            auto align = resolveAlign(style, childStyle);
+            bool centerMain = style.justifyContent == FlexStylesheet::Justify::Center;
+            bool endMain = (style.justifyContent == FlexStylesheet::Justify::FlexEnd) != reverseMain;
+            bool centerCross = align == FlexStylesheet::Align::Center;
+            bool endCross = (align == FlexStylesheet::Align::FlexEnd) != reverseCross;
+
+            auto &frame = _frames[child];
+            if (isDefined(left)) {
+                frame.x = left + margin.left;
+            } else if (isDefined(right)) {
+                frame.x = resultWidth - right - margin.right - size.first;
+            } else {
+                frame.x = place(row ? centerMain : centerCross, row ? endMain : endCross, resultWidth, padding.left,
+                                padding.right, margin.left, margin.right, size.first);
+            }
+
+            if (isDefined(top)) {
+                frame.y = top + margin.top;
+            } else if (isDefined(bottom)) {
+                frame.y = resultHeight - bottom - margin.bottom - size.second;
+            } else {
+                frame.y = place(row ? centerCross : centerMain, row ? endCross : endMain, resultHeight, padding.top,
+                                padding.bottom, margin.top, margin.bottom, size.second);
+            }
+        }
+
+        return {resultWidth, resultHeight};
+    }
+
+    float FlexTree::baselineOf(uint32_t index)
+    {
+        const Frame &frame = _frames[index];
+
+        if ((_flags[index] & isLeaf) != 0) {
+            auto measureCache = _measureCaches[index];
+            if (auto cached = measureCache->findBaseline(frame.width, frame.height)) {
+                return *cached;
+            }
+
+            float baseline = _views[index]->baseline(Size{frame.width, frame.height});
+            measureCache->storeBaseline(frame.width, frame.height, baseline);
+            return baseline;
+        }
+
+        // The baseline of a container is the one of its first baseline aligned child, or of its
+        // first child if none is
+        const FlexStylesheet &style = *_styles[index];
+        auto children = _children[index];
+        auto chosen = std::numeric_limits<uint32_t>::max();
+        for (uint32_t child = children.first; child < children.first + children.count; child++) {
+            const FlexStylesheet &childStyle = *_styles[child];
+            if (childStyle.positionType == FlexStylesheet::PositionType::Absolute) {
+                continue;
+            }
+            if (chosen == std::numeric_limits<uint32_t>::max()) {
+                chosen = child;
+            }
+            if (resolveAlign(style, childStyle) == FlexStylesheet::Align::Baseline) {
+                chosen = child;
+                break;
+            }
+        }
+
+        if (chosen == std::numeric_limits<uint32_t>::max()) {
+            return frame.height;
+        }
+        return _frames[chosen].y + baselineOf(chosen);
+    }
+}
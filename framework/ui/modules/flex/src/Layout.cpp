@@ -0,0 +1,166 @@
+#include <bdn/ui/View.h>
+#include <bdn/ui/Window.h>
+#include <bdn/ui/flex/Layout.h>
+
+namespace bdn::ui::flex
+{
+    void Layout::registerView(View *view)
+    {
+        auto &entry = _views[view];
+        entry.style = nullptr;
+        entry.measureCache.invalidate();
+        entry.visible = view->visible.get();
+
+        // Views whose parent uses another layout are sized by it, this layout only lays out their content
+        auto parent = view->parentView->lock();
+        if (!parent || view->isLayoutRoot || parent->getLayout().get() != this) {
+            auto root = std::make_unique<Root>();
+            if (auto window = dynamic_cast<Window *>(view)) {
+                root->geometry.bind(window->contentGeometry);
+            } else {
+                root->geometry.bind(view->geometry);
+            }
+
+            // The cached results are kept, only the constraints of the root change
+            root->geometry.onChange() += [view](auto &property) { view->scheduleLayout(); };
+            _roots[view] = std::move(root);
+        }
+
+        updateStylesheet(view);
+        structureChanged(view);
+    }
+
+    void Layout::unregisterView(View *view)
+    {
+        structureChanged(view);
+        if (auto it = _roots.find(view); it != _roots.end()) {
+            forgetTree(view, *it->second);
+            _roots.erase(it);
+        }
+        _rootsOf.erase(view);
+        _views.erase(view);
+    }
+
+    void Layout::markDirty(View *view)
+    {
+        if (auto it = _views.find(view); it != _views.end()) {
+            it->second.measureCache.invalidate();
+
+            for (View *rootView : rootsContaining(view)) {
+                _roots.at(rootView)->tree.markDirty(view);
+                rootView->scheduleLayout();
+            }
+        }
+    }
+
+    void Layout::updateStylesheet(View *view)
+    {
+        auto it = _views.find(view);
+        if (it == _views.end()) {
+            return;
+        }
+
+        updateVisibility(view);
+
+        auto &entry = it->second;
+        auto compiled = _stylesheetCache.compile(view->stylesheet.get());
+        if (compiled == entry.style) {
+            return;
+        }
+
+        entry.measureCache.invalidate();
+        entry.style = std::move(compiled);
+
+        for (View *rootView : rootsContaining(view)) {
+            _roots.at(rootView)->tree.updateStyle(view, entry.style.get());
+            rootView->scheduleLayout();
+        }
+    }
+
+    void Layout::updateVisibility(View *view)
+    {
+        auto it = _views.find(view);
+        if (it == _views.end()) {
+            return;
+        }
+
+        if (bool visible = view->visible.get(); visible != it->second.visible) {
+            it->second.visible = visible;
+            structureChanged(view);
+        }
+    }
+
+    void Layout::structureChanged(View *view)
+    {
+        std::vector<View *> rootViews = rootsContaining(view);
+        if (auto parent = view->parentView->lock()) {
+            auto parentRoots = rootsContaining(parent.get());
+            rootViews.insert(rootViews.end(), parentRoots.begin(), parentRoots.end());
+        }
+        // A new root has not been built yet
+        if (_roots.count(view) != 0) {
+            rootViews.push_back(view);
+        }
+
+        for (View *rootView : rootViews) {
+            _roots.at(rootView)->needsRebuild = true;
+            rootView->scheduleLayout();
+        }
+    }
+
+    std::vector<View *> Layout::rootsContaining(const View *view) const
+    {
+        std::vector<View *> rootViews;
+        auto [first, last] = _rootsOf.equal_range(view);
+        for (auto it = first; it != last; ++it) {
+            rootViews.push_back(it->second);
+        }
+        return rootViews;
+    }
+
+    void Layout::forgetTree(View *rootView, const Root &root)
+    {
+        for (View *view : root.tree.views()) {
+            auto [first, last] = _rootsOf.equal_range(view);
+            for (auto it = first; it != last; ++it) {
+                if (it->second == rootView) {
+                    _rootsOf.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+
+    void Layout::layout(View *view)
+    {
+        auto it = _roots.find(view);
+        if (it == _roots.end()) {
+            return;
+        }
+
+        auto &root = *it->second;
+        if (root.needsRebuild) {
+            forgetTree(view, root);
+            root.tree.build(view, [this](View *candidate, const FlexStylesheet *&style,
+                                         yoga::MeasureCache *&measureCache) {
+                auto entry = _views.find(candidate);
+                if (entry == _views.end()) {
+                    return false;
+                }
+                style = entry->second.style.get();
+                measureCache = &entry->second.measureCache;
+                return true;
+            });
+            for (View *treeView : root.tree.views()) {
+                _rootsOf.emplace(treeView, view);
+            }
+            root.needsRebuild = false;
+            _rebuildCount++;
+        }
+
+        auto geometry = root.geometry.get();
+        root.tree.calculate(static_cast<float>(geometry.width), static_cast<float>(geometry.height),
+                            view->pointScaleFactor());
+        _lastApplyStatistics = root.tree.apply();
+    }
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <bdn/Json.h>
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bdn::ui::grid
+{
+    /** The "grid" section of a view's stylesheet.
+
+        A view whose children are laid out by grid::Layout is a grid container. Its tracks are
+        defined by columns and rows; items that are placed outside of them create implicit tracks
+        sized like autoColumns and autoRows. The item properties (column, row, spans, alignment and
+        size) are read from the stylesheets of the container's children.*/
+    class GridStylesheet
+    {
+      public:
+        struct Track
+        {
+            enum class Unit
+            {
+                Auto,
+                Pixel,
+                Percent,
+                Fraction
+            } unit = Unit::Auto;
+            float value = 0;
+
+            bool operator==(const Track &other) const { return unit == other.unit && value == other.value; }
+        };
+
+        enum class Align
+        {
+            Stretch,
+            Start,
+            Center,
+            End
+        };
+
+        enum class AutoFlow
+        {
+            Row,
+            Column
+        };
+
+        struct Edges
+        {
+            float left = 0;
+            float top = 0;
+            float right = 0;
+            float bottom = 0;
+
+            bool operator==(const Edges &other) const
+            {
+                return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+            }
+        };
+
+      public:
+        std::vector<Track> columns;
+        std::vector<Track> rows;
+        Track autoColumns;
+        Track autoRows;
+
+        float columnGap = 0;
+        float rowGap = 0;
+        Edges padding;
+
+        AutoFlow autoFlow = AutoFlow::Row;
+        Align justifyItems = Align::Stretch;
+        Align alignItems = Align::Stretch;
+
+        /** One based line the item starts at, or automatic placement.*/
+        std::optional<int> column;
+        std::optional<int> row;
+        int columnSpan = 1;
+        int rowSpan = 1;
+
+        std::optional<Align> justifySelf;
+        std::optional<Align> alignSelf;
+
+        std::optional<float> width;
+        std::optional<float> height;
+
+        bool operator==(const GridStylesheet &other) const
+        {
+            return columns == other.columns && rows == other.rows && autoColumns == other.autoColumns &&
+                   autoRows == other.autoRows && columnGap == other.columnGap && rowGap == other.rowGap &&
+                   padding == other.padding && autoFlow == other.autoFlow && justifyItems == other.justifyItems &&
+                   alignItems == other.alignItems && column == other.column && row == other.row &&
+                   columnSpan == other.columnSpan && rowSpan == other.rowSpan && justifySelf == other.justifySelf &&
+                   alignSelf == other.alignSelf && width == other.width && height == other.height;
+        }
+
+        bool operator!=(const GridStylesheet &other) const { return !(*this == other); }
+    };
+}
+
+namespace nlohmann
+{
+    NLOHMANN_JSON_SERIALIZE_ENUM(bdn::ui::grid::GridStylesheet::Align,
+                                 {
+                                     {bdn::ui::grid::GridStylesheet::Align::Stretch, "Stretch"},
+                                     {bdn::ui::grid::GridStylesheet::Align::Start, "Start"},
+                                     {bdn::ui::grid::GridStylesheet::Align::Center, "Center"},
+                                     {bdn::ui::grid::GridStylesheet::Align::End, "End"},
+                                 })
+
+    NLOHMANN_JSON_SERIALIZE_ENUM(bdn::ui::grid::GridStylesheet::AutoFlow,
+                                 {
+                                     {bdn::ui::grid::GridStylesheet::AutoFlow::Row, "Row"},
+                                     {bdn::ui::grid::GridStylesheet::AutoFlow::Column, "Column"},
+                                 })
+
+    template <> struct adl_serializer<bdn::ui::grid::GridStylesheet::Track>
+    {
+        using Track = bdn::ui::grid::GridStylesheet::Track;
+
+        static void to_json(json &j, const Track &track)
+        {
+            switch (track.unit) {
+            case Track::Unit::Auto:
+                j = "auto";
+                break;
+            case Track::Unit::Pixel:
+                j = track.value;
+                break;
+            case Track::Unit::Percent:
+                j = std::to_string(track.value) + "%";
+                break;
+            case Track::Unit::Fraction:
+                j = std::to_string(track.value) + "fr";
+                break;
+            }
+        }
+
+        // Tracks are numbers (pixels) or strings like "auto", "120", "120px", "25%" or "1fr"
+        static void from_json(const json &j, Track &track)
+        {
+            if (j.is_number()) {
+                track.value = j.get<float>();
+                track.unit = Track::Unit::Pixel;
+                return;
+            }
+
+            if (!j.is_string()) {
+                JSON_THROW(nlohmann::json::type_error::create(302, "type must be number or string, but is " +
+                                                                       std::string(j.type_name())));
+            }
+
+            std::string s = j.get<std::string>();
+            if (s == "auto") {
+                track = Track{};
+                return;
+            }
+
+            std::string unit;
+            std::istringstream istr(s);
+            istr.imbue(std::locale("C"));
+            istr >> track.value;
+
+            if (istr.fail()) {
+                JSON_THROW(nlohmann::json::other_error::create(501, "Failed parsing string to number: \"" + s + "\""));
+            }
+
+            istr >> unit;
+
+            if (unit == "fr") {
+                track.unit = Track::Unit::Fraction;
+            } else if (unit == "%") {
+                track.unit = Track::Unit::Percent;
+            } else if (unit == "px" || unit.empty()) {
+                track.unit = Track::Unit::Pixel;
+            } else {
+                JSON_THROW(
+                    nlohmann::json::other_error::create(501, "Invalid unit: \"" + unit + "\" in: \"" + s + "\""));
+            }
+        }
+    };
+
+    template <> struct adl_serializer<bdn::ui::grid::GridStylesheet::Edges>
+    {
+        using Edges = bdn::ui::grid::GridStylesheet::Edges;
+
+        static void to_json(json &j, const Edges &edges)
+        {
+            j = {{"left", edges.left}, {"top", edges.top}, {"right", edges.right}, {"bottom", edges.bottom}};
+        }
+
+        static void from_json(const json &j, Edges &edges)
+        {
+            if (j.is_number()) {
+                edges.left = edges.top = edges.right = edges.bottom = j.get<float>();
+                return;
+            }
+
+            if (j.count("all") != 0) {
+                edges.left = edges.top = edges.right = edges.bottom = j.at("all").get<float>();
+            }
+            if (j.count("left") != 0) {
+                edges.left = j.at("left");
+            }
+            if (j.count("top") != 0) {
+                edges.top = j.at("top");
+            }
+            if (j.count("right") != 0) {
+                edges.right = j.at("right");
+            }
+            if (j.count("bottom") != 0) {
+                edges.bottom = j.at("bottom");
+            }
+        }
+    };
+
+    template <> struct adl_serializer<bdn::ui::grid::GridStylesheet>
+    {
+        using GridStylesheet = bdn::ui::grid::GridStylesheet;
+
+        static void to_json(json &j, const GridStylesheet &sheet)
+        {
+            j = {
+                {"columns", sheet.columns},
+                {"rows", sheet.rows},
+                {"autoColumns", sheet.autoColumns},
+                {"autoRows", sheet.autoRows},
+                {"columnGap", sheet.columnGap},
+                {"rowGap", sheet.rowGap},
+                {"padding", sheet.padding},
+                {"autoFlow", sheet.autoFlow},
+                {"justifyItems", sheet.justifyItems},
+                {"alignItems", sheet.alignItems},
+                {"columnSpan", sheet.columnSpan},
+                {"rowSpan", sheet.rowSpan},
+            };
+
+            if (sheet.column) {
+                j["column"] = *sheet.column;
+            }
+            if (sheet.row) {
+                j["row"] = *sheet.row;
+            }
+            if (sheet.justifySelf) {
+                j["justifySelf"] = *sheet.justifySelf;
+            }
+            if (sheet.alignSelf) {
+                j["alignSelf"] = *sheet.alignSelf;
+            }
+            if (sheet.width || sheet.height) {
+                j["size"] = json::object();
+                if (sheet.width) {
+                    j["size"]["width"] = *sheet.width;
+                }
+                if (sheet.height) {
+                    j["size"]["height"] = *sheet.height;
+                }
+            }
+        }
+
+        static void from_json(const json &j, GridStylesheet &sheet)
+        {
+            if (j.count("columns") != 0) {
+                sheet.columns = j.at("columns").get<std::vector<GridStylesheet::Track>>();
+            }
+            if (j.count("rows") != 0) {
+                sheet.rows = j.at("rows").get<std::vector<GridStylesheet::Track>>();
+            }
+            if (j.count("autoColumns") != 0) {
+                sheet.autoColumns = j.at("autoColumns");
+            }
+            if (j.count("autoRows") != 0) {
+                sheet.autoRows = j.at("autoRows");
+            }
+            if (j.count("gap") != 0) {
+                sheet.columnGap = sheet.rowGap = j.at("gap").get<float>();
+            }
+            if (j.count("columnGap") != 0) {
+                sheet.columnGap = j.at("columnGap");
+            }
+            if (j.count("rowGap") != 0) {
+                sheet.rowGap = j.at("rowGap");
+            }
+            if (j.count("padding") != 0) {
+                sheet.padding = j.at("padding");
+            }
+            if (j.count("autoFlow") != 0) {
+                sheet.autoFlow = j.at("autoFlow");
+            }
+            if (j.count("justifyItems") != 0) {
+                sheet.justifyItems = j.at("justifyItems");
+            }
+            if (j.count("alignItems") != 0) {
+                sheet.alignItems = j.at("alignItems");
+            }
+            if (j.count("column") != 0) {
+                sheet.column = j.at("column").get<int>();
+            }
+            if (j.count("row") != 0) {
+                sheet.row = j.at("row").get<int>();
+            }
+            if (j.count("columnSpan") != 0) {
+                sheet.columnSpan = j.at("columnSpan");
+            }
+            if (j.count("rowSpan") != 0) {
+                sheet.rowSpan = j.at("rowSpan");
+            }
+            if (j.count("justifySelf") != 0) {
+                sheet.justifySelf = j.at("justifySelf").get<GridStylesheet::Align>();
+            }
+            if (j.count("alignSelf") != 0) {
+                sheet.alignSelf = j.at("alignSelf").get<GridStylesheet::Align>();
+            }
+            if (j.count("size") != 0) {
+                const auto &size = j.at("size");
+                if (size.count("width") != 0) {
+                    sheet.width = size.at("width").get<float>();
+                }
+                if (size.count("height") != 0) {
+                    sheet.height = size.at("height").get<float>();
+                }
+            }
+        }
+    };
+}
+
+#define GridJsonStringify(str...) JsonStringify({"grid" : str})
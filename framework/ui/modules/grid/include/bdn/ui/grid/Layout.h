@@ -0,0 +1,108 @@
+#pragma once
+
+#include <bdn/Rect.h>
+#include <bdn/property/Property.h>
+#include <bdn/ui/Layout.h>
+#include <bdn/ui/grid/GridStylesheet.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace bdn::ui::grid
+{
+    /** A layout that places the children of a view in the cells of a grid, configured by the "grid"
+        section of the view's stylesheet (see GridStylesheet).
+
+        Tracks are sized in a single pass per axis: fixed and percentage tracks first, then auto tracks
+        from the items they contain, then fr tracks share the remaining space. Columns are sized before
+        rows, so the row pass can measure items at their final width.
+
+        Views with a parent that is not laid out by this layout are roots. When such a root sits in a
+        tree laid out by another layout (like yoga::Layout), that layout sizes it through
+        sizeForSpace() and this layout places its children once its geometry is known.*/
+    class Layout : public ui::Layout
+    {
+      public:
+        struct Statistics
+        {
+            size_t measuredCount = 0;
+            size_t changedCount = 0;
+        };
+
+      public:
+        void registerView(View *view) override;
+        void unregisterView(View *view) override;
+
+        void markDirty(View *view) override;
+        void updateStylesheet(View *view) override;
+
+        void layout(View *view) override;
+
+        std::optional<Size> sizeForSpace(const View &view, Size availableSpace) override;
+
+        /** How many views the last layout pass measured and how many geometries it changed.*/
+        Statistics lastStatistics() const { return _lastStatistics; }
+
+      private:
+        struct Measurement
+        {
+            Size availableSpace;
+            Size size;
+        };
+
+        struct ViewEntry
+        {
+            GridStylesheet style;
+            bool visible = false;
+            std::vector<Measurement> measurements;
+            size_t nextMeasurement = 0;
+        };
+
+        struct Root
+        {
+            Property<Rect> geometry;
+        };
+
+        struct Item
+        {
+            View *view;
+            const GridStylesheet *style;
+            int start[2];
+            int span[2];
+            std::optional<double> contentSize[2];
+        };
+
+        // Axis 0 are the columns, axis 1 the rows
+        struct Solution
+        {
+            const GridStylesheet *style;
+            std::vector<Item> items;
+            std::vector<double> sizes[2];
+            std::vector<double> positions[2];
+            Size size;
+        };
+
+      private:
+        bool isContainer(const View *view) const;
+
+        Solution solve(const View *view, const GridStylesheet &style, Size availableSpace);
+        void placeItems(const GridStylesheet &style, Solution &solution) const;
+        void sizeTracks(const GridStylesheet &style, Solution &solution, int axis, double availableSpace);
+
+        double itemContentSize(Item &item, Solution &solution, int axis);
+        double itemSize(Item &item, Solution &solution, int axis);
+        static double areaSize(const Item &item, const Solution &solution, int axis);
+
+        Size measure(const View *view, Size availableSpace);
+        void apply(View *view, const GridStylesheet &style, Size size);
+
+        /** Drops the measurements of view and its ancestors and schedules the layout of its root.*/
+        void invalidate(View *view);
+
+      private:
+        std::unordered_map<const View *, ViewEntry> _views;
+        std::unordered_map<const View *, std::unique_ptr<Root>> _roots;
+        Statistics _lastStatistics;
+    };
+}
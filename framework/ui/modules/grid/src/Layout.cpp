@@ -0,0 +1,520 @@
+#include <bdn/ui/View.h>
+#include <bdn/ui/Window.h>
+#include <bdn/ui/grid/Layout.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace bdn::ui::grid
+{
+    namespace
+    {
+        // A view is usually measured with at most a handful of different spaces (unconstrained, the
+        // width of its column, the size offered by a parent layout)
+        constexpr size_t maxMeasurements = 4;
+
+        using Track = GridStylesheet::Track;
+        using Align = GridStylesheet::Align;
+
+        const Track &trackDefinition(const GridStylesheet &style, int axis, size_t index)
+        {
+            const auto &tracks = axis == 0 ? style.columns : style.rows;
+            if (index < tracks.size()) {
+                return tracks[index];
+            }
+            return axis == 0 ? style.autoColumns : style.autoRows;
+        }
+
+        float gap(const GridStylesheet &style, int axis) { return axis == 0 ? style.columnGap : style.rowGap; }
+
+        float leadingPadding(const GridStylesheet &style, int axis)
+        {
+            return axis == 0 ? style.padding.left : style.padding.top;
+        }
+
+        float padding(const GridStylesheet &style, int axis)
+        {
+            return axis == 0 ? style.padding.left + style.padding.right : style.padding.top + style.padding.bottom;
+        }
+
+        std::optional<float> fixedSize(const GridStylesheet &style, int axis)
+        {
+            return axis == 0 ? style.width : style.height;
+        }
+
+        Align alignment(const GridStylesheet &container, const GridStylesheet &item, int axis)
+        {
+            return axis == 0 ? item.justifySelf.value_or(container.justifyItems)
+                             : item.alignSelf.value_or(container.alignItems);
+        }
+    }
+
+    void Layout::registerView(View *view)
+    {
+        auto &entry = _views[view];
+        entry.visible = view->visible.get();
+        entry.measurements.clear();
+
+        // Views whose parent is laid out by someone else are roots as well, their geometry is set by
+        // the parent's layout
+        auto parent = view->parentView->lock();
+        if (!parent || view->isLayoutRoot || _views.count(parent.get()) == 0) {
+            auto root = std::make_unique<Root>();
+            if (auto window = dynamic_cast<Window *>(view)) {
+                root->geometry.bind(window->contentGeometry);
+            } else {
+                root->geometry.bind(view->geometry);
+            }
+            root->geometry.onChange() += [view](auto &property) { view->scheduleLayout(); };
+            _roots[view] = std::move(root);
+        }
+
+        updateStylesheet(view);
+        invalidate(view);
+    }
+
+    void Layout::unregisterView(View *view)
+    {
+        auto it = _views.find(view);
+        if (it == _views.end()) {
+            return;
+        }
+
+        if (auto parent = view->parentView->lock()) {
+            invalidate(parent.get());
+        }
+        _roots.erase(view);
+        _views.erase(it);
+    }
+
+    void Layout::markDirty(View *view) { invalidate(view); }
+
+    void Layout::updateStylesheet(View *view)
+    {
+        auto it = _views.find(view);
+        if (it == _views.end()) {
+            return;
+        }
+
+        GridStylesheet style;
+        auto stylesheet = view->stylesheet.get();
+        if (auto grid = stylesheet.find("grid"); grid != stylesheet.end()) {
+            style = grid->get<GridStylesheet>();
+        }
+
+        auto &entry = it->second;
+        bool visible = view->visible.get();
+        if (style == entry.style && visible == entry.visible) {
+            return;
+        }
+
+        entry.style = std::move(style);
+        entry.visible = visible;
+
+        // A hidden view frees its cells, so the parent's grid changes as well
+        invalidate(view);
+        if (auto parent = view->parentView->lock()) {
+            invalidate(parent.get());
+        }
+    }
+
+    void Layout::invalidate(View *view)
+    {
+        std::shared_ptr<View> parent;
+        for (View *current = view; current != nullptr; current = parent.get()) {
+            auto it = _views.find(current);
+            if (it == _views.end()) {
+                return;
+            }
+
+            it->second.measurements.clear();
+            it->second.nextMeasurement = 0;
+
+            if (_roots.count(current) != 0) {
+                current->scheduleLayout();
+                current->invalidateSizeInParentLayout();
+                return;
+            }
+            parent = current->parentView->lock();
+        }
+    }
+
+    void Layout::layout(View *view)
+    {
+        auto it = _roots.find(view);
+        if (it == _roots.end()) {
+            return;
+        }
+
+        _lastStatistics = {};
+
+        auto geometry = it->second->geometry.get();
+        apply(view, _views.at(view).style, Size{geometry.width, geometry.height});
+    }
+
+    std::optional<Size> Layout::sizeForSpace(const View &view, Size availableSpace)
+    {
+        if (!isContainer(&view)) {
+            return std::nullopt;
+        }
+        return measure(&view, availableSpace);
+    }
+
+    bool Layout::isContainer(const View *view) const
+    {
+        bool result = false;
+        view->visitChildViews([&](View &child) {
+            if (!result) {
+                auto it = _views.find(&child);
+                result = it != _views.end() && it->second.visible;
+            }
+        });
+        return result;
+    }
+
+    Size Layout::measure(const View *view, Size availableSpace)
+    {
+        auto it = _views.find(view);
+        if (it == _views.end()) {
+            return view->sizeForSpace(availableSpace);
+        }
+
+        auto &entry = it->second;
+        for (const auto &measurement : entry.measurements) {
+            if (measurement.availableSpace == availableSpace) {
+                return measurement.size;
+            }
+        }
+
+        _lastStatistics.measuredCount++;
+
+        Size size = isContainer(view) ? solve(view, entry.style, availableSpace).size
+                                      : view->sizeForSpace(availableSpace);
+
+        if (entry.measurements.size() < maxMeasurements) {
+            entry.measurements.push_back(Measurement{availableSpace, size});
+        } else {
+            entry.measurements[entry.nextMeasurement] = Measurement{availableSpace, size};
+            entry.nextMeasurement = (entry.nextMeasurement + 1) % maxMeasurements;
+        }
+        return size;
+    }
+
+    Layout::Solution Layout::solve(const View *view, const GridStylesheet &style, Size availableSpace)
+    {
+        Solution solution;
+        solution.style = &style;
+
+        view->visitChildViews([&](View &child) {
+            auto it = _views.find(&child);
+            if (it == _views.end() || !it->second.visible) {
+                return;
+            }
+
+            const GridStylesheet &childStyle = it->second.style;
+            solution.items.push_back(Item{&child,
+                                          &childStyle,
+                                          {childStyle.column ? std::max(*childStyle.column - 1, 0) : -1,
+                                           childStyle.row ? std::max(*childStyle.row - 1, 0) : -1},
+                                          {std::max(childStyle.columnSpan, 1), std::max(childStyle.rowSpan, 1)},
+                                          {}});
+        });
+
+        placeItems(style, solution);
+
+        // Columns first, so that the items can be measured at their final width when sizing the rows
+        for (int axis = 0; axis < 2; axis++) {
+            double space = axis == 0 ? availableSpace.width : availableSpace.height;
+            if (std::isfinite(space)) {
+                space = std::max(space - padding(style, axis), 0.);
+            }
+            sizeTracks(style, solution, axis, space);
+        }
+
+        double extent[2];
+        for (int axis = 0; axis < 2; axis++) {
+            const auto &sizes = solution.sizes[axis];
+            extent[axis] = padding(style, axis);
+            for (double size : sizes) {
+                extent[axis] += size;
+            }
+            if (!sizes.empty()) {
+                extent[axis] += gap(style, axis) * static_cast<double>(sizes.size() - 1);
+            }
+        }
+        solution.size = Size{extent[0], extent[1]};
+
+        return solution;
+    }
+
+    void Layout::placeItems(const GridStylesheet &style, Solution &solution) const
+    {
+        // Auto placed items fill the lines of the major axis one after another, the number of tracks on
+        // the minor axis is fixed
+        const int minor = style.autoFlow == GridStylesheet::AutoFlow::Row ? 0 : 1;
+        const int major = 1 - minor;
+
+        int minorCount = std::max(static_cast<int>((minor == 0 ? style.columns : style.rows).size()), 1);
+        for (const auto &item : solution.items) {
+            minorCount = std::max(minorCount, std::max(item.start[minor], 0) + item.span[minor]);
+        }
+
+        std::vector<char> occupied;
+        auto isFree = [&](const Item &item, int majorStart, int minorStart) {
+            for (int m = majorStart; m < majorStart + item.span[major]; m++) {
+                for (int n = minorStart; n < minorStart + item.span[minor]; n++) {
+                    auto index = static_cast<size_t>(m * minorCount + n);
+                    if (index < occupied.size() && occupied[index] != 0) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+        auto occupy = [&](const Item &item) {
+            auto end = static_cast<size_t>((item.start[major] + item.span[major]) * minorCount);
+            if (occupied.size() < end) {
+                occupied.resize(end, 0);
+            }
+            for (int m = item.start[major]; m < item.start[major] + item.span[major]; m++) {
+                for (int n = item.start[minor]; n < item.start[minor] + item.span[minor]; n++) {
+                    occupied[static_cast<size_t>(m * minorCount + n)] = 1;
+                }
+            }
+        };
+
+        // Items locked to a line of the major axis are placed first
+        for (auto &item : solution.items) {
+            if (item.start[major] < 0) {
+                continue;
+            }
+            if (item.start[minor] < 0) {
+                item.start[minor] = 0;
+                for (int n = 0; n + item.span[minor] <= minorCount; n++) {
+                    if (isFree(item, item.start[major], n)) {
+                        item.start[minor] = n;
+                        break;
+                    }
+                }
+            }
+            occupy(item);
+        }
+
+        int cursorMajor = 0;
+        int cursorMinor = 0;
+        for (auto &item : solution.items) {
+            if (item.start[major] >= 0) {
+                continue;
+            }
+
+            if (item.start[minor] >= 0) {
+                if (item.start[minor] < cursorMinor) {
+                    cursorMajor++;
+                }
+                cursorMinor = item.start[minor];
+                while (!isFree(item, cursorMajor, cursorMinor)) {
+                    cursorMajor++;
+                }
+            } else {
+                while (cursorMinor + item.span[minor] > minorCount || !isFree(item, cursorMajor, cursorMinor)) {
+                    if (cursorMinor + item.span[minor] > minorCount) {
+                        cursorMajor++;
+                        cursorMinor = 0;
+                    } else {
+                        cursorMinor++;
+                    }
+                }
+            }
+
+            item.start[major] = cursorMajor;
+            item.start[minor] = cursorMinor;
+            occupy(item);
+            cursorMinor += item.span[minor];
+        }
+    }
+
+    void Layout::sizeTracks(const GridStylesheet &style, Solution &solution, int axis, double availableSpace)
+    {
+        size_t count = (axis == 0 ? style.columns : style.rows).size();
+        for (const auto &item : solution.items) {
+            count = std::max(count, static_cast<size_t>(item.start[axis] + item.span[axis]));
+        }
+
+        const bool definite = std::isfinite(availableSpace);
+        const double trackGap = gap(style, axis);
+
+        auto &sizes = solution.sizes[axis];
+        sizes.assign(count, 0.);
+
+        // Tracks that are sized by their items. Percentages and fractions of an undefined size behave
+        // like auto tracks.
+        std::vector<char> isAuto(count, 0);
+        double fractions = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            const Track &track = trackDefinition(style, axis, i);
+            switch (track.unit) {
+            case Track::Unit::Pixel:
+                sizes[i] = track.value;
+                break;
+            case Track::Unit::Percent:
+                if (definite) {
+                    sizes[i] = availableSpace * track.value / 100.;
+                } else {
+                    isAuto[i] = 1;
+                }
+                break;
+            case Track::Unit::Fraction:
+                if (definite) {
+                    fractions += track.value;
+                } else {
+                    isAuto[i] = 1;
+                }
+                break;
+            case Track::Unit::Auto:
+                isAuto[i] = 1;
+                break;
+            }
+        }
+
+        for (auto &item : solution.items) {
+            auto start = static_cast<size_t>(item.start[axis]);
+            if (item.span[axis] == 1 && isAuto[start] != 0) {
+                sizes[start] = std::max(sizes[start], itemContentSize(item, solution, axis));
+            }
+        }
+
+        // Spanning items only grow the auto tracks they cover, and only by what the tracks are missing
+        for (auto &item : solution.items) {
+            if (item.span[axis] == 1) {
+                continue;
+            }
+
+            auto start = static_cast<size_t>(item.start[axis]);
+            auto end = start + static_cast<size_t>(item.span[axis]);
+            double used = trackGap * (item.span[axis] - 1);
+            int autoCount = 0;
+            for (size_t i = start; i < end; i++) {
+                used += sizes[i];
+                autoCount += isAuto[i];
+            }
+            if (autoCount == 0) {
+                continue;
+            }
+
+            double missing = itemContentSize(item, solution, axis) - used;
+            if (missing > 0) {
+                for (size_t i = start; i < end; i++) {
+                    if (isAuto[i] != 0) {
+                        sizes[i] += missing / autoCount;
+                    }
+                }
+            }
+        }
+
+        if (fractions > 0) {
+            double freeSpace = availableSpace - trackGap * static_cast<double>(count - 1);
+            for (size_t i = 0; i < count; i++) {
+                freeSpace -= sizes[i];
+            }
+
+            // Fractions that add up to less than 1 leave part of the space empty
+            double perFraction = std::max(freeSpace, 0.) / std::max(fractions, 1.);
+            for (size_t i = 0; i < count; i++) {
+                const Track &track = trackDefinition(style, axis, i);
+                if (track.unit == Track::Unit::Fraction) {
+                    sizes[i] = track.value * perFraction;
+                }
+            }
+        }
+
+        auto &positions = solution.positions[axis];
+        positions.resize(count);
+        double position = leadingPadding(style, axis);
+        for (size_t i = 0; i < count; i++) {
+            positions[i] = position;
+            position += sizes[i] + trackGap;
+        }
+    }
+
+    double Layout::areaSize(const Item &item, const Solution &solution, int axis)
+    {
+        const auto &sizes = solution.sizes[axis];
+        double size = gap(*solution.style, axis) * (item.span[axis] - 1);
+        for (int i = item.start[axis]; i < item.start[axis] + item.span[axis]; i++) {
+            size += sizes[static_cast<size_t>(i)];
+        }
+        return size;
+    }
+
+    double Layout::itemContentSize(Item &item, Solution &solution, int axis)
+    {
+        if (item.contentSize[axis]) {
+            return *item.contentSize[axis];
+        }
+
+        double size = 0;
+        if (auto fixed = fixedSize(*item.style, axis)) {
+            size = *fixed;
+        } else if (axis == 0) {
+            size = measure(item.view, Size::none()).width;
+        } else {
+            size = measure(item.view, Size{itemSize(item, solution, 0), Size::componentNone()}).height;
+        }
+
+        item.contentSize[axis] = size;
+        return size;
+    }
+
+    double Layout::itemSize(Item &item, Solution &solution, int axis)
+    {
+        if (auto fixed = fixedSize(*item.style, axis)) {
+            return *fixed;
+        }
+
+        double area = areaSize(item, solution, axis);
+        if (alignment(*solution.style, *item.style, axis) == Align::Stretch) {
+            return area;
+        }
+        return std::min(itemContentSize(item, solution, axis), area);
+    }
+
+    void Layout::apply(View *view, const GridStylesheet &style, Size size)
+    {
+        auto solution = solve(view, style, size);
+
+        for (auto &item : solution.items) {
+            double frame[4];
+            for (int axis = 0; axis < 2; axis++) {
+                double extent = itemSize(item, solution, axis);
+                double area = areaSize(item, solution, axis);
+                double position = solution.positions[axis][static_cast<size_t>(item.start[axis])];
+
+                switch (alignment(style, *item.style, axis)) {
+                case Align::Center:
+                    position += (area - extent) / 2;
+                    break;
+                case Align::End:
+                    position += area - extent;
+                    break;
+                case Align::Stretch:
+                case Align::Start:
+                    break;
+                }
+
+                frame[axis] = position;
+                frame[axis + 2] = extent;
+            }
+
+            Rect geometry{frame[0], frame[1], frame[2], frame[3]};
+            if (item.view->geometry.get() != geometry) {
+                item.view->geometry = geometry;
+                _lastStatistics.changedCount++;
+            }
+
+            if (isContainer(item.view)) {
+                apply(item.view, _views.at(item.view).style, Size{geometry.width, geometry.height});
+            }
+        }
+    }
+}
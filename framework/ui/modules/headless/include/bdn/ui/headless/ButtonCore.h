@@ -0,0 +1,26 @@
+#pragma once
+
+#include <bdn/ui/Button.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class ButtonCore : public ViewCore, virtual public Button::Core
+    {
+      public:
+        static constexpr double horizontalPadding = 12.;
+        static constexpr double verticalPadding = 6.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        /** Simulates a click on the button.*/
+        void click() { _clickCallback.fire(); }
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <bdn/ui/Checkbox.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class CheckboxCore : public ViewCore, virtual public Checkbox::Core
+    {
+      public:
+        static constexpr double boxSize = 16.;
+        static constexpr double spacing = 4.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        /** Simulates a click: toggles the state and notifies the view.*/
+        void click();
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
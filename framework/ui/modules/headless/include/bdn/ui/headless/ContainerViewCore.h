@@ -0,0 +1,23 @@
+#pragma once
+
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class ContainerViewCore : public ViewCore, virtual public ContainerView::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void addChildView(std::shared_ptr<View> child) override;
+        void insertChildView(std::shared_ptr<View> child, size_t index) override;
+        void removeChildView(std::shared_ptr<View> child) override;
+
+        std::vector<std::shared_ptr<View>> childViews() const override;
+
+      private:
+        std::vector<std::shared_ptr<View>> _children;
+    };
+}
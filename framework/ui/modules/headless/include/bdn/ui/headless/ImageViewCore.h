@@ -0,0 +1,22 @@
+#pragma once
+
+#include <bdn/ui/ImageView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    /** Headless cores do not load images. Use setImageSize() to simulate a loaded image.*/
+    class ImageViewCore : public ViewCore, virtual public ImageView::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        void setImageSize(Size size);
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
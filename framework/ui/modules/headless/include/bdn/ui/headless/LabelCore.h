@@ -0,0 +1,24 @@
+#pragma once
+
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class LabelCore : public ViewCore, virtual public Label::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        float baseline(Size forSize) const override;
+
+        /** Simulates a click on a link in the label.*/
+        void clickLink(const std::string &link) { _linkClickCallback.fire(link); }
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
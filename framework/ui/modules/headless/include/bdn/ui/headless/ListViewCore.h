@@ -0,0 +1,55 @@
+#pragma once
+
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/ListView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+#include <map>
+
+namespace bdn::ui::headless
+{
+    /** Creates row views only for the rows that intersect the visible area, like the native list
+        views do, and reuses row views that scroll out of it.*/
+    class ListViewCore : public ViewCore, virtual public ListView::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        std::optional<size_t> rowIndexForView(const std::shared_ptr<View> &view) const override;
+
+        void reloadData() override;
+        void refreshDone() override { _refreshing = false; }
+
+        /** Simulates the user scrolling the list so that offset is the top of the visible area.*/
+        void scrollTo(double offset);
+
+        /** Simulates pull to refresh.*/
+        void refresh();
+
+        /** Simulates swipe to delete on a row.*/
+        void deleteRow(size_t rowIndex);
+
+        bool isRefreshing() const { return _refreshing; }
+
+        /** The row views that currently exist, by row index.*/
+        std::map<size_t, std::shared_ptr<View>> visibleRowViews() const;
+
+      private:
+        struct Row
+        {
+            std::shared_ptr<ContainerView> container;
+            std::shared_ptr<View> view;
+        };
+
+        void updateRows(bool reload);
+
+      private:
+        std::map<size_t, Row> _rows;
+        std::vector<Row> _reusableRows;
+        double _scrollOffset = 0;
+        bool _refreshing = false;
+    };
+}
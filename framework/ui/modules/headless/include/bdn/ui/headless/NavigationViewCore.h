@@ -0,0 +1,45 @@
+#pragma once
+
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/NavigationView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class NavigationViewCore : public ViewCore, virtual public NavigationView::Core
+    {
+      public:
+        static constexpr double navigationBarHeight = 44.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        void pushView(std::shared_ptr<View> view, std::string title) override;
+        void popView() override;
+
+        std::vector<std::shared_ptr<View>> childViews() const override;
+
+        void setLayout(std::shared_ptr<Layout> layout) override;
+
+        std::string currentTitle() const;
+        size_t stackSize() const { return _stack.size(); }
+
+      private:
+        struct StackEntry
+        {
+            std::shared_ptr<View> view;
+            std::string title;
+        };
+
+        void updateCurrentView();
+        void reLayout();
+
+      private:
+        std::vector<StackEntry> _stack;
+        std::shared_ptr<ContainerView> _container;
+        std::shared_ptr<View> _currentView;
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <bdn/ui/ScrollView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class ScrollViewCore : public ViewCore, virtual public ScrollView::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+        ~ScrollViewCore() override;
+
+      public:
+        void init() override;
+
+        void scrollClientRectToVisible(const Rect &clientRect) override;
+
+        /** Simulates the user scrolling the top left corner of the visible area to position.*/
+        void scrollTo(Point position);
+
+      private:
+        Size contentSize() const;
+        void updateContent(const std::shared_ptr<View> &content);
+        void updateVisibleClientRect();
+
+      private:
+        Point _scrollPosition;
+        std::weak_ptr<View> _content;
+        Backing<Rect>::notifier_subscription_t _contentGeometrySubscription;
+    };
+}
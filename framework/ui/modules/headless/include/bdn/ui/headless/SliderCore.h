@@ -0,0 +1,20 @@
+#pragma once
+
+#include <bdn/ui/Slider.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class SliderCore : public ViewCore, virtual public Slider::Core
+    {
+      public:
+        static constexpr double preferredWidth = 100.;
+        static constexpr double preferredHeight = 20.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <bdn/ui/Switch.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class SwitchCore : public ViewCore, virtual public Switch::Core
+    {
+      public:
+        static constexpr double switchWidth = 40.;
+        static constexpr double switchHeight = 20.;
+        static constexpr double spacing = 4.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        /** Simulates a click: toggles the switch and notifies the view.*/
+        void click();
+
+      protected:
+        Size measure(Size availableSpace) const override;
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <bdn/ui/TextField.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class TextFieldCore : public ViewCore, virtual public TextField::Core
+    {
+      public:
+        static constexpr double padding = 4.;
+        static constexpr double minimumWidth = 100.;
+
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+        void focus() override { _focused = true; }
+        bool isFocused() const { return _focused; }
+
+        /** Simulates the user pressing the return key.*/
+        void submit() { submitCallback.fire(); }
+
+      protected:
+        Size measure(Size availableSpace) const override;
+
+      private:
+        bool _focused = false;
+    };
+}
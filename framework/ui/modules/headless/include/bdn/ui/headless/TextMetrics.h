@@ -0,0 +1,49 @@
+#pragma once
+
+#include <bdn/Size.h>
+
+#include <memory>
+#include <string>
+
+namespace bdn::ui::headless
+{
+    /** Measures text for headless view cores.
+
+        Implementations must be deterministic: the same text and constraints always produce the
+        same size.*/
+    class TextMetrics
+    {
+      public:
+        virtual ~TextMetrics() = default;
+
+        /** Returns the size of text when laid out into availableSpace. If wrap is false the text is
+            laid out in a single line (explicit line breaks still start new lines).*/
+        virtual Size measure(const std::string &text, Size availableSpace, bool wrap) const = 0;
+
+        /** Distance from the top of the text to the baseline of its first line.*/
+        virtual double baseline() const = 0;
+
+      public:
+        /** The metrics used by cores whose factory does not provide its own.*/
+        static std::shared_ptr<TextMetrics> &defaultMetrics();
+    };
+
+    /** Monospaced metrics: every code point advances by the same width and every line has the
+        same height. Wrapping breaks at any character.*/
+    class FixedTextMetrics : public TextMetrics
+    {
+      public:
+        FixedTextMetrics(double advance = 8., double lineHeight = 16., double baselineOffset = 12.);
+
+        Size measure(const std::string &text, Size availableSpace, bool wrap) const override;
+        double baseline() const override { return _baseline; }
+
+        double advance() const { return _advance; }
+        double lineHeight() const { return _lineHeight; }
+
+      private:
+        double _advance;
+        double _lineHeight;
+        double _baseline;
+    };
+}
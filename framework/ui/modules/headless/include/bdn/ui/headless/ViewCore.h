@@ -0,0 +1,67 @@
+#pragma once
+
+#include <bdn/ui/View.h>
+#include <bdn/ui/headless/TextMetrics.h>
+
+#include <atomic>
+#include <memory>
+
+namespace bdn::ui::headless
+{
+    /** Base class of all headless view cores.
+
+        Headless cores keep their state in memory only. scheduleLayout() queues the core, queued
+        layouts run either on the next iteration of the application's dispatch queue or when
+        performPendingLayouts() is called. Cores may be scheduled from any thread, the layouts
+        themselves run on the thread that calls performPendingLayouts(), usually the main thread.*/
+    class ViewCore : public std::enable_shared_from_this<ViewCore>, public bdn::ui::View::Core
+    {
+      public:
+        struct Statistics
+        {
+            size_t measureCount = 0;
+            size_t layoutCount = 0;
+        };
+
+      public:
+        ViewCore() = delete;
+        ViewCore(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory);
+
+      public:
+        void init() override {}
+
+        template <class T> std::shared_ptr<T> shared_from_this()
+        {
+            return std::dynamic_pointer_cast<T>(std::enable_shared_from_this<ViewCore>::shared_from_this());
+        }
+
+      public:
+        Size sizeForSpace(Size availableSpace = Size::none()) const final;
+        float baseline(Size forSize) const override;
+        float pointScaleFactor() const override;
+
+        void scheduleLayout() override;
+        bool isLayoutScheduled() const { return _layoutScheduled.load(); }
+
+        std::shared_ptr<TextMetrics> textMetrics() const;
+
+      public:
+        /** Runs all queued layouts, including the ones that are queued while doing so.*/
+        static void performPendingLayouts();
+
+        /** If true (the default), queued layouts are run asynchronously on the application's
+            dispatch queue. Otherwise they only run in performPendingLayouts().*/
+        static std::atomic<bool> &dispatchLayouts();
+
+        /** Counters of all headless cores on all threads since the last reset.*/
+        static Statistics statistics();
+        static void resetStatistics();
+
+      protected:
+        /** Returns the natural size of the core's content for the given space.*/
+        virtual Size measure(Size availableSpace) const { return Size{0, 0}; }
+
+      private:
+        std::atomic<bool> _layoutScheduled{false};
+    };
+}
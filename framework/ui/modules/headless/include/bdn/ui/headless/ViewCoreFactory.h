@@ -0,0 +1,32 @@
+#pragma once
+
+#include <bdn/ui/ViewCoreFactory.h>
+#include <bdn/ui/headless/TextMetrics.h>
+
+namespace bdn::ui::headless
+{
+    /** Registers the headless core of every bdn::ui view type with the factory.
+
+        Registrations that the factory already has are kept.*/
+    void registerCoreTypes(bdn::ui::ViewCoreFactory &factory);
+
+    /** A ViewCoreFactory that creates headless cores for all view types.
+
+        Because it registers its cores on construction, they take precedence over the cores that a
+        native platform registers later on. Push it onto UIApplicationController::ViewCoreFactoryStack
+        to build views without a native backend.*/
+    class ViewCoreFactory : public bdn::ui::ViewCoreFactory
+    {
+      public:
+        ViewCoreFactory(std::shared_ptr<TextMetrics> textMetrics = nullptr, float pointScaleFactor = 1.0f);
+
+        std::shared_ptr<TextMetrics> textMetrics() const { return _textMetrics; }
+        void setTextMetrics(std::shared_ptr<TextMetrics> textMetrics) { _textMetrics = std::move(textMetrics); }
+
+        float pointScaleFactor() const { return _pointScaleFactor; }
+
+      private:
+        std::shared_ptr<TextMetrics> _textMetrics;
+        float _pointScaleFactor;
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <bdn/ui/WebView.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    /** Records the loaded URL without loading anything.*/
+    class WebViewCore : public ViewCore, virtual public WebView::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void loadURL(const std::string &url) override { _url = url; }
+        const std::string &currentURL() const { return _url; }
+
+      private:
+        std::string _url;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <bdn/ui/Window.h>
+#include <bdn/ui/headless/ViewCore.h>
+
+namespace bdn::ui::headless
+{
+    class WindowCore : public ViewCore, virtual public Window::Core
+    {
+      public:
+        using ViewCore::ViewCore;
+
+      public:
+        void init() override;
+
+      private:
+        void updateContentGeometry();
+    };
+}
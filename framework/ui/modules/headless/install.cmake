@@ -0,0 +1,27 @@
+
+set(ComponentName Library)
+
+install(TARGETS headless
+    EXPORT headless-export
+    LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR}
+    ARCHIVE DESTINATION ${CMAKE_INSTALL_LIBDIR}
+    COMPONENT
+      ${ComponentName})
+
+install(DIRECTORY include/
+    DESTINATION
+        ${CMAKE_INSTALL_INCLUDEDIR}
+    COMPONENT
+      ${ComponentName}
+    FILES_MATCHING PATTERN
+        "*.h")
+
+install(EXPORT headless-export
+    FILE
+        headlessTargets.cmake
+    NAMESPACE
+        Boden::
+    DESTINATION
+        ${bodenConfigPackageLocation}
+    COMPONENT
+      ${ComponentName})
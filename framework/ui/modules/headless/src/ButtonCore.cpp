@@ -0,0 +1,32 @@
+#include <bdn/ui/headless/ButtonCore.h>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Button, bdn::ui::headless::ButtonCore, Button)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void ButtonCore::init()
+    {
+        ViewCore::init();
+
+        label.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+
+        imageURL.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+    }
+
+    Size ButtonCore::measure(Size availableSpace) const
+    {
+        Size textSize = textMetrics()->measure(static_cast<std::string>(label.get()), Size::none(), false);
+        return textSize + Size{2 * horizontalPadding, 2 * verticalPadding};
+    }
+}
@@ -0,0 +1,39 @@
+#include <bdn/ui/headless/CheckboxCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Checkbox, bdn::ui::headless::CheckboxCore, Checkbox)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void CheckboxCore::init()
+    {
+        ViewCore::init();
+
+        label.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+    }
+
+    void CheckboxCore::click()
+    {
+        state = (state.get() == TriState::On) ? TriState::Off : TriState::On;
+        _clickCallback.fire();
+    }
+
+    Size CheckboxCore::measure(Size availableSpace) const
+    {
+        if (label->empty()) {
+            return Size{boxSize, boxSize};
+        }
+
+        Size textSize = textMetrics()->measure(label.get(), Size::none(), false);
+        return Size{boxSize + spacing + textSize.width, std::max(boxSize, textSize.height)};
+    }
+}
@@ -0,0 +1,41 @@
+#include <bdn/ui/headless/ContainerViewCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(ContainerView, bdn::ui::headless::ContainerViewCore, ContainerView)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void ContainerViewCore::addChildView(std::shared_ptr<View> child)
+    {
+        // Like a native container, attaching a child requires its core
+        child->viewCore();
+        _children.push_back(std::move(child));
+        scheduleLayout();
+    }
+
+    void ContainerViewCore::insertChildView(std::shared_ptr<View> child, size_t index)
+    {
+        child->viewCore();
+        auto position = static_cast<std::ptrdiff_t>(std::min(index, _children.size()));
+        _children.insert(_children.begin() + position, std::move(child));
+        scheduleLayout();
+    }
+
+    void ContainerViewCore::removeChildView(std::shared_ptr<View> child)
+    {
+        auto it = std::remove(_children.begin(), _children.end(), child);
+
+        if (it != _children.end()) {
+            _children.erase(it, _children.end());
+            scheduleLayout();
+        }
+    }
+
+    std::vector<std::shared_ptr<View>> ContainerViewCore::childViews() const { return _children; }
+}
@@ -0,0 +1,53 @@
+#include <bdn/ui/headless/ImageViewCore.h>
+
+#include <cmath>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(ImageView, bdn::ui::headless::ImageViewCore, ImageView)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void ImageViewCore::init()
+    {
+        ViewCore::init();
+
+        url.onChange() += [=](auto &) { setImageSize(Size{0, 0}); };
+    }
+
+    void ImageViewCore::setImageSize(Size size)
+    {
+        originalSize = size;
+        aspectRatio = (size.width > 0 && size.height > 0) ? static_cast<float>(size.width / size.height) : 1.0f;
+
+        markDirty();
+        scheduleLayout();
+    }
+
+    Size ImageViewCore::measure(Size availableSpace) const
+    {
+        Size imageSize = originalSize.get();
+
+        if (imageSize.width <= 0 || imageSize.height <= 0) {
+            return Size{0, 0};
+        }
+
+        bool widthConstrained = std::isfinite(availableSpace.width);
+        bool heightConstrained = std::isfinite(availableSpace.height);
+
+        if (!widthConstrained && !heightConstrained) {
+            return imageSize;
+        }
+
+        double ratio = imageSize.width / imageSize.height;
+
+        if (widthConstrained && (!heightConstrained || availableSpace.width / ratio <= availableSpace.height)) {
+            return Size{availableSpace.width, availableSpace.width / ratio};
+        }
+
+        return Size{availableSpace.height * ratio, availableSpace.height};
+    }
+}
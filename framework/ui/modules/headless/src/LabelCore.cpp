@@ -0,0 +1,39 @@
+#include <bdn/ui/headless/LabelCore.h>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Label, bdn::ui::headless::LabelCore, Label)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void LabelCore::init()
+    {
+        ViewCore::init();
+
+        text.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+
+        wrap.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+    }
+
+    Size LabelCore::measure(Size availableSpace) const
+    {
+        return textMetrics()->measure(static_cast<std::string>(text.get()), availableSpace, wrap.get());
+    }
+
+    float LabelCore::baseline(Size forSize) const
+    {
+        if (text->empty()) {
+            return static_cast<float>(forSize.height);
+        }
+        return static_cast<float>(textMetrics()->baseline());
+    }
+}
@@ -0,0 +1,139 @@
+#include <bdn/ui/headless/ListViewCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(ListView, bdn::ui::headless::ListViewCore, ListView)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void ListViewCore::init()
+    {
+        ViewCore::init();
+
+        dataSource.onChange() += [=](auto &) { reloadData(); };
+        listView.onChange() += [=](auto &) { reloadData(); };
+        geometry.onChange() += [=](auto &) { updateRows(false); };
+
+        enableRefresh.onChange() += [=](auto &property) {
+            if (!property.get()) {
+                _refreshing = false;
+            }
+        };
+    }
+
+    std::optional<size_t> ListViewCore::rowIndexForView(const std::shared_ptr<View> &view) const
+    {
+        for (const auto &[index, row] : _rows) {
+            if (row.view == view || row.container == view) {
+                return index;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void ListViewCore::reloadData() { updateRows(true); }
+
+    void ListViewCore::scrollTo(double offset)
+    {
+        _scrollOffset = std::max(0., offset);
+        updateRows(false);
+    }
+
+    void ListViewCore::refresh()
+    {
+        if (enableRefresh.get() && !_refreshing) {
+            _refreshing = true;
+            _refreshCallback.fire();
+        }
+    }
+
+    void ListViewCore::deleteRow(size_t rowIndex)
+    {
+        if (enableSwipeToDelete.get()) {
+            _deleteCallback.fire(rowIndex);
+        }
+    }
+
+    std::map<size_t, std::shared_ptr<View>> ListViewCore::visibleRowViews() const
+    {
+        std::map<size_t, std::shared_ptr<View>> result;
+        for (const auto &[index, row] : _rows) {
+            result[index] = row.view;
+        }
+        return result;
+    }
+
+    void ListViewCore::updateRows(bool reload)
+    {
+        auto list = listView->lock();
+        auto source = dataSource.get();
+
+        if (reload || !list || !source) {
+            for (auto &[index, row] : _rows) {
+                _reusableRows.push_back(std::move(row));
+            }
+            _rows.clear();
+        }
+
+        if (!list || !source) {
+            return;
+        }
+
+        Rect bounds = geometry.get();
+        size_t numberOfRows = source->numberOfRows(list);
+
+        // Find the rows that intersect the visible area
+        std::map<size_t, Rect> visibleRows;
+        double top = 0;
+        for (size_t i = 0; i < numberOfRows && top < _scrollOffset + bounds.height; i++) {
+            double height = source->heightForRowIndex(list, i);
+            if (top + height > _scrollOffset) {
+                visibleRows[i] = Rect{0, top - _scrollOffset, bounds.width, height};
+            }
+            top += height;
+        }
+
+        for (auto it = _rows.begin(); it != _rows.end();) {
+            if (visibleRows.count(it->first) == 0) {
+                _reusableRows.push_back(std::move(it->second));
+                it = _rows.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (const auto &[index, rowGeometry] : visibleRows) {
+            auto it = _rows.find(index);
+
+            if (it == _rows.end()) {
+                Row row;
+                if (!_reusableRows.empty()) {
+                    row = std::move(_reusableRows.back());
+                    _reusableRows.pop_back();
+                } else {
+                    row.container = std::make_shared<ContainerView>(viewCoreFactory());
+                    row.container->isLayoutRoot = true;
+                    row.container->setFallbackLayout(layout());
+                    row.container->viewCore();
+                }
+
+                row.view = source->viewForRowIndex(list, index, row.view);
+
+                row.container->removeAllChildViews();
+                if (row.view) {
+                    row.container->addChildView(row.view);
+                }
+
+                it = _rows.emplace(index, std::move(row)).first;
+            }
+
+            it->second.container->geometry = rowGeometry;
+        }
+    }
+}
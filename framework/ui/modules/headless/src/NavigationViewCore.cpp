@@ -0,0 +1,96 @@
+#include <bdn/ui/headless/NavigationViewCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(NavigationView, bdn::ui::headless::NavigationViewCore, NavigationView)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void NavigationViewCore::init()
+    {
+        ViewCore::init();
+
+        geometry.onChange() += [=](auto &) { reLayout(); };
+    }
+
+    void NavigationViewCore::pushView(std::shared_ptr<View> view, std::string title)
+    {
+        _stack.push_back({std::move(view), std::move(title)});
+        updateCurrentView();
+    }
+
+    void NavigationViewCore::popView()
+    {
+        if (_stack.empty()) {
+            return;
+        }
+
+        _stack.pop_back();
+        updateCurrentView();
+    }
+
+    std::vector<std::shared_ptr<View>> NavigationViewCore::childViews() const
+    {
+        if (_container) {
+            return {_container};
+        }
+        return {};
+    }
+
+    void NavigationViewCore::setLayout(std::shared_ptr<Layout> layout)
+    {
+        if (_container) {
+            _container->setFallbackLayout(layout);
+        }
+        ViewCore::setLayout(std::move(layout));
+    }
+
+    std::string NavigationViewCore::currentTitle() const
+    {
+        if (_stack.empty()) {
+            return "";
+        }
+        return _stack.back().title;
+    }
+
+    void NavigationViewCore::updateCurrentView()
+    {
+        if (!_container) {
+            _container = std::make_shared<ContainerView>(viewCoreFactory());
+            _container->isLayoutRoot = true;
+            _container->setFallbackLayout(layout());
+            _container->viewCore();
+        }
+
+        _container->removeAllChildViews();
+
+        auto oldCurrentView = _currentView;
+        _currentView = nullptr;
+
+        if (!_stack.empty()) {
+            _currentView = _stack.back().view;
+            _container->addChildView(_currentView);
+            _currentView->visible = true;
+        }
+
+        if (oldCurrentView && oldCurrentView != _currentView) {
+            oldCurrentView->visible = false;
+        }
+
+        reLayout();
+    }
+
+    void NavigationViewCore::reLayout()
+    {
+        if (_container) {
+            Rect r = geometry.get();
+            _container->geometry =
+                Rect{0, navigationBarHeight, r.width, std::max(0., r.height - navigationBarHeight)};
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <bdn/ui/headless/ScrollViewCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(ScrollView, bdn::ui::headless::ScrollViewCore, ScrollView)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    ScrollViewCore::~ScrollViewCore()
+    {
+        if (auto content = _content.lock()) {
+            content->geometry.onChange().unsubscribe(_contentGeometrySubscription);
+        }
+    }
+
+    void ScrollViewCore::init()
+    {
+        ViewCore::init();
+
+        contentView.onChange() += [=](auto &property) { updateContent(property.get()); };
+        geometry.onChange() += [=](auto &) { scrollTo(_scrollPosition); };
+        horizontalScrollingEnabled.onChange() += [=](auto &) { scrollTo(_scrollPosition); };
+        verticalScrollingEnabled.onChange() += [=](auto &) { scrollTo(_scrollPosition); };
+    }
+
+    void ScrollViewCore::updateContent(const std::shared_ptr<View> &content)
+    {
+        if (auto oldContent = _content.lock()) {
+            oldContent->geometry.onChange().unsubscribe(_contentGeometrySubscription);
+        }
+
+        _content = content;
+
+        if (content) {
+            content->viewCore();
+            _contentGeometrySubscription =
+                content->geometry.onChange().subscribe([=](auto &) { scrollTo(_scrollPosition); });
+        }
+
+        scrollTo(Point{0, 0});
+        scheduleLayout();
+    }
+
+    Size ScrollViewCore::contentSize() const
+    {
+        if (auto content = _content.lock()) {
+            return content->geometry->size();
+        }
+        return Size{0, 0};
+    }
+
+    void ScrollViewCore::scrollClientRectToVisible(const Rect &clientRect)
+    {
+        Rect visible = visibleClientRect.get();
+        Point target = visible.position();
+
+        // Scroll the minimal distance, preferring the top left corner if the rect does not fit
+        if (clientRect.x + clientRect.width > visible.x + visible.width) {
+            target.x = clientRect.x + clientRect.width - visible.width;
+        }
+        if (clientRect.x < target.x) {
+            target.x = clientRect.x;
+        }
+        if (clientRect.y + clientRect.height > visible.y + visible.height) {
+            target.y = clientRect.y + clientRect.height - visible.height;
+        }
+        if (clientRect.y < target.y) {
+            target.y = clientRect.y;
+        }
+
+        scrollTo(target);
+    }
+
+    void ScrollViewCore::scrollTo(Point position)
+    {
+        Size viewportSize = geometry->size();
+        Size maxPosition = contentSize() - viewportSize;
+
+        _scrollPosition.x =
+            horizontalScrollingEnabled.get() ? std::clamp(position.x, 0., std::max(0., maxPosition.width)) : 0.;
+        _scrollPosition.y =
+            verticalScrollingEnabled.get() ? std::clamp(position.y, 0., std::max(0., maxPosition.height)) : 0.;
+
+        updateVisibleClientRect();
+    }
+
+    void ScrollViewCore::updateVisibleClientRect() { visibleClientRect = Rect{_scrollPosition, geometry->size()}; }
+}
@@ -0,0 +1,13 @@
+#include <bdn/ui/headless/SliderCore.h>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Slider, bdn::ui::headless::SliderCore, Slider)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    Size SliderCore::measure(Size availableSpace) const { return Size{preferredWidth, preferredHeight}; }
+}
@@ -0,0 +1,39 @@
+#include <bdn/ui/headless/SwitchCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Switch, bdn::ui::headless::SwitchCore, Switch)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void SwitchCore::init()
+    {
+        ViewCore::init();
+
+        label.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+    }
+
+    void SwitchCore::click()
+    {
+        on = !on.get();
+        _clickCallback.fire();
+    }
+
+    Size SwitchCore::measure(Size availableSpace) const
+    {
+        if (label->empty()) {
+            return Size{switchWidth, switchHeight};
+        }
+
+        Size textSize = textMetrics()->measure(label.get(), Size::none(), false);
+        return Size{textSize.width + spacing + switchWidth, std::max(switchHeight, textSize.height)};
+    }
+}
@@ -0,0 +1,42 @@
+#include <bdn/ui/headless/TextFieldCore.h>
+
+#include <algorithm>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(TextField, bdn::ui::headless::TextFieldCore, TextField)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void TextFieldCore::init()
+    {
+        ViewCore::init();
+
+        text.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+
+        placeholder.onChange() += [=](auto &) {
+            markDirty();
+            scheduleLayout();
+        };
+    }
+
+    Size TextFieldCore::measure(Size availableSpace) const
+    {
+        auto metrics = textMetrics();
+
+        std::string content = text->empty() ? static_cast<std::string>(placeholder.get()) : text.get();
+        Size textSize = metrics->measure(content, Size::none(), false);
+
+        // An empty field still has the height of one line
+        double lineHeight = metrics->measure("M", Size::none(), false).height;
+
+        return Size{std::max(minimumWidth, textSize.width + 2 * padding),
+                    std::max(lineHeight, textSize.height) + 2 * padding};
+    }
+}
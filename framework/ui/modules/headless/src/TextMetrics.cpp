@@ -0,0 +1,56 @@
+#include <bdn/ui/headless/TextMetrics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace bdn::ui::headless
+{
+    std::shared_ptr<TextMetrics> &TextMetrics::defaultMetrics()
+    {
+        static std::shared_ptr<TextMetrics> s_defaultMetrics = std::make_shared<FixedTextMetrics>();
+        return s_defaultMetrics;
+    }
+
+    FixedTextMetrics::FixedTextMetrics(double advance, double lineHeight, double baselineOffset)
+        : _advance(advance), _lineHeight(lineHeight), _baseline(baselineOffset)
+    {}
+
+    Size FixedTextMetrics::measure(const std::string &text, Size availableSpace, bool wrap) const
+    {
+        if (text.empty()) {
+            return Size{0, 0};
+        }
+
+        size_t charactersPerLine = 0;
+        if (wrap && std::isfinite(availableSpace.width)) {
+            charactersPerLine = std::max<size_t>(1, static_cast<size_t>(std::floor(availableSpace.width / _advance)));
+        }
+
+        size_t longestLine = 0;
+        size_t numLines = 0;
+
+        auto endLine = [&](size_t length) {
+            if (charactersPerLine != 0 && length > charactersPerLine) {
+                numLines += (length + charactersPerLine - 1) / charactersPerLine;
+                longestLine = std::max(longestLine, charactersPerLine);
+            } else {
+                numLines++;
+                longestLine = std::max(longestLine, length);
+            }
+        };
+
+        size_t lineLength = 0;
+        for (unsigned char c : text) {
+            if (c == '\n') {
+                endLine(lineLength);
+                lineLength = 0;
+            } else if (c != '\r' && (c & 0xC0) != 0x80) {
+                // Count code points, not UTF-8 continuation bytes
+                lineLength++;
+            }
+        }
+        endLine(lineLength);
+
+        return Size{static_cast<double>(longestLine) * _advance, static_cast<double>(numLines) * _lineHeight};
+    }
+}
@@ -0,0 +1,116 @@
+#include <bdn/ui/headless/ViewCore.h>
+#include <bdn/ui/headless/ViewCoreFactory.h>
+
+#include <bdn/Application.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace bdn::ui::headless
+{
+    namespace
+    {
+        std::atomic<size_t> s_measureCount{0};
+        std::atomic<size_t> s_layoutCount{0};
+
+        std::mutex s_pendingLayoutsMutex;
+        std::deque<std::weak_ptr<ViewCore>> s_pendingLayouts;
+    }
+
+    ViewCore::ViewCore(const std::shared_ptr<bdn::ui::ViewCoreFactory> &viewCoreFactory)
+        : bdn::ui::View::Core(viewCoreFactory)
+    {}
+
+    Size ViewCore::sizeForSpace(Size availableSpace) const
+    {
+        s_measureCount++;
+        return measure(availableSpace);
+    }
+
+    float ViewCore::baseline(Size forSize) const { return static_cast<float>(forSize.height); }
+
+    float ViewCore::pointScaleFactor() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto factory = const_cast<ViewCore *>(this)->viewCoreFactory();
+        if (auto headlessFactory = std::dynamic_pointer_cast<headless::ViewCoreFactory>(factory)) {
+            return headlessFactory->pointScaleFactor();
+        }
+        return 1.0f;
+    }
+
+    std::shared_ptr<TextMetrics> ViewCore::textMetrics() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto factory = const_cast<ViewCore *>(this)->viewCoreFactory();
+        if (auto headlessFactory = std::dynamic_pointer_cast<headless::ViewCoreFactory>(factory)) {
+            if (auto metrics = headlessFactory->textMetrics()) {
+                return metrics;
+            }
+        }
+        return TextMetrics::defaultMetrics();
+    }
+
+    void ViewCore::scheduleLayout()
+    {
+        if (_layoutScheduled.exchange(true)) {
+            return;
+        }
+
+        bool wasEmpty = false;
+        {
+            std::lock_guard<std::mutex> lock(s_pendingLayoutsMutex);
+            wasEmpty = s_pendingLayouts.empty();
+            s_pendingLayouts.push_back(shared_from_this<ViewCore>());
+        }
+
+        if (wasEmpty && dispatchLayouts()) {
+            if (auto app = App()) {
+                app->dispatchQueue()->dispatchAsync([]() { performPendingLayouts(); });
+            }
+        }
+    }
+
+    void ViewCore::performPendingLayouts()
+    {
+        while (true) {
+            std::deque<std::weak_ptr<ViewCore>> pending;
+            {
+                std::lock_guard<std::mutex> lock(s_pendingLayoutsMutex);
+                if (s_pendingLayouts.empty()) {
+                    return;
+                }
+                pending.swap(s_pendingLayouts);
+            }
+
+            for (auto &weakCore : pending) {
+                if (auto core = weakCore.lock()) {
+                    core->_layoutScheduled = false;
+                    s_layoutCount++;
+                    core->startLayout();
+                }
+            }
+        }
+    }
+
+    std::atomic<bool> &ViewCore::dispatchLayouts()
+    {
+        static std::atomic<bool> s_dispatchLayouts{true};
+        return s_dispatchLayouts;
+    }
+
+    ViewCore::Statistics ViewCore::statistics()
+    {
+        Statistics result;
+        result.measureCount = s_measureCount.load();
+        result.layoutCount = s_layoutCount.load();
+        return result;
+    }
+
+    void ViewCore::resetStatistics()
+    {
+        s_measureCount = 0;
+        s_layoutCount = 0;
+    }
+}
@@ -0,0 +1,40 @@
+#include <bdn/ui/headless/ButtonCore.h>
+#include <bdn/ui/headless/CheckboxCore.h>
+#include <bdn/ui/headless/ContainerViewCore.h>
+#include <bdn/ui/headless/ImageViewCore.h>
+#include <bdn/ui/headless/LabelCore.h>
+#include <bdn/ui/headless/ListViewCore.h>
+#include <bdn/ui/headless/NavigationViewCore.h>
+#include <bdn/ui/headless/ScrollViewCore.h>
+#include <bdn/ui/headless/SliderCore.h>
+#include <bdn/ui/headless/SwitchCore.h>
+#include <bdn/ui/headless/TextFieldCore.h>
+#include <bdn/ui/headless/ViewCoreFactory.h>
+#include <bdn/ui/headless/WebViewCore.h>
+#include <bdn/ui/headless/WindowCore.h>
+
+namespace bdn::ui::headless
+{
+    void registerCoreTypes(bdn::ui::ViewCoreFactory &factory)
+    {
+        factory.registerCoreType<ButtonCore, Button>();
+        factory.registerCoreType<CheckboxCore, Checkbox>();
+        factory.registerCoreType<ContainerViewCore, ContainerView>();
+        factory.registerCoreType<ImageViewCore, ImageView>();
+        factory.registerCoreType<LabelCore, Label>();
+        factory.registerCoreType<ListViewCore, ListView>();
+        factory.registerCoreType<NavigationViewCore, NavigationView>();
+        factory.registerCoreType<ScrollViewCore, ScrollView>();
+        factory.registerCoreType<SliderCore, Slider>();
+        factory.registerCoreType<SwitchCore, Switch>();
+        factory.registerCoreType<TextFieldCore, TextField>();
+        factory.registerCoreType<WebViewCore, WebView>();
+        factory.registerCoreType<WindowCore, Window>();
+    }
+
+    ViewCoreFactory::ViewCoreFactory(std::shared_ptr<TextMetrics> textMetrics, float pointScaleFactor)
+        : _textMetrics(std::move(textMetrics)), _pointScaleFactor(pointScaleFactor)
+    {
+        registerCoreTypes(*this);
+    }
+}
@@ -0,0 +1,8 @@
+#include <bdn/ui/headless/WebViewCore.h>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(WebView, bdn::ui::headless::WebViewCore, WebView)
+}
+#endif
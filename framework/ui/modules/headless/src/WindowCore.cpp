@@ -0,0 +1,36 @@
+#include <bdn/ui/headless/WindowCore.h>
+
+#if BDN_HEADLESS_DEFAULT_CORES == 1
+namespace bdn::ui::detail
+{
+    CORE_REGISTER(Window, bdn::ui::headless::WindowCore, Window)
+}
+#endif
+
+namespace bdn::ui::headless
+{
+    void WindowCore::init()
+    {
+        ViewCore::init();
+
+        geometry.onChange() += [=](auto &) { updateContentGeometry(); };
+        contentView.onChange() += [=](auto &property) {
+            if (auto content = property.get()) {
+                content->viewCore();
+            }
+            scheduleLayout();
+        };
+
+        updateContentGeometry();
+    }
+
+    void WindowCore::updateContentGeometry()
+    {
+        Rect r = geometry.get();
+        contentGeometry = Rect{0, 0, r.width, r.height};
+
+        currentOrientation = r.width > r.height ? Orientation::LandscapeLeft : Orientation::Portrait;
+
+        scheduleLayout();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <yoga/Yoga.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace bdn::ui::yoga
+{
+    /** Remembers the results of a view's sizeForSpace() and baseline() calls.
+
+        Yoga asks for the size of a leaf node several times per layout pass, often with the same
+        constraints, and again in later passes although nothing changed. Each of these calls goes to
+        the native core. The cache of a view is cleared when its core marks it dirty or when its flex
+        style changes.
+
+        A result is also reused for different constraints if the view did not use the space in which
+        they differ, for example when only the height available to a view that is laid out in a
+        column changes.*/
+    class MeasureCache
+    {
+      public:
+        struct Statistics
+        {
+            size_t measureHitCount = 0;
+            size_t measureMissCount = 0;
+            /** Measure hits for constraints other than the ones the result was stored for.*/
+            size_t compatibleHitCount = 0;
+            size_t baselineHitCount = 0;
+            size_t baselineMissCount = 0;
+        };
+
+      public:
+        /** Enabled by default. When disabled every call is forwarded to the view.*/
+        static bool &enabled();
+
+        static Statistics statistics();
+        static void resetStatistics();
+
+      public:
+        std::optional<YGSize> findSize(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode,
+                                       float pointScaleFactor);
+        void storeSize(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode,
+                       float pointScaleFactor, YGSize size);
+
+        std::optional<float> findBaseline(float width, float height);
+        void storeBaseline(float width, float height, float baseline);
+
+        void invalidate();
+
+      private:
+        std::optional<YGSize> lookupSize(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode,
+                                         float pointScaleFactor, bool &compatible) const;
+
+      private:
+        struct SizeEntry
+        {
+            float width;
+            YGMeasureMode widthMode;
+            float height;
+            YGMeasureMode heightMode;
+            float pointScaleFactor;
+            YGSize size;
+        };
+
+        struct BaselineEntry
+        {
+            float width;
+            float height;
+            float baseline;
+        };
+
+        // Yoga only uses a handful of different constraints per node, so the entries are searched
+        // linearly and the oldest one is replaced once the limit is reached
+        static constexpr size_t maximumEntryCount = 8;
+
+        std::vector<SizeEntry> _sizes;
+        std::vector<BaselineEntry> _baselines;
+        size_t _nextSize = 0;
+        size_t _nextBaseline = 0;
+    };
+}
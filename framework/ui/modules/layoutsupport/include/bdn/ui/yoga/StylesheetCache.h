@@ -0,0 +1,36 @@
+#pragma once
+
+#include <bdn/ui/yoga/FlexStylesheet.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace bdn::ui::yoga
+{
+    /** Interns the compiled FlexStylesheet of view stylesheets.
+
+        Stylesheets with an equal "flex" entry share one compiled FlexStylesheet, so views that use
+        the same style (like the rows of a list) parse it only once, and the layout can tell that a
+        view's style did not change by comparing pointers. Entries are kept as long as a view uses
+        them.*/
+    class StylesheetCache
+    {
+      public:
+        /** Returns the compiled "flex" entry of stylesheet.*/
+        std::shared_ptr<const FlexStylesheet> compile(const json &stylesheet);
+
+        /** Number of entries, including ones that are no longer used but have not been swept yet.*/
+        size_t size() const { return _entries.size(); }
+
+        /** Number of compile() calls, each of which hashes the stylesheet's "flex" entry.*/
+        size_t lookupCount() const { return _lookupCount; }
+
+      private:
+        void sweep();
+
+      private:
+        std::unordered_map<json, std::weak_ptr<const FlexStylesheet>> _entries;
+        size_t _sweepThreshold = 64;
+        size_t _lookupCount = 0;
+    };
+}
@@ -0,0 +1,146 @@
+#include <bdn/ui/yoga/MeasureCache.h>
+
+namespace bdn::ui::yoga
+{
+    namespace
+    {
+        MeasureCache::Statistics s_statistics;
+
+        // Yoga passes NaN for undefined constraints
+        float constraint(float value, YGMeasureMode mode) { return mode == YGMeasureModeUndefined ? 0.0f : value; }
+
+        // A measurement along one axis stays valid for a different constraint if the view did not
+        // use the space in which the constraints differ. These are the rules yoga applies to its own
+        // cached measurements.
+        bool isCompatible(float value, YGMeasureMode mode, float cachedValue, YGMeasureMode cachedMode, float measured)
+        {
+            if (mode == cachedMode && value == cachedValue) {
+                return true;
+            }
+            if (mode == YGMeasureModeExactly) {
+                return value == measured;
+            }
+            if (mode == YGMeasureModeAtMost) {
+                if (cachedMode == YGMeasureModeUndefined) {
+                    return value >= measured;
+                }
+                if (cachedMode == YGMeasureModeAtMost) {
+                    return value < cachedValue && measured <= value;
+                }
+            }
+            return false;
+        }
+
+        template <class Entry> void store(std::vector<Entry> &entries, size_t &next, size_t maximum, Entry entry)
+        {
+            if (entries.size() < maximum) {
+                entries.push_back(entry);
+            } else {
+                entries[next] = entry;
+                next = (next + 1) % maximum;
+            }
+        }
+    }
+
+    bool &MeasureCache::enabled()
+    {
+        static bool s_enabled = true;
+        return s_enabled;
+    }
+
+    MeasureCache::Statistics MeasureCache::statistics() { return s_statistics; }
+
+    void MeasureCache::resetStatistics() { s_statistics = Statistics{}; }
+
+    std::optional<YGSize> MeasureCache::findSize(float width, YGMeasureMode widthMode, float height,
+                                                 YGMeasureMode heightMode, float pointScaleFactor)
+    {
+        if (!enabled()) {
+            return std::nullopt;
+        }
+
+        bool compatible = false;
+        auto size = lookupSize(width, widthMode, height, heightMode, pointScaleFactor, compatible);
+        if (size) {
+            s_statistics.measureHitCount++;
+            if (compatible) {
+                s_statistics.compatibleHitCount++;
+            }
+        } else {
+            s_statistics.measureMissCount++;
+        }
+        return size;
+    }
+
+    std::optional<YGSize> MeasureCache::lookupSize(float width, YGMeasureMode widthMode, float height,
+                                                   YGMeasureMode heightMode, float pointScaleFactor,
+                                                   bool &compatible) const
+    {
+        width = constraint(width, widthMode);
+        height = constraint(height, heightMode);
+
+        const SizeEntry *compatibleEntry = nullptr;
+        for (const auto &entry : _sizes) {
+            if (entry.pointScaleFactor != pointScaleFactor) {
+                continue;
+            }
+            if (entry.width == width && entry.widthMode == widthMode && entry.height == height &&
+                entry.heightMode == heightMode) {
+                return entry.size;
+            }
+            if (compatibleEntry == nullptr &&
+                isCompatible(width, widthMode, entry.width, entry.widthMode, entry.size.width) &&
+                isCompatible(height, heightMode, entry.height, entry.heightMode, entry.size.height)) {
+                compatibleEntry = &entry;
+            }
+        }
+
+        if (compatibleEntry != nullptr) {
+            compatible = true;
+            return compatibleEntry->size;
+        }
+        return std::nullopt;
+    }
+
+    void MeasureCache::storeSize(float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode,
+                                 float pointScaleFactor, YGSize size)
+    {
+        if (enabled()) {
+            store(_sizes, _nextSize, maximumEntryCount,
+                  SizeEntry{constraint(width, widthMode), widthMode, constraint(height, heightMode), heightMode,
+                            pointScaleFactor, size});
+        }
+    }
+
+    std::optional<float> MeasureCache::findBaseline(float width, float height)
+    {
+        if (!enabled()) {
+            return std::nullopt;
+        }
+
+        for (const auto &entry : _baselines) {
+            if (entry.width == width && entry.height == height) {
+                s_statistics.baselineHitCount++;
+                return entry.baseline;
+            }
+        }
+
+        s_statistics.baselineMissCount++;
+        return std::nullopt;
+    }
+
+    void MeasureCache::storeBaseline(float width, float height, float baseline)
+    {
+        if (enabled()) {
+            store(_baselines, _nextBaseline, maximumEntryCount, BaselineEntry{width, height, baseline});
+        }
+    }
+
+    void MeasureCache::invalidate()
+    {
+        _sizes.clear();
+        _baselines.clear();
+        _nextSize = 0;
+        _nextBaseline = 0;
+    }
+}
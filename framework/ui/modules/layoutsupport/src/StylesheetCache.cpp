@@ -0,0 +1,41 @@
+#include <bdn/ui/yoga/StylesheetCache.h>
+
+#include <algorithm>
+
+namespace bdn::ui::yoga
+{
+    std::shared_ptr<const FlexStylesheet> StylesheetCache::compile(const json &stylesheet)
+    {
+        _lookupCount++;
+
+        static const json noFlex;
+        const json &flex = stylesheet.count("flex") != 0 ? stylesheet.at("flex") : noFlex;
+
+        auto &entry = _entries[flex];
+        if (auto compiled = entry.lock()) {
+            return compiled;
+        }
+
+        std::shared_ptr<const FlexStylesheet> compiled =
+            std::make_shared<FlexStylesheet>(flex.is_null() ? FlexStylesheet() : (FlexStylesheet)flex);
+        entry = compiled;
+
+        if (_entries.size() >= _sweepThreshold) {
+            sweep();
+        }
+
+        return compiled;
+    }
+
+    void StylesheetCache::sweep()
+    {
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (it->second.expired()) {
+                it = _entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _sweepThreshold = std::max<size_t>(64, _entries.size() * 2);
+    }
+}
@@ -13,8 +13,11 @@ namespace bdn::ui::lottie
     {
         detail::VIEW_CORE_REGISTER(View, ui::View::viewCoreFactory());
 
-        registerCoreCreatingProperties(this, &url);
-        url.onChange() += [this](auto) { loadURL(url); };
+        url.onChange() += [this](auto) {
+            if (hasViewCore()) {
+                loadURL(url);
+            }
+        };
     }
 
     void View::loadURL(const std::string &url)
@@ -29,5 +32,9 @@ namespace bdn::ui::lottie
         auto lottieCore = core<View::Core>();
         lottieCore->running.bind(running);
         lottieCore->loop.bind(loop);
+
+        if (!url->empty()) {
+            lottieCore->loadURL(url);
+        }
     }
 }
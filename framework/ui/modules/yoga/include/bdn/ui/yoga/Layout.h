@@ -1,8 +1,11 @@
 #pragma once
 
+#include <bdn/ui/yoga/NodePool.h>
+#include <bdn/ui/yoga/StylesheetCache.h>
 #include <bdn/ui/yoga/ViewData.h>
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace bdn::ui::yoga
 {
@@ -14,16 +17,49 @@ namespace bdn::ui::yoga
 
         void markDirty(View *view) override;
         void updateStylesheet(View *view) override;
+        /** Only inserts or removes the view's node, the stylesheet is not compiled again.*/
+        void updateVisibility(View *view) override;
 
         void layout(View *view) override;
 
+        void beginUpdates(View *parent) override;
+        void endUpdates(View *parent) override;
+
+        const StylesheetCache &stylesheetCache() const { return _stylesheetCache; }
+
+        /** How many nodes the last layout pass visited and how many geometries it changed. Only the
+            nodes whose layout yoga recalculated are visited.*/
+        ViewData::ApplyStatistics lastApplyStatistics() const { return _lastApplyStatistics; }
+
+        const NodePool &nodePool() const { return _nodePool; }
+
+        /** The number of views registered with the layout.*/
+        size_t viewCount() const { return _views.size(); }
+
       private:
-        void applyStyle(View *view, YGNodeRef ygNode);
+        bool isRoot(View *view) const;
+        float initialPointScaleFactor(View *view) const;
+        void applyStyle(View *view, ViewData &viewData);
 
         void insert(View *view);
         void remove(View *view);
+        void rebuildChildren(View *parent, ViewData &parentData);
+        int insertionIndex(View *parent, ViewData &parentData, View *view) const;
+
+        /** Gives viewData and its ancestors a new generation, which invalidates the layout results
+            that were stored for them.*/
+        void touch(ViewData *viewData);
 
       private:
-        std::map<View *, std::unique_ptr<ViewData>> _views;
+        // Declared first, the nodes of the views are returned to it when they are destroyed
+        NodePool _nodePool;
+
+        std::unordered_map<View *, std::unique_ptr<ViewData>> _views;
+        // Parents between beginUpdates() and endUpdates(), and whether inserting a child was deferred
+        std::unordered_map<View *, bool> _updatingParents;
+        StylesheetCache _stylesheetCache;
+        ViewData::ApplyStatistics _lastApplyStatistics;
+
+        uint64_t _generation = 0;
     };
 }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bdn::ui
+{
+    class View;
+}
+
+namespace bdn::ui::yoga
+{
+    /** Opt-in profiler for the yoga layout.
+
+        While enabled() is false the layout only pays for a relaxed atomic load per recorded event. Once
+        enabled, the profiler records per view how often it was laid out as a root and how long
+        YGNodeCalculateLayout took, how often yoga measured it and how long that took, and which
+        changes marked the layout dirty. Views are identified by their address and reported with
+        their type and an optional debug name.
+
+        Events are grouped into frames. A frame is one iteration of the application's dispatch
+        queue, like for CommitPhase, or ends when endFrame() is called. If a single root is laid out
+        more than thrashThreshold() times in a frame, the frame is flagged as thrashing.
+
+        The profiler must only be used from the main thread; only enabled() may be toggled from any
+        thread. The statistics of a view are dropped when it is unregistered from its layout.*/
+    class LayoutProfiler
+    {
+      public:
+        using Duration = std::chrono::duration<double>;
+
+        enum class DirtySource
+        {
+            /** The view's core reported a content change through Layout::markDirty().*/
+            core,
+            /** The view's flex style changed.*/
+            stylesheet,
+            /** A child of the view was inserted, removed, shown or hidden.*/
+            children,
+            /** The geometry of a layout root changed.*/
+            geometry
+        };
+        static constexpr size_t dirtySourceCount = 4;
+
+        struct ViewStatistics
+        {
+            std::string typeName;
+            std::string debugName;
+            size_t layoutCount = 0;
+            Duration layoutTime{0};
+            size_t measureCount = 0;
+            Duration measureTime{0};
+            std::array<size_t, dirtySourceCount> dirtyCounts{};
+        };
+
+        struct FrameStatistics
+        {
+            size_t layoutCount = 0;
+            Duration layoutTime{0};
+            size_t measureCount = 0;
+            Duration measureTime{0};
+            /** The most layout passes of a single root in the frame.*/
+            size_t maximumLayoutsPerRoot = 0;
+            bool thrashing = false;
+        };
+
+        struct Statistics
+        {
+            size_t frameCount = 0;
+            size_t thrashingFrameCount = 0;
+            size_t layoutCount = 0;
+            Duration layoutTime{0};
+            size_t measureCount = 0;
+            Duration measureTime{0};
+            size_t maximumLayoutsPerFrame = 0;
+        };
+
+        using ViewStatisticsMap = std::map<const View *, ViewStatistics>;
+        using ThrashHandler = std::function<void(const View *root, size_t layoutCount)>;
+
+      public:
+        static std::atomic<bool> &enabled();
+        static size_t &thrashThreshold();
+
+        /** Sets the function that is called when a root thrashes. By default thrashing is logged via
+            bdn::logstream. Pass nullptr to restore the default.*/
+        static void setThrashHandler(ThrashHandler handler);
+
+        static void setDebugName(const View *view, std::string debugName);
+
+        /** Drops the statistics of a view that leaves its layout, before its address can be reused.*/
+        static void forget(const View *view);
+
+        /** Closes the current frame. Called automatically once per iteration of the dispatch queue.*/
+        static void endFrame();
+
+      public:
+        static ViewStatisticsMap viewStatistics();
+        static Statistics statistics();
+        /** The statistics of the most recent frames in which the layout did any work, oldest first.*/
+        static std::vector<FrameStatistics> recentFrames();
+        static void reset();
+
+        static std::string toJson();
+        /** Logs the totals and the views that took the most time via bdn::logstream.*/
+        static void logSummary(size_t viewCount = 10);
+
+      public:
+        static void recordLayout(const View *root, Duration duration);
+        static void recordMeasure(const View *view, Duration duration);
+        static void recordDirty(const View *view, DirtySource source);
+    };
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <bdn/Size.h>
+#include <yoga/YGLayout.h>
+#include <yoga/Yoga.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bdn::ui::yoga
+{
+    /** Remembers the complete yoga results of a layout root for the sizes it was laid out at most
+        recently.
+
+        Rotating a device or resizing a window back and forth lays out the same tree at the same
+        sizes again. The results for a size are stored when the root is laid out at a different size,
+        keyed by the root's size and generation (see Layout::touch()). Laying out the root at a stored
+        size copies the results back into the yoga nodes instead of calculating them. Any change to
+        the tree gives the root a new generation, which makes all stored results unusable, so they
+        are dropped when the next results are stored.
+
+        Each entry holds the yoga layout of every node of the tree. The least recently used entry is
+        replaced once capacity() is reached.*/
+    class LayoutResultCache
+    {
+      public:
+        struct Statistics
+        {
+            size_t hitCount = 0;
+            size_t missCount = 0;
+            size_t storeCount = 0;
+        };
+
+      public:
+        /** The number of sizes remembered per root, 3 by default. 0 disables the cache.*/
+        static size_t &capacity();
+
+        static Statistics statistics();
+        static void resetStatistics();
+
+      public:
+        /** Stores the current results of the tree of root for size.*/
+        void store(Size size, uint64_t generation, YGNodeRef root);
+
+        /** Copies the results stored for size into the tree of root and flags the nodes that changed
+            as having a new layout. Returns false if there are none.*/
+        bool restore(Size size, uint64_t generation, YGNodeRef root);
+
+        size_t entryCount() const { return _entries.size(); }
+
+        void invalidate();
+
+      private:
+        struct Entry
+        {
+            Size size;
+            uint64_t generation;
+            uint64_t lastUse;
+            // In depth first order of the nodes
+            std::vector<YGLayout> layouts;
+        };
+
+        static void collect(YGNodeRef node, std::vector<YGLayout> &layouts);
+        static bool copyBack(YGNodeRef node, const std::vector<YGLayout> &layouts, size_t &index);
+
+      private:
+        std::vector<Entry> _entries;
+        uint64_t _useCount = 0;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <yoga/Yoga.h>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace bdn::ui::yoga
+{
+    /** Owns the yoga configs of a layout and recycles its nodes.
+
+        There is one config per point scale factor, so all nodes of a window share a config that is
+        set up once and never changed afterwards. Released nodes are reset and kept for the next view
+        instead of being freed.*/
+    class NodePool
+    {
+      public:
+        NodePool() = default;
+        ~NodePool();
+
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+
+        YGConfigRef configFor(float pointScaleFactor);
+
+        /** Returns a node in its initial state that uses config.*/
+        YGNodeRef acquire(YGConfigRef config);
+
+        /** Resets node and keeps it for reuse. node must not have an owner or children.*/
+        void release(YGNodeRef node);
+
+        size_t freeCount() const { return _freeNodes.size(); }
+        size_t createdCount() const { return _createdCount; }
+        size_t configCount() const { return _configs.size(); }
+
+      private:
+        static constexpr size_t maximumFreeCount = 4096;
+
+        std::unordered_map<float, std::unique_ptr<YGConfig, decltype(&YGConfigFree)>> _configs;
+        std::vector<YGNodeRef> _freeNodes;
+        size_t _createdCount = 0;
+    };
+}
@@ -4,8 +4,15 @@
 #include <bdn/Rect.h>
 #include <bdn/property/Property.h>
 #include <bdn/ui/View.h>
+#include <bdn/ui/yoga/FlexStylesheet.h>
+#include <bdn/ui/yoga/LayoutResultCache.h>
+#include <bdn/ui/yoga/MeasureCache.h>
+#include <bdn/ui/yoga/NodePool.h>
 #include <yoga/Yoga.h>
 
+#include <cstdint>
+#include <optional>
+
 struct YGNode;
 
 namespace bdn::ui::yoga
@@ -13,10 +20,29 @@ namespace bdn::ui::yoga
     class ViewData
     {
       public:
-        ViewData(View *v);
+        struct ApplyStatistics
+        {
+            /** Nodes whose layout was new and that were therefore visited.*/
+            size_t visitedCount = 0;
+            /** Views whose geometry actually changed.*/
+            size_t changedCount = 0;
+        };
+
+      public:
+        ViewData(View *v, NodePool &pool, float initialPointScaleFactor, bool isRoot);
         ~ViewData();
 
-        void doLayout();
+        ViewData(const ViewData &) = delete;
+        ViewData &operator=(const ViewData &) = delete;
+
+        ApplyStatistics doLayout();
+
+        /** If the root's size changed since it was last laid out, stores the previous results in
+            resultCache and applies the results stored for the current size, if any.*/
+        std::optional<ApplyStatistics> restoreLayout();
+
+        /** Records that the yoga tree holds the results for the root's current size and generation.*/
+        void layoutApplied();
 
         static void onDirtied(YGNodeRef node);
 
@@ -25,13 +51,25 @@ namespace bdn::ui::yoga
 
         static float baselineFunc(YGNodeRef node, float width, float height);
 
-        static void applyLayout(YGNodeRef node, Point offset);
+        /** Sets the geometry of node's view from its layout. Returns false if it did not change.*/
+        static bool applyLayout(YGNodeRef node, Point offset);
 
-        static void yogaVisit(YGNodeRef node, const std::function<void(YGNodeRef, Point)> &function,
-                              Point initialOffset = {0, 0});
+        /** Applies the layout of the descendants of node that have a new layout and clears their
+            flag. Subtrees without a new layout are skipped, as the geometry of views is relative to
+            their parent, and so are nested layout roots.*/
+        static ApplyStatistics applyNewLayouts(YGNodeRef node, Point offset = {0, 0});
 
         void childrenChanged(bool adding = false);
 
+        /** Moves the node to the config of the view's current point scale factor if it changed.*/
+        void updatePointScaleFactor();
+
+        /** Returns the ViewData a yoga node belongs to, or nullptr if it has none.*/
+        static ViewData *fromNode(YGNodeRef node);
+
+        /** Returns the ViewData of the node this view's node is inserted in, if any.*/
+        ViewData *ownerData() const;
+
       public:
         Property<Rect> geometry;
 
@@ -40,5 +78,29 @@ namespace bdn::ui::yoga
         std::function<void()> layoutFunction;
         bool isRootNode;
         bool isIn;
+
+        /** The compiled stylesheet that was last applied to ygNode.*/
+        std::shared_ptr<const FlexStylesheet> appliedStylesheet;
+
+        MeasureCache measureCache;
+
+        /** Results of the root for other sizes, see LayoutResultCache.*/
+        LayoutResultCache resultCache;
+        Size laidOutSize;
+        uint64_t laidOutGeneration = 0;
+
+        /** Changed whenever the node or one of its descendants changes, see Layout::touch().*/
+        uint64_t generation = 0;
+
+        /** The view's point scale factor when the node's config was chosen. Views without a core
+            start with the factor of their parent, see Layout::registerView().*/
+        float pointScaleFactor;
+
+      private:
+        static YGSize measure(YGNodeRef node, float width, YGMeasureMode widthMode, float height,
+                              YGMeasureMode heightMode);
+
+      private:
+        NodePool &_pool;
     };
 }
@@ -1,9 +1,12 @@
 #include <bdn/ui/View.h>
 #include <bdn/ui/yoga/FlexStylesheet.h>
 #include <bdn/ui/yoga/Layout.h>
+#include <bdn/ui/yoga/LayoutProfiler.h>
 
 #include <yoga/YGNode.h>
 
+#include <limits>
+
 namespace bdn::ui::yoga
 {
     constexpr YGFlexDirection toYGFlexDirection(FlexStylesheet::Direction direction)
@@ -104,8 +107,44 @@ namespace bdn::ui::yoga
 
     void Layout::registerView(View *view)
     {
-        _views[view] = std::make_unique<ViewData>(view);
+        auto &viewData = _views[view];
+        viewData = std::make_unique<ViewData>(view, _nodePool, initialPointScaleFactor(view), isRoot(view));
+        viewData->generation = ++_generation;
         updateStylesheet(view);
+
+        // Children that stayed registered while the view was detached are adopted by its new node
+        bool hasRegisteredChildren = false;
+        view->visitChildViews([&](View &child) { hasRegisteredChildren |= _views.count(&child) != 0; });
+        if (hasRegisteredChildren) {
+            rebuildChildren(view, *viewData);
+        }
+    }
+
+    bool Layout::isRoot(View *view) const
+    {
+        // A view whose parent uses another layout, like a grid item with a flex stylesheet for its
+        // content, is sized by that layout. This layout only lays out its content, like for a root.
+        auto parent = view->parentView->lock();
+        return !parent || view->isLayoutRoot || parent->getLayout().get() != this;
+    }
+
+    float Layout::initialPointScaleFactor(View *view) const
+    {
+        if (view->hasViewCore()) {
+            return view->pointScaleFactor();
+        }
+
+        // Asking the view would create its core. Until the core marks the view dirty, it lays out
+        // with the factor of the nearest ancestor that knows it, which usually is the window's.
+        for (auto parent = view->parentView->lock(); parent; parent = parent->parentView->lock()) {
+            if (auto it = _views.find(parent.get()); it != _views.end()) {
+                return it->second->pointScaleFactor;
+            }
+            if (parent->hasViewCore()) {
+                return parent->pointScaleFactor();
+            }
+        }
+        return 1.f;
     }
 
     void Layout::unregisterView(View *view)
@@ -113,39 +152,54 @@ namespace bdn::ui::yoga
         remove(view);
         if (auto it = _views.find(view); it != _views.end()) {
             _views.erase(it);
+            LayoutProfiler::forget(view);
         }
     }
 
     void Layout::markDirty(View *view)
     {
         if (auto it = _views.find(view); it != _views.end()) {
+            LayoutProfiler::recordDirty(view, LayoutProfiler::DirtySource::core);
+            it->second->measureCache.invalidate();
+            it->second->updatePointScaleFactor();
             it->second->ygNode->markDirtyAndPropogate();
+            touch(it->second.get());
         }
     }
 
     void Layout::updateStylesheet(View *view)
     {
         if (auto it = _views.find(view); it != _views.end()) {
-            applyStyle(view, it->second->ygNode);
+            applyStyle(view, *it->second);
+        }
+    }
+
+    void Layout::updateVisibility(View *view)
+    {
+        if (_views.count(view) == 0) {
+            return;
+        }
+
+        if (view->visible.get()) {
+            insert(view);
+        } else {
+            remove(view);
         }
     }
 
     void Layout::layout(View *view)
     {
         if (auto it = _views.find(view); it != _views.end()) {
-            it->second->doLayout();
+            _lastApplyStatistics = it->second->doLayout();
         }
     }
 
-    FlexStylesheet fromStyleSheet(const json &jsonStyleSheet)
+    void Layout::touch(ViewData *viewData)
     {
-        FlexStylesheet result;
-
-        if (jsonStyleSheet.count("flex")) {
-            result = (FlexStylesheet)jsonStyleSheet.at("flex");
+        auto generation = ++_generation;
+        for (; viewData != nullptr; viewData = viewData->ownerData()) {
+            viewData->generation = generation;
         }
-
-        return result;
     }
 
 #define UPDATE_VALUE(FuncName, Value, ...)                                                                             \
@@ -160,94 +214,192 @@ namespace bdn::ui::yoga
         }                                                                                                              \
     }
 
-#define UPDATE_EDGES(FuncName, Node, Value)                                                                            \
-    UPDATE_VALUE(FuncName, Value.all, Node, YGEdgeAll)                                                                 \
-    UPDATE_VALUE(FuncName, Value.left, Node, YGEdgeLeft)                                                               \
-    UPDATE_VALUE(FuncName, Value.top, Node, YGEdgeTop)                                                                 \
-    UPDATE_VALUE(FuncName, Value.right, Node, YGEdgeRight)                                                             \
-    UPDATE_VALUE(FuncName, Value.bottom, Node, YGEdgeBottom)
+#define UPDATE_EDGES(FuncName, Node, Value, Previous)                                                                  \
+    if (!(Previous) || !((Previous)->all == Value.all)) {                                                              \
+        UPDATE_VALUE(FuncName, Value.all, Node, YGEdgeAll)                                                             \
+    }                                                                                                                  \
+    if (!(Previous) || !((Previous)->left == Value.left)) {                                                            \
+        UPDATE_VALUE(FuncName, Value.left, Node, YGEdgeLeft)                                                           \
+    }                                                                                                                  \
+    if (!(Previous) || !((Previous)->top == Value.top)) {                                                              \
+        UPDATE_VALUE(FuncName, Value.top, Node, YGEdgeTop)                                                             \
+    }                                                                                                                  \
+    if (!(Previous) || !((Previous)->right == Value.right)) {                                                          \
+        UPDATE_VALUE(FuncName, Value.right, Node, YGEdgeRight)                                                         \
+    }                                                                                                                  \
+    if (!(Previous) || !((Previous)->bottom == Value.bottom)) {                                                        \
+        UPDATE_VALUE(FuncName, Value.bottom, Node, YGEdgeBottom)                                                       \
+    }
+
+#define UPDATE_SIZES(FuncName, Node, Value, Previous)                                                                  \
+    if (!(Previous) || !((Previous)->width == Value.width)) {                                                          \
+        UPDATE_VALUE(FuncName##Width, Value.width, Node)                                                               \
+    }                                                                                                                  \
+    if (!(Previous) || !((Previous)->height == Value.height)) {                                                        \
+        UPDATE_VALUE(FuncName##Height, Value.height, Node)                                                             \
+    }
 
-#define UPDATE_SIZES(FuncName, Node, Value)                                                                            \
-    UPDATE_VALUE(FuncName##Width, Value.width, Node)                                                                   \
-    UPDATE_VALUE(FuncName##Height, Value.height, Node)
+#define IF_CHANGED(Field) if (!previous || !(previous->Field == stylesheet.Field))
 
-    void Layout::applyStyle(View *view, YGNodeRef ygNode)
+    void Layout::applyStyle(View *view, ViewData &viewData)
     {
-        FlexStylesheet stylesheet = fromStyleSheet(view->stylesheet.get());
+        auto compiled = _stylesheetCache.compile(view->stylesheet.get());
 
-        if (view->visible.get()) {
-            insert(view);
-        } else {
-            remove(view);
+        updateVisibility(view);
+
+        if (compiled == viewData.appliedStylesheet) {
+            return;
         }
 
-        YGNodeStyleSetFlexDirection(ygNode, toYGFlexDirection(stylesheet.flexDirection));
-        YGNodeStyleSetDirection(ygNode, toYGDirection(stylesheet.layoutDirection));
+        // Content changes that come from the stylesheet, like fonts, are reported by the core
+        // through markDirty(). The cached sizes are dropped here as well, as the style changed.
+        viewData.measureCache.invalidate();
+        touch(&viewData);
+        LayoutProfiler::recordDirty(view, LayoutProfiler::DirtySource::stylesheet);
 
-        YGNodeStyleSetAlignContent(ygNode, toYGAlign(stylesheet.alignContents));
-        YGNodeStyleSetAlignItems(ygNode, toYGAlign(stylesheet.alignItems));
-        YGNodeStyleSetAlignSelf(ygNode, toYGAlign(stylesheet.alignSelf));
+        // Only the values that differ from the previously applied stylesheet are set, so that an
+        // unchanged style does not dirty the node
+        const FlexStylesheet &stylesheet = *compiled;
+        const FlexStylesheet *previous = viewData.appliedStylesheet.get();
+        YGNodeRef ygNode = viewData.ygNode;
 
-        YGNodeStyleSetJustifyContent(ygNode, toYGJustify(stylesheet.justifyContent));
+        IF_CHANGED(flexDirection) { YGNodeStyleSetFlexDirection(ygNode, toYGFlexDirection(stylesheet.flexDirection)); }
+        IF_CHANGED(layoutDirection) { YGNodeStyleSetDirection(ygNode, toYGDirection(stylesheet.layoutDirection)); }
 
-        YGNodeStyleSetFlexWrap(ygNode, toYGWrap(stylesheet.flexWrap));
+        IF_CHANGED(alignContents) { YGNodeStyleSetAlignContent(ygNode, toYGAlign(stylesheet.alignContents)); }
+        IF_CHANGED(alignItems) { YGNodeStyleSetAlignItems(ygNode, toYGAlign(stylesheet.alignItems)); }
+        IF_CHANGED(alignSelf) { YGNodeStyleSetAlignSelf(ygNode, toYGAlign(stylesheet.alignSelf)); }
 
-        YGNodeStyleSetFlexGrow(ygNode, stylesheet.flexGrow);
-        YGNodeStyleSetFlexShrink(ygNode, stylesheet.flexShrink);
+        IF_CHANGED(justifyContent) { YGNodeStyleSetJustifyContent(ygNode, toYGJustify(stylesheet.justifyContent)); }
 
-        UPDATE_EDGES(YGNodeStyleSetPadding, ygNode, stylesheet.padding)
-        UPDATE_EDGES(YGNodeStyleSetMargin, ygNode, stylesheet.margin)
-        UPDATE_EDGES(YGNodeStyleSetPosition, ygNode, stylesheet.position)
+        IF_CHANGED(flexWrap) { YGNodeStyleSetFlexWrap(ygNode, toYGWrap(stylesheet.flexWrap)); }
 
-        UPDATE_SIZES(YGNodeStyleSet, ygNode, stylesheet.size)
-        UPDATE_SIZES(YGNodeStyleSetMin, ygNode, stylesheet.minimumSize)
-        UPDATE_SIZES(YGNodeStyleSetMax, ygNode, stylesheet.maximumSize)
+        IF_CHANGED(flexGrow) { YGNodeStyleSetFlexGrow(ygNode, stylesheet.flexGrow); }
+        IF_CHANGED(flexShrink) { YGNodeStyleSetFlexShrink(ygNode, stylesheet.flexShrink); }
 
-        YGNodeStyleSetPositionType(ygNode, toYGPositionType(stylesheet.positionType));
+        UPDATE_EDGES(YGNodeStyleSetPadding, ygNode, stylesheet.padding, previous ? &previous->padding : nullptr)
+        UPDATE_EDGES(YGNodeStyleSetMargin, ygNode, stylesheet.margin, previous ? &previous->margin : nullptr)
+        UPDATE_EDGES(YGNodeStyleSetPosition, ygNode, stylesheet.position, previous ? &previous->position : nullptr)
 
-        YGNodeStyleSetAspectRatio(ygNode, stylesheet.aspectRatio ? *stylesheet.aspectRatio : NAN);
+        UPDATE_SIZES(YGNodeStyleSet, ygNode, stylesheet.size, previous ? &previous->size : nullptr)
+        UPDATE_SIZES(YGNodeStyleSetMin, ygNode, stylesheet.minimumSize, previous ? &previous->minimumSize : nullptr)
+        UPDATE_SIZES(YGNodeStyleSetMax, ygNode, stylesheet.maximumSize, previous ? &previous->maximumSize : nullptr)
 
-        if (!stylesheet.flexBasis) {
-            YGNodeStyleSetFlexBasisAuto(ygNode);
-        } else {
-            if (stylesheet.flexBasis->isPercent()) {
-                YGNodeStyleSetFlexBasisPercent(ygNode, stylesheet.flexBasis->value);
+        IF_CHANGED(positionType) { YGNodeStyleSetPositionType(ygNode, toYGPositionType(stylesheet.positionType)); }
+
+        IF_CHANGED(aspectRatio)
+        {
+            YGNodeStyleSetAspectRatio(ygNode, stylesheet.aspectRatio ? *stylesheet.aspectRatio : NAN);
+        }
+
+        IF_CHANGED(flexBasis)
+        {
+            if (!stylesheet.flexBasis) {
+                YGNodeStyleSetFlexBasisAuto(ygNode);
             } else {
-                YGNodeStyleSetFlexBasis(ygNode, stylesheet.flexBasis->value);
+                if (stylesheet.flexBasis->isPercent()) {
+                    YGNodeStyleSetFlexBasisPercent(ygNode, stylesheet.flexBasis->value);
+                } else {
+                    YGNodeStyleSetFlexBasis(ygNode, stylesheet.flexBasis->value);
+                }
             }
         }
+
+        viewData.appliedStylesheet = std::move(compiled);
     }
 
+#undef IF_CHANGED
+
     void Layout::insert(View *view)
     {
         if (std::shared_ptr<View> parent = view->parentView->lock()) {
-            auto &viewData = _views[view];
+            auto itView = _views.find(view);
+            if (itView == _views.end() || itView->second->isIn)
+                return;
 
-            if (viewData->isIn)
+            if (auto updating = _updatingParents.find(parent.get()); updating != _updatingParents.end()) {
+                // The parent's children are inserted all at once in endUpdates()
+                updating->second = true;
                 return;
+            }
+
+            auto itParent = _views.find(parent.get());
+            if (itParent != _views.end()) {
+                auto &parentData = *itParent->second;
+                int index = insertionIndex(parent.get(), parentData, view);
+
+                touch(&parentData);
+                LayoutProfiler::recordDirty(parent.get(), LayoutProfiler::DirtySource::children);
+                parentData.childrenChanged(true);
+                itView->second->isIn = true;
+                YGNodeInsertChild(parentData.ygNode, itView->second->ygNode, static_cast<uint32_t>(index));
+                parentData.childrenChanged();
+            }
+        }
+    }
+
+    int Layout::insertionIndex(View *parent, ViewData &parentData, View *view) const
+    {
+        // The inserted nodes keep the order of the parent's children, so the position of view among
+        // them can be found by a binary search over the child indices.
+        auto viewIndex = parent->indexOfChildView(*view).value_or(std::numeric_limits<size_t>::max());
+
+        int low = 0;
+        int high = static_cast<int>(YGNodeGetChildCount(parentData.ygNode));
+        while (low < high) {
+            int middle = low + (high - low) / 2;
+            auto childData = ViewData::fromNode(YGNodeGetChild(parentData.ygNode, static_cast<uint32_t>(middle)));
+            auto childIndex = childData != nullptr ? parent->indexOfChildView(*childData->view) : std::nullopt;
+
+            if (childIndex.value_or(std::numeric_limits<size_t>::max()) < viewIndex) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
 
-            auto it = _views.find(parent.get());
-            if (it != _views.end()) {
-                viewData->isIn = true;
+    void Layout::rebuildChildren(View *parent, ViewData &parentData)
+    {
+        touch(&parentData);
+        LayoutProfiler::recordDirty(parent, LayoutProfiler::DirtySource::children);
+        YGNodeRemoveAllChildren(parentData.ygNode);
+
+        parentData.childrenChanged(true);
+
+        parent->visitChildViews([&](View &child) {
+            if (child.visible.get()) {
+                auto itChild = _views.find(&child);
+                if (itChild != _views.end()) {
+                    itChild->second->isIn = true;
+                    YGNodeInsertChild(parentData.ygNode, itChild->second->ygNode,
+                                      YGNodeGetChildCount(parentData.ygNode));
+                }
+            }
+        });
 
-                auto childList = parent->childViews();
+        parentData.childrenChanged();
+    }
 
-                YGNodeRemoveAllChildren(it->second->ygNode);
+    void Layout::beginUpdates(View *parent) { _updatingParents.emplace(parent, false); }
 
-                it->second->childrenChanged(true);
+    void Layout::endUpdates(View *parent)
+    {
+        auto updating = _updatingParents.find(parent);
+        if (updating == _updatingParents.end()) {
+            return;
+        }
+        bool childrenDeferred = updating->second;
+        _updatingParents.erase(updating);
 
-                for (auto &child : parent->childViews()) {
-                    if (child->visible.get()) {
-                        auto itChild = _views.find(child.get());
-                        if (itChild != _views.end()) {
-                            YGNodeInsertChild(it->second->ygNode, itChild->second->ygNode,
-                                              YGNodeGetChildCount(it->second->ygNode));
-                        }
-                    }
-                }
+        // Ancestors of a changed view are only visited on the way to it, their children stay as they are
+        if (!childrenDeferred) {
+            return;
+        }
 
-                it->second->childrenChanged();
-            }
+        if (auto it = _views.find(parent); it != _views.end()) {
+            rebuildChildren(parent, *it->second);
         }
     }
 
@@ -257,15 +409,16 @@ namespace bdn::ui::yoga
         if (it != _views.end()) {
             if (it->second->isIn) {
                 if (auto owner = YGNodeGetOwner(it->second->ygNode)) {
-
-                    auto parentData = std::find_if(_views.begin(), _views.end(), [&owner](auto &viewData) {
-                        return viewData.second->ygNode == owner;
-                    });
+                    auto parentData = ViewData::fromNode(owner);
+                    touch(parentData);
+                    if (parentData != nullptr) {
+                        LayoutProfiler::recordDirty(parentData->view, LayoutProfiler::DirtySource::children);
+                    }
 
                     it->second->isIn = false;
                     YGNodeRemoveChild(owner, it->second->ygNode);
-                    if (parentData != _views.end()) {
-                        parentData->second->childrenChanged();
+                    if (parentData != nullptr) {
+                        parentData->childrenChanged();
                     }
                 }
             }
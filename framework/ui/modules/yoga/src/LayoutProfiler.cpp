@@ -0,0 +1,323 @@
+#include <bdn/Application.h>
+#include <bdn/Json.h>
+#include <bdn/log.h>
+#include <bdn/ui/View.h>
+#include <bdn/ui/yoga/LayoutProfiler.h>
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#define BDN_LAYOUT_PROFILER_DEMANGLE 1
+#endif
+
+namespace bdn::ui::yoga
+{
+    namespace
+    {
+        // Frames without layout work are not kept
+        constexpr size_t maximumRecentFrameCount = 120;
+
+        struct ProfilerData
+        {
+            LayoutProfiler::ViewStatisticsMap views;
+            LayoutProfiler::Statistics statistics;
+            std::deque<LayoutProfiler::FrameStatistics> recentFrames;
+            LayoutProfiler::ThrashHandler thrashHandler;
+
+            LayoutProfiler::FrameStatistics frame;
+            std::unordered_map<const View *, size_t> frameLayoutCounts;
+            bool frameScheduled = false;
+        };
+
+        ProfilerData &data()
+        {
+            static ProfilerData instance;
+            return instance;
+        }
+
+        std::string typeNameOf(const View *view)
+        {
+            const char *name = typeid(*view).name();
+#ifdef BDN_LAYOUT_PROFILER_DEMANGLE
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            if (status == 0 && demangled != nullptr) {
+                std::string result(demangled);
+                std::free(demangled);
+                return result;
+            }
+#endif
+            return name;
+        }
+
+        std::string viewId(const View *view)
+        {
+            std::ostringstream stream;
+            stream << view;
+            return stream.str();
+        }
+
+        std::string viewLabel(const View *view, const LayoutProfiler::ViewStatistics &stats)
+        {
+            return stats.debugName.empty() ? stats.typeName + " " + viewId(view)
+                                           : stats.typeName + " \"" + stats.debugName + "\"";
+        }
+
+        double milliseconds(LayoutProfiler::Duration duration) { return duration.count() * 1000.0; }
+
+        LayoutProfiler::ViewStatistics &statisticsOf(const View *view)
+        {
+            auto &stats = data().views[view];
+            if (stats.typeName.empty()) {
+                stats.typeName = typeNameOf(view);
+            }
+            return stats;
+        }
+
+        // The frame ends with the current iteration of the dispatch queue
+        void scheduleEndOfFrame()
+        {
+            auto &profiler = data();
+            if (profiler.frameScheduled) {
+                return;
+            }
+            if (auto app = App()) {
+                profiler.frameScheduled = true;
+                app->dispatchQueue()->dispatchAsync([]() {
+                    data().frameScheduled = false;
+                    LayoutProfiler::endFrame();
+                });
+            }
+        }
+
+        const char *dirtySourceName(size_t source)
+        {
+            switch (static_cast<LayoutProfiler::DirtySource>(source)) {
+            case LayoutProfiler::DirtySource::core:
+                return "core";
+            case LayoutProfiler::DirtySource::stylesheet:
+                return "stylesheet";
+            case LayoutProfiler::DirtySource::children:
+                return "children";
+            case LayoutProfiler::DirtySource::geometry:
+                return "geometry";
+            }
+            return "unknown";
+        }
+    }
+
+    std::atomic<bool> &LayoutProfiler::enabled()
+    {
+        static std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    size_t &LayoutProfiler::thrashThreshold()
+    {
+        static size_t threshold = 2;
+        return threshold;
+    }
+
+    void LayoutProfiler::setThrashHandler(ThrashHandler handler) { data().thrashHandler = std::move(handler); }
+
+    void LayoutProfiler::setDebugName(const View *view, std::string debugName)
+    {
+        statisticsOf(view).debugName = std::move(debugName);
+    }
+
+    void LayoutProfiler::forget(const View *view)
+    {
+        auto &profiler = data();
+        profiler.views.erase(view);
+        profiler.frameLayoutCounts.erase(view);
+    }
+
+    void LayoutProfiler::endFrame()
+    {
+        auto &profiler = data();
+        if (profiler.frameLayoutCounts.empty() && profiler.frame.measureCount == 0) {
+            return;
+        }
+
+        auto &statistics = profiler.statistics;
+        statistics.frameCount++;
+        statistics.maximumLayoutsPerFrame = std::max(statistics.maximumLayoutsPerFrame, profiler.frame.layoutCount);
+        if (profiler.frame.thrashing) {
+            statistics.thrashingFrameCount++;
+        }
+
+        profiler.recentFrames.push_back(profiler.frame);
+        if (profiler.recentFrames.size() > maximumRecentFrameCount) {
+            profiler.recentFrames.pop_front();
+        }
+
+        profiler.frame = FrameStatistics{};
+        profiler.frameLayoutCounts.clear();
+    }
+
+    LayoutProfiler::ViewStatisticsMap LayoutProfiler::viewStatistics() { return data().views; }
+
+    LayoutProfiler::Statistics LayoutProfiler::statistics() { return data().statistics; }
+
+    std::vector<LayoutProfiler::FrameStatistics> LayoutProfiler::recentFrames()
+    {
+        return {data().recentFrames.begin(), data().recentFrames.end()};
+    }
+
+    void LayoutProfiler::reset()
+    {
+        auto &profiler = data();
+        for (auto &entry : profiler.views) {
+            ViewStatistics cleared;
+            cleared.typeName = std::move(entry.second.typeName);
+            cleared.debugName = std::move(entry.second.debugName);
+            entry.second = std::move(cleared);
+        }
+        profiler.statistics = Statistics{};
+        profiler.recentFrames.clear();
+        profiler.frame = FrameStatistics{};
+        profiler.frameLayoutCounts.clear();
+    }
+
+    void LayoutProfiler::recordLayout(const View *root, Duration duration)
+    {
+        if (!enabled().load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto &profiler = data();
+        auto &stats = statisticsOf(root);
+        stats.layoutCount++;
+        stats.layoutTime += duration;
+
+        profiler.statistics.layoutCount++;
+        profiler.statistics.layoutTime += duration;
+        profiler.frame.layoutCount++;
+        profiler.frame.layoutTime += duration;
+
+        size_t rootCount = ++profiler.frameLayoutCounts[root];
+        profiler.frame.maximumLayoutsPerRoot = std::max(profiler.frame.maximumLayoutsPerRoot, rootCount);
+
+        if (rootCount == thrashThreshold() + 1) {
+            profiler.frame.thrashing = true;
+            if (profiler.thrashHandler) {
+                profiler.thrashHandler(root, rootCount);
+            } else {
+                logstream() << "Layout thrash: " << viewLabel(root, stats) << " was laid out more than "
+                            << thrashThreshold() << " times in a single frame";
+            }
+        }
+
+        scheduleEndOfFrame();
+    }
+
+    void LayoutProfiler::recordMeasure(const View *view, Duration duration)
+    {
+        if (!enabled().load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto &profiler = data();
+        auto &stats = statisticsOf(view);
+        stats.measureCount++;
+        stats.measureTime += duration;
+
+        profiler.statistics.measureCount++;
+        profiler.statistics.measureTime += duration;
+        profiler.frame.measureCount++;
+        profiler.frame.measureTime += duration;
+
+        scheduleEndOfFrame();
+    }
+
+    void LayoutProfiler::recordDirty(const View *view, DirtySource source)
+    {
+        if (!enabled().load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        statisticsOf(view).dirtyCounts[static_cast<size_t>(source)]++;
+    }
+
+    std::string LayoutProfiler::toJson()
+    {
+        auto &profiler = data();
+        const auto &statistics = profiler.statistics;
+
+        json views = json::array();
+        for (const auto &[view, stats] : profiler.views) {
+            json dirty = json::object();
+            for (size_t source = 0; source < dirtySourceCount; source++) {
+                dirty[dirtySourceName(source)] = stats.dirtyCounts[source];
+            }
+            views.push_back({{"id", viewId(view)},
+                             {"type", stats.typeName},
+                             {"name", stats.debugName},
+                             {"layouts", stats.layoutCount},
+                             {"layoutTimeMs", milliseconds(stats.layoutTime)},
+                             {"measures", stats.measureCount},
+                             {"measureTimeMs", milliseconds(stats.measureTime)},
+                             {"dirty", dirty}});
+        }
+
+        json frames = json::array();
+        for (const auto &frame : profiler.recentFrames) {
+            frames.push_back({{"layouts", frame.layoutCount},
+                              {"layoutTimeMs", milliseconds(frame.layoutTime)},
+                              {"measures", frame.measureCount},
+                              {"measureTimeMs", milliseconds(frame.measureTime)},
+                              {"maximumLayoutsPerRoot", frame.maximumLayoutsPerRoot},
+                              {"thrashing", frame.thrashing}});
+        }
+
+        return json{{"frames", statistics.frameCount},
+                    {"thrashingFrames", statistics.thrashingFrameCount},
+                    {"layouts", statistics.layoutCount},
+                    {"layoutTimeMs", milliseconds(statistics.layoutTime)},
+                    {"measures", statistics.measureCount},
+                    {"measureTimeMs", milliseconds(statistics.measureTime)},
+                    {"maximumLayoutsPerFrame", statistics.maximumLayoutsPerFrame},
+                    {"views", views},
+                    {"recentFrames", frames}}
+            .dump(4);
+    }
+
+    void LayoutProfiler::logSummary(size_t viewCount)
+    {
+        auto &profiler = data();
+        const auto &statistics = profiler.statistics;
+
+        logstream() << "Layout profile: " << statistics.layoutCount << " layouts ("
+                    << milliseconds(statistics.layoutTime) << " ms), " << statistics.measureCount << " measurements ("
+                    << milliseconds(statistics.measureTime) << " ms) in " << statistics.frameCount << " frames, "
+                    << statistics.thrashingFrameCount << " thrashing, at most " << statistics.maximumLayoutsPerFrame
+                    << " layouts per frame";
+
+        std::vector<std::pair<const View *, const ViewStatistics *>> views;
+        views.reserve(profiler.views.size());
+        for (const auto &[view, stats] : profiler.views) {
+            views.emplace_back(view, &stats);
+        }
+
+        auto totalTime = [](const ViewStatistics *stats) { return stats->layoutTime + stats->measureTime; };
+        std::sort(views.begin(), views.end(),
+                  [&](const auto &a, const auto &b) { return totalTime(a.second) > totalTime(b.second); });
+
+        for (size_t i = 0; i < views.size() && i < viewCount; i++) {
+            const auto &[view, stats] = views[i];
+            logstream line;
+            line << "    " << viewLabel(view, *stats) << ": " << stats->layoutCount << " layouts ("
+                 << milliseconds(stats->layoutTime) << " ms), " << stats->measureCount << " measurements ("
+                 << milliseconds(stats->measureTime) << " ms), dirty:";
+            for (size_t source = 0; source < dirtySourceCount; source++) {
+                line << " " << dirtySourceName(source) << " " << stats->dirtyCounts[source];
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include <bdn/Rect.h>
+#include <bdn/ui/yoga/LayoutResultCache.h>
+
+#include <yoga/YGNode.h>
+
+#include <algorithm>
+
+namespace bdn::ui::yoga
+{
+    namespace
+    {
+        LayoutResultCache::Statistics s_statistics;
+    }
+
+    size_t &LayoutResultCache::capacity()
+    {
+        static size_t s_capacity = 3;
+        return s_capacity;
+    }
+
+    LayoutResultCache::Statistics LayoutResultCache::statistics() { return s_statistics; }
+
+    void LayoutResultCache::resetStatistics() { s_statistics = Statistics{}; }
+
+    void LayoutResultCache::store(Size size, uint64_t generation, YGNodeRef root)
+    {
+        // Generations only grow, results of an older one can never be restored
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+                                      [&](const Entry &entry) {
+                                          return entry.generation != generation || entry.size == size;
+                                      }),
+                       _entries.end());
+
+        if (capacity() == 0) {
+            return;
+        }
+
+        if (_entries.size() >= capacity()) {
+            auto leastRecent = std::min_element(_entries.begin(), _entries.end(), [](const auto &a, const auto &b) {
+                return a.lastUse < b.lastUse;
+            });
+            _entries.erase(leastRecent);
+        }
+
+        Entry entry{size, generation, ++_useCount, {}};
+        collect(root, entry.layouts);
+        _entries.push_back(std::move(entry));
+
+        s_statistics.storeCount++;
+    }
+
+    bool LayoutResultCache::restore(Size size, uint64_t generation, YGNodeRef root)
+    {
+        auto it = std::find_if(_entries.begin(), _entries.end(), [&](const Entry &entry) {
+            return entry.generation == generation && entry.size == size;
+        });
+
+        if (it == _entries.end()) {
+            s_statistics.missCount++;
+            return false;
+        }
+
+        s_statistics.hitCount++;
+        it->lastUse = ++_useCount;
+
+        size_t index = 0;
+        copyBack(root, it->layouts, index);
+        return true;
+    }
+
+    void LayoutResultCache::invalidate() { _entries.clear(); }
+
+    void LayoutResultCache::collect(YGNodeRef node, std::vector<YGLayout> &layouts)
+    {
+        layouts.push_back(node->getLayout());
+        for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+            collect(YGNodeGetChild(node, i), layouts);
+        }
+    }
+
+    bool LayoutResultCache::copyBack(YGNodeRef node, const std::vector<YGLayout> &layouts, size_t &index)
+    {
+        Rect previous{YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node), YGNodeLayoutGetWidth(node),
+                      YGNodeLayoutGetHeight(node)};
+
+        node->setLayout(layouts[index++]);
+        node->setDirty(false);
+
+        bool changed = previous != Rect{YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node),
+                                        YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node)};
+
+        for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+            changed = copyBack(YGNodeGetChild(node, i), layouts, index) || changed;
+        }
+
+        // Like after YGNodeCalculateLayout(), only the paths to the nodes that changed are visited
+        node->setHasNewLayout(changed);
+        return changed;
+    }
+}
@@ -0,0 +1,49 @@
+#include <bdn/ui/yoga/NodePool.h>
+
+#include <yoga/YGNode.h>
+
+namespace bdn::ui::yoga
+{
+    NodePool::~NodePool()
+    {
+        for (auto node : _freeNodes) {
+            YGNodeFree(node);
+        }
+    }
+
+    YGConfigRef NodePool::configFor(float pointScaleFactor)
+    {
+        auto it = _configs.find(pointScaleFactor);
+        if (it == _configs.end()) {
+            std::unique_ptr<YGConfig, decltype(&YGConfigFree)> config(YGConfigNew(), &YGConfigFree);
+            YGConfigCopy(config.get(), YGConfigGetDefault());
+            YGConfigSetPointScaleFactor(config.get(), pointScaleFactor);
+            it = _configs.emplace(pointScaleFactor, std::move(config)).first;
+        }
+        return it->second.get();
+    }
+
+    YGNodeRef NodePool::acquire(YGConfigRef config)
+    {
+        if (_freeNodes.empty()) {
+            _createdCount++;
+            return YGNodeNewWithConfig(config);
+        }
+
+        auto node = _freeNodes.back();
+        _freeNodes.pop_back();
+        node->setConfig(config);
+        return node;
+    }
+
+    void NodePool::release(YGNodeRef node)
+    {
+        if (_freeNodes.size() >= maximumFreeCount) {
+            YGNodeFree(node);
+            return;
+        }
+
+        YGNodeReset(node);
+        _freeNodes.push_back(node);
+    }
+}
@@ -1,20 +1,23 @@
+#include <bdn/StopWatch.h>
 #include <bdn/ui/Window.h>
+#include <bdn/ui/yoga/LayoutProfiler.h>
 #include <bdn/ui/yoga/ViewData.h>
 #include <yoga/YGNode.h>
 
+#include <utility>
+#include <vector>
+
 namespace bdn::ui::yoga
 {
-    ViewData::ViewData(View *v) : view(v), isRootNode(false), isIn(false)
+    ViewData::ViewData(View *v, NodePool &pool, float initialPointScaleFactor, bool isRoot)
+        : view(v), isRootNode(false), isIn(false), pointScaleFactor(initialPointScaleFactor), _pool(pool)
     {
-        auto config = YGConfigGetDefault();
-        config->pointScaleFactor = view->pointScaleFactor();
-
-        ygNode = YGNodeNewWithConfig(config);
+        ygNode = _pool.acquire(_pool.configFor(pointScaleFactor));
         YGNodeSetContext(ygNode, this);
 
         childrenChanged();
 
-        if (!view->parentView->lock() || view->isLayoutRoot) {
+        if (isRoot) {
             isRootNode = true;
             YGNodeSetDirtiedFunc(ygNode, &ViewData::onDirtied);
 
@@ -24,20 +27,93 @@ namespace bdn::ui::yoga
                 geometry.bind(view->geometry);
             }
 
-            geometry.onChange() += [this](auto &property) { ygNode->markDirtyAndPropogate(); };
+            geometry.onChange() += [this](auto &property) {
+                LayoutProfiler::recordDirty(view, LayoutProfiler::DirtySource::geometry);
+                ygNode->markDirtyAndPropogate();
+            };
         }
     }
 
-    ViewData::~ViewData() { YGNodeFree(ygNode); }
+    ViewData::~ViewData()
+    {
+        YGNodeSetDirtiedFunc(ygNode, nullptr);
+
+        if (auto owner = YGNodeGetOwner(ygNode)) {
+            YGNodeRemoveChild(owner, ygNode);
+        }
+
+        // The children are detached, they have to be inserted again by their next parent
+        for (int i = 0; i < YGNodeGetChildCount(ygNode); i++) {
+            if (auto childData = fromNode(YGNodeGetChild(ygNode, i))) {
+                childData->isIn = false;
+            }
+        }
+        YGNodeRemoveAllChildren(ygNode);
+
+        _pool.release(ygNode);
+    }
 
-    void ViewData::doLayout()
+    void ViewData::updatePointScaleFactor()
     {
+        if (!view->hasViewCore()) {
+            return;
+        }
+
+        auto newPointScaleFactor = view->pointScaleFactor();
+        if (newPointScaleFactor != pointScaleFactor) {
+            pointScaleFactor = newPointScaleFactor;
+            ygNode->setConfig(_pool.configFor(pointScaleFactor));
+            ygNode->markDirtyAndPropogate();
+        }
+    }
+
+    ViewData::ApplyStatistics ViewData::doLayout()
+    {
+        ApplyStatistics statistics;
         if (isRootNode) {
-            YGNodeCalculateLayout(ygNode, geometry->width, geometry->height, YGDirectionLTR);
-            yogaVisit(ygNode, &applyLayout);
+            if (auto restored = restoreLayout()) {
+                LayoutProfiler::recordLayout(view, LayoutProfiler::Duration{0});
+                return *restored;
+            }
+
+            StopWatch watch;
+            YGNodeCalculateLayout(ygNode, static_cast<float>(geometry->width), static_cast<float>(geometry->height),
+                                  YGDirectionLTR);
+            LayoutProfiler::recordLayout(view, watch.elapsed());
+
+            statistics = applyNewLayouts(ygNode);
 
             ygNode->setDirty(false);
+            layoutApplied();
+        }
+        return statistics;
+    }
+
+    std::optional<ViewData::ApplyStatistics> ViewData::restoreLayout()
+    {
+        Size size = geometry->size();
+        if (!isRootNode || laidOutGeneration == 0 || size == laidOutSize) {
+            return std::nullopt;
+        }
+
+        // Nothing changed since the last pass, so the nodes still hold its results
+        if (laidOutGeneration == generation) {
+            resultCache.store(laidOutSize, generation, ygNode);
+        }
+
+        if (!resultCache.restore(size, generation, ygNode)) {
+            return std::nullopt;
         }
+
+        auto statistics = applyNewLayouts(ygNode);
+        layoutApplied();
+        return statistics;
+    }
+
+    void ViewData::layoutApplied()
+    {
+        laidOutSize = geometry->size();
+        laidOutGeneration = generation;
     }
 
     void ViewData::onDirtied(YGNodeRef node)
@@ -48,26 +124,52 @@ namespace bdn::ui::yoga
 
     YGSize ViewData::measureFunc(YGNodeRef node, float width, YGMeasureMode widthMode, float height,
                                  YGMeasureMode heightMode)
+    {
+        if (!LayoutProfiler::enabled()) {
+            return measure(node, width, widthMode, height, heightMode);
+        }
+
+        StopWatch watch;
+        YGSize size = measure(node, width, widthMode, height, heightMode);
+        LayoutProfiler::recordMeasure(fromNode(node)->view, watch.elapsed());
+        return size;
+    }
+
+    YGSize ViewData::measure(YGNodeRef node, float width, YGMeasureMode widthMode, float height,
+                             YGMeasureMode heightMode)
     {
         auto viewData = static_cast<ViewData *>(YGNodeGetContext(node));
 
-        node->getConfig()->pointScaleFactor = viewData->view->pointScaleFactor();
+        auto pointScaleFactor = viewData->pointScaleFactor;
+
+        if (auto cached = viewData->measureCache.findSize(width, widthMode, height, heightMode, pointScaleFactor)) {
+            return *cached;
+        }
 
         Size constraintSize = Size(widthMode == YGMeasureModeUndefined ? Size::componentNone() : width,
                                    heightMode == YGMeasureModeUndefined ? Size::componentNone() : height);
 
         Size s = viewData->view->sizeForSpace(constraintSize);
 
-        return (YGSize){.width = (float)s.width, .height = (float)s.height};
+        YGSize result{.width = (float)s.width, .height = (float)s.height};
+        viewData->measureCache.storeSize(width, widthMode, height, heightMode, pointScaleFactor, result);
+        return result;
     }
 
     float ViewData::baselineFunc(YGNodeRef node, float width, float height)
     {
         auto viewData = static_cast<ViewData *>(YGNodeGetContext(node));
-        return viewData->view->baseline({width, height});
+
+        if (auto cached = viewData->measureCache.findBaseline(width, height)) {
+            return *cached;
+        }
+
+        float baseline = viewData->view->baseline({width, height});
+        viewData->measureCache.storeBaseline(width, height, baseline);
+        return baseline;
     }
 
-    void ViewData::applyLayout(YGNodeRef node, Point offset)
+    bool ViewData::applyLayout(YGNodeRef node, Point offset)
     {
         if (auto ctxt = YGNodeGetContext(node)) {
             auto viewData = static_cast<ViewData *>(ctxt);
@@ -91,26 +193,52 @@ namespace bdn::ui::yoga
             r.x += offset.x;
             r.y += offset.y;
 
-            viewData->view->geometry = r;
+            if (viewData->view->geometry.get() != r) {
+                viewData->view->geometry = r;
+                return true;
+            }
         }
+        return false;
     }
 
-    void ViewData::yogaVisit(YGNodeRef node, const std::function<void(YGNodeRef, Point)> &function, Point initialOffset)
+    ViewData::ApplyStatistics ViewData::applyNewLayouts(YGNodeRef node, Point offset)
     {
-        for (int i = 0; i < YGNodeGetChildCount(node); i++) {
-            auto child = YGNodeGetChild(node, i);
+        ApplyStatistics statistics;
+
+        // Depth first, in the order of the children, without recursion
+        std::vector<std::pair<YGNodeRef, Point>> stack;
+        auto pushChildren = [&stack](YGNodeRef parent, Point childOffset) {
+            for (auto i = YGNodeGetChildCount(parent); i > 0; i--) {
+                stack.emplace_back(YGNodeGetChild(parent, i - 1), childOffset);
+            }
+        };
+
+        YGNodeSetHasNewLayout(node, false);
+        pushChildren(node, offset);
 
-            if (auto ctxt = YGNodeGetContext(child)) {
-                auto viewData = static_cast<ViewData *>(ctxt);
+        while (!stack.empty()) {
+            auto [child, childOffset] = stack.back();
+            stack.pop_back();
 
-                if (viewData->view->isLayoutRoot) {
-                    continue;
-                }
+            if (!YGNodeGetHasNewLayout(child)) {
+                continue;
+            }
+
+            auto viewData = fromNode(child);
+            if (viewData == nullptr || viewData->view->isLayoutRoot) {
+                continue;
+            }
 
-                function(child, initialOffset);
-                yogaVisit(child, function);
+            YGNodeSetHasNewLayout(child, false);
+            statistics.visitedCount++;
+            if (applyLayout(child, childOffset)) {
+                statistics.changedCount++;
             }
+
+            pushChildren(child, Point{0, 0});
         }
+
+        return statistics;
     }
 
     void ViewData::childrenChanged(bool adding)
@@ -123,4 +251,11 @@ namespace bdn::ui::yoga
             YGNodeSetBaselineFunc(ygNode, &ViewData::baselineFunc);
         }
     }
+
+    ViewData *ViewData::fromNode(YGNodeRef node)
+    {
+        return node != nullptr ? static_cast<ViewData *>(YGNodeGetContext(node)) : nullptr;
+    }
+
+    ViewData *ViewData::ownerData() const { return fromNode(YGNodeGetOwner(ygNode)); }
 }
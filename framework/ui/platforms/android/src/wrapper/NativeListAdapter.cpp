@@ -37,8 +37,8 @@ namespace
 
         if (dataSource) {
             std::shared_ptr<bdn::ui::View> clientView;
-            if (!reusable->childViews().empty()) {
-                clientView = reusable->childViews().front();
+            if (reusable->childViewCount() > 0) {
+                clientView = reusable->childViewAt(0);
             }
 
             reusable->removeAllChildViews();
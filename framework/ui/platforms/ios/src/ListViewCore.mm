@@ -112,8 +112,8 @@
             reuse = true;
             containerView = cell.containerView;
 
-            if (!containerView->childViews().empty()) {
-                view = containerView->childViews().front();
+            if (containerView->childViewCount() > 0) {
+                view = containerView->childViewAt(0);
             }
         }
 
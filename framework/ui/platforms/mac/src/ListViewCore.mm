@@ -77,8 +77,8 @@
                 result.view = container;
             } else {
                 container = result.view;
-                if (!container->childViews().empty()) {
-                    view = container->childViews().front();
+                if (container->childViewCount() > 0) {
+                    view = container->childViewAt(0);
                 }
             }
 
@@ -0,0 +1,142 @@
+#include <bdn/Application.h>
+#include <bdn/ui/CommitPhase.h>
+#include <bdn/ui/View.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace bdn::ui
+{
+    namespace
+    {
+        struct PendingChange
+        {
+            std::weak_ptr<const View> view;
+            CommitPhase::Target target;
+            std::function<void()> apply;
+            const std::vector<size_t> *order = nullptr;
+        };
+
+        struct ChangeKey
+        {
+            const View *view;
+            CommitPhase::Target target;
+
+            bool operator==(const ChangeKey &other) const { return view == other.view && target == other.target; }
+        };
+
+        struct ChangeKeyHash
+        {
+            size_t operator()(const ChangeKey &key) const
+            {
+                return std::hash<const View *>()(key.view) ^ (static_cast<size_t>(key.target) << 1u);
+            }
+        };
+
+        std::vector<PendingChange> s_pendingChanges;
+        std::unordered_map<ChangeKey, size_t, ChangeKeyHash> s_pendingIndex;
+        bool s_flushScheduled = false;
+
+        CommitPhase::Statistics s_statistics;
+
+        // The position of views in a pre-order traversal of their trees: the ordinal of the root followed
+        // by the child indices on the path from the root. Keys are memoized for one flush, so that the
+        // ancestors that pending changes share are only looked up once.
+        class TreeOrder
+        {
+          public:
+            const std::vector<size_t> &keyOf(const View &view)
+            {
+                if (auto it = _keys.find(&view); it != _keys.end()) {
+                    return it->second;
+                }
+
+                std::vector<size_t> key;
+                if (auto parent = view.parentView.get().lock()) {
+                    key = keyOf(*parent);
+                    key.push_back(parent->indexOfChildView(view).value_or(std::numeric_limits<size_t>::max()));
+                } else {
+                    key.push_back(_rootCount++);
+                }
+                return _keys.emplace(&view, std::move(key)).first->second;
+            }
+
+          private:
+            std::unordered_map<const View *, std::vector<size_t>> _keys;
+            size_t _rootCount = 0;
+        };
+    }
+
+    bool &CommitPhase::enabled()
+    {
+        static bool s_enabled = false;
+        return s_enabled;
+    }
+
+    void CommitPhase::record(const View *view, Target target, std::function<void()> apply)
+    {
+        s_statistics.recordedCount++;
+
+        auto weakView = view->weak_from_this();
+        if (!enabled() || weakView.expired()) {
+            s_statistics.committedCount++;
+            apply();
+            return;
+        }
+
+        auto it = s_pendingIndex.find(ChangeKey{view, target});
+        if (it != s_pendingIndex.end() && !s_pendingChanges[it->second].view.expired()) {
+            s_pendingChanges[it->second].apply = std::move(apply);
+            s_statistics.elidedCount++;
+            return;
+        }
+
+        s_pendingIndex[ChangeKey{view, target}] = s_pendingChanges.size();
+        s_pendingChanges.push_back(PendingChange{std::move(weakView), target, std::move(apply)});
+
+        if (!s_flushScheduled) {
+            if (auto app = App()) {
+                s_flushScheduled = true;
+                app->dispatchQueue()->dispatchAsync([]() {
+                    s_flushScheduled = false;
+                    flush();
+                });
+            }
+        }
+    }
+
+    void CommitPhase::flush()
+    {
+        while (!s_pendingChanges.empty()) {
+            std::vector<PendingChange> pending;
+            pending.swap(s_pendingChanges);
+            s_pendingIndex.clear();
+            s_statistics.flushCount++;
+
+            TreeOrder treeOrder;
+            for (auto &change : pending) {
+                if (auto view = change.view.lock()) {
+                    change.order = &treeOrder.keyOf(*view);
+                }
+            }
+            std::stable_sort(pending.begin(), pending.end(), [](const auto &a, const auto &b) {
+                return b.order != nullptr && (a.order == nullptr || *a.order < *b.order);
+            });
+
+            for (auto &change : pending) {
+                if (!change.view.expired()) {
+                    s_statistics.committedCount++;
+                    change.apply();
+                }
+            }
+        }
+    }
+
+    bool CommitPhase::hasPendingChanges() { return !s_pendingChanges.empty(); }
+
+    CommitPhase::Statistics CommitPhase::statistics() { return s_statistics; }
+
+    void CommitPhase::resetStatistics() { s_statistics = Statistics{}; }
+}
@@ -1,5 +1,9 @@
+#include <bdn/Application.h>
 #include <bdn/ui/ContainerView.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace bdn::ui
 {
     namespace detail
@@ -14,37 +18,328 @@ namespace bdn::ui
 
     void ContainerView::addChildView(const std::shared_ptr<View> &childView)
     {
-        if (auto containerCore = core<ContainerView::Core>()) {
+        if (_updateDepth > 0) {
+            _pendingChildren.push_back(childView);
+            return;
+        }
+
+        appendChildView(childView);
+
+        if (auto containerCore = existingCore<ContainerView::Core>();
+            containerCore && isMaterialized(_children.size() - 1)) {
             containerCore->addChildView(childView);
-            View::setParentViewOfView(childView, shared_from_this());
         }
+        View::setParentViewOfView(childView, shared_from_this());
+
+        if (_virtualization) {
+            _virtualization->childrenChanged(_children.size() - 1, 1, true);
+        }
+    }
+
+    void ContainerView::appendChildView(const std::shared_ptr<View> &childView)
+    {
+        _childIndices[childView.get()] = _children.size();
+        _children.push_back(childView);
     }
 
     void ContainerView::removeChildView(const std::shared_ptr<View> &childView)
     {
-        if (auto containerCore = core<ContainerView::Core>()) {
-            containerCore->removeChildView(childView);
-            View::setParentViewOfView(childView, nullptr);
-        } else {
-            throw std::runtime_error("???");
+        if (auto pendingIt = std::find(_pendingChildren.begin(), _pendingChildren.end(), childView);
+            pendingIt != _pendingChildren.end()) {
+            _pendingChildren.erase(pendingIt);
+            return;
+        }
+
+        auto indexIt = _childIndices.find(childView.get());
+        if (indexIt == _childIndices.end()) {
+            return;
+        }
+
+        // childView might refer to the element that is erased
+        auto child = childView;
+
+        auto index = indexIt->second;
+        bool wasMaterialized = isMaterialized(index);
+        _childIndices.erase(indexIt);
+        _children.erase(_children.begin() + static_cast<std::ptrdiff_t>(index));
+        for (auto i = index; i < _children.size(); i++) {
+            _childIndices[_children[i].get()] = i;
+        }
+
+        if (_virtualization) {
+            auto &virtualization = *_virtualization;
+            if (index < virtualization.first) {
+                virtualization.first--;
+            }
+            if (index < virtualization.last) {
+                virtualization.last--;
+            }
+        }
+
+        if (auto containerCore = existingCore<ContainerView::Core>(); containerCore && wasMaterialized) {
+            containerCore->removeChildView(child);
+        }
+        View::setParentViewOfView(child, nullptr);
+
+        if (_virtualization) {
+            _virtualization->childrenChanged(index, 1, false);
         }
     }
 
     void ContainerView::removeAllChildViews()
     {
-        auto copyChildren = childViews();
+        _pendingChildren.clear();
+
+        // Removing from the back does not need to move or reindex the remaining children
+        while (!_children.empty()) {
+            removeChildView(_children.back());
+        }
+    }
+
+    void ContainerView::replaceChildViews(const std::vector<std::shared_ptr<View>> &childViews)
+    {
+        beginUpdates();
+        removeAllChildViews();
+        addChildViews(childViews);
+        endUpdates();
+    }
+
+    void ContainerView::beginUpdates() { _updateDepth++; }
+
+    void ContainerView::endUpdates()
+    {
+        if (_updateDepth == 0) {
+            throw std::logic_error("ContainerView::endUpdates() called without beginUpdates()");
+        }
 
-        for (auto &childView : copyChildren) {
-            removeChildView(childView);
+        if (--_updateDepth == 0 && !_pendingChildren.empty()) {
+            attachPendingChildViews();
         }
     }
 
-    std::vector<std::shared_ptr<View>> ContainerView::childViews() const
+    void ContainerView::attachPendingChildViews()
     {
-        if (auto containerCore = core<ContainerView::Core>()) {
-            return containerCore->childViews();
+        std::vector<std::shared_ptr<View>> pending;
+        pending.swap(_pendingChildren);
+
+        _children.reserve(_children.size() + pending.size());
+        for (const auto &childView : pending) {
+            appendChildView(childView);
+        }
+
+        auto containerCore = existingCore<ContainerView::Core>();
+        auto self = shared_from_this();
+        for (const auto &childView : pending) {
+            if (containerCore && isMaterialized(_childIndices[childView.get()])) {
+                containerCore->addChildView(childView);
+            }
+            View::setParentViewOfView(childView, self);
         }
 
-        throw std::runtime_error("???");
+        if (_virtualization) {
+            _virtualization->childrenChanged(_children.size() - pending.size(), pending.size(), true);
+        }
+
+        scheduleLayout();
+    }
+
+    std::vector<std::shared_ptr<View>> ContainerView::childViews() const { return _children; }
+
+    void ContainerView::visitChildViews(const std::function<void(View &)> &visitor) const
+    {
+        if (_virtualization) {
+            const auto &virtualization = *_virtualization;
+            visitor(*virtualization.leadingPlaceholder);
+            for (size_t i = virtualization.first; i < virtualization.last; i++) {
+                visitor(*_children[i]);
+            }
+            visitor(*virtualization.trailingPlaceholder);
+            return;
+        }
+
+        for (const auto &childView : _children) {
+            visitor(*childView);
+        }
+    }
+
+    std::optional<std::vector<std::shared_ptr<View>>::size_type>
+    ContainerView::childIndex(const std::shared_ptr<View> &child) const
+    {
+        if (auto it = _childIndices.find(child.get()); it != _childIndices.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<size_t> ContainerView::indexOfChildView(const View &child) const
+    {
+        if (_virtualization) {
+            // The position in the order of visitChildViews(), between the placeholders
+            const auto &virtualization = *_virtualization;
+            if (&child == virtualization.leadingPlaceholder.get()) {
+                return 0;
+            }
+            if (&child == virtualization.trailingPlaceholder.get()) {
+                return virtualization.last - virtualization.first + 1;
+            }
+            if (auto it = _childIndices.find(&child); it != _childIndices.end() && isMaterialized(it->second)) {
+                return it->second - virtualization.first + 1;
+            }
+            return std::nullopt;
+        }
+
+        if (auto it = _childIndices.find(&child); it != _childIndices.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    bool ContainerView::isMaterialized(size_t index) const
+    {
+        return !_virtualization || (index >= _virtualization->first && index < _virtualization->last);
+    }
+
+    void ContainerView::setVirtualization(std::shared_ptr<View> leadingPlaceholder,
+                                          std::shared_ptr<View> trailingPlaceholder,
+                                          ChildrenChangedFunction childrenChanged)
+    {
+        clearVirtualization();
+
+        _virtualization = std::make_unique<Virtualization>();
+        _virtualization->leadingPlaceholder = std::move(leadingPlaceholder);
+        _virtualization->trailingPlaceholder = std::move(trailingPlaceholder);
+        _virtualization->childrenChanged = std::move(childrenChanged);
+        _virtualization->last = _children.size();
+
+        auto self = shared_from_this();
+        View::setParentViewOfView(_virtualization->leadingPlaceholder, self);
+        View::setParentViewOfView(_virtualization->trailingPlaceholder, self);
+    }
+
+    void ContainerView::clearVirtualization()
+    {
+        if (!_virtualization) {
+            return;
+        }
+
+        auto virtualization = std::move(_virtualization);
+
+        View::setParentViewOfView(virtualization->leadingPlaceholder, nullptr);
+        View::setParentViewOfView(virtualization->trailingPlaceholder, nullptr);
+        childLayoutRegistrationChanged();
+
+        if (!hasViewCore()) {
+            return;
+        }
+
+        // Attaching the children creates their cores. The container is often cleared because it is
+        // being destroyed, so that only happens with the next iteration of the dispatch queue.
+        if (auto app = App()) {
+            std::weak_ptr<View> weakSelf = shared_from_this();
+            app->dispatchQueue()->dispatchAsync([weakSelf]() {
+                if (auto self = std::static_pointer_cast<ContainerView>(weakSelf.lock())) {
+                    self->attachMissingChildViewsToCore();
+                }
+            });
+        } else {
+            attachMissingChildViewsToCore();
+        }
+    }
+
+    void ContainerView::attachMissingChildViewsToCore()
+    {
+        auto containerCore = existingCore<ContainerView::Core>();
+        if (!containerCore) {
+            return;
+        }
+
+        std::unordered_set<const View *> attached;
+        for (const auto &child : containerCore->childViews()) {
+            attached.insert(child.get());
+        }
+
+        auto [first, last] = materializedRange();
+        for (size_t i = first; i < last; i++) {
+            if (attached.count(_children[i].get()) == 0) {
+                containerCore->insertChildView(_children[i], i - first);
+            }
+        }
+    }
+
+    void ContainerView::setMaterializedRange(size_t first, size_t last)
+    {
+        if (!_virtualization) {
+            return;
+        }
+
+        auto &virtualization = *_virtualization;
+        last = std::min(last, _children.size());
+        first = std::min(first, last);
+        if (first == virtualization.first && last == virtualization.last) {
+            return;
+        }
+
+        auto containerCore = existingCore<ContainerView::Core>();
+
+        for (size_t i = virtualization.first; i < virtualization.last; i++) {
+            if (i < first || i >= last) {
+                const auto &child = _children[i];
+                if (containerCore) {
+                    containerCore->removeChildView(child);
+                }
+                // The layouts keep data for every registered view, so the whole subtree leaves them
+                View::unregisterSubtreeFromLayouts(*child);
+                View::releaseDetachedViewCore(*child);
+            }
+        }
+
+        if (containerCore) {
+            // The core holds the materialized children in their order. When a newly materialized
+            // child is inserted, all children in [first, i) are attached already.
+            for (size_t i = first; i < last; i++) {
+                if (i < virtualization.first || i >= virtualization.last) {
+                    containerCore->insertChildView(_children[i], i - first);
+                }
+            }
+        }
+
+        virtualization.first = first;
+        virtualization.last = last;
+
+        // The newly materialized children are registered when the container is laid out next
+        childLayoutRegistrationChanged();
+    }
+
+    std::pair<size_t, size_t> ContainerView::materializedRange() const
+    {
+        if (_virtualization) {
+            return {_virtualization->first, _virtualization->last};
+        }
+        return {0, _children.size()};
+    }
+
+    void ContainerView::bindViewCore()
+    {
+        View::bindViewCore();
+
+        auto containerCore = core<ContainerView::Core>();
+        for (size_t i = 0; i < _children.size(); i++) {
+            if (isMaterialized(i)) {
+                containerCore->addChildView(_children[i]);
+            }
+        }
+    }
+
+    void ContainerView::Core::insertChildView(std::shared_ptr<View> child, size_t index)
+    {
+        // Cores that can only append move the children after index behind the new one
+        auto children = childViews();
+        for (size_t i = index; i < children.size(); i++) {
+            removeChildView(children[i]);
+        }
+        addChildView(std::move(child));
+        for (size_t i = index; i < children.size(); i++) {
+            addChildView(children[i]);
+        }
     }
 }
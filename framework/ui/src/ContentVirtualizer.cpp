@@ -0,0 +1,233 @@
+#include <bdn/ui/ContentVirtualizer.h>
+
+#include <algorithm>
+
+namespace bdn::ui
+{
+    namespace
+    {
+        size_t lowestBit(size_t i) { return i & (~i + 1); }
+    }
+
+    /** Stands in for the children before or after the materialized range. Layouts measure it like a
+        leaf view, it never gets a core.*/
+    class ContentVirtualizer::Placeholder : public View
+    {
+      public:
+        explicit Placeholder(std::shared_ptr<ViewCoreFactory> viewCoreFactory) : View(std::move(viewCoreFactory))
+        {
+            // Virtualized content usually overflows its container, the placeholders must keep their extent
+            stylesheet = JsonStringify({"flex" : {"flexShrink" : 0}});
+        }
+
+      public:
+        void setExtent(double extent, bool vertical)
+        {
+            if (extent != _extent || vertical != _vertical) {
+                _extent = extent;
+                _vertical = vertical;
+                // Makes the content's layout measure the placeholder again
+                onCoreDirty();
+            }
+        }
+
+        Size sizeForSpace(Size /*availableSpace*/) const override
+        {
+            return _vertical ? Size{0, _extent} : Size{_extent, 0};
+        }
+
+        float baseline(Size /*forSize*/) const override { return 0; }
+
+        float pointScaleFactor() const override
+        {
+            auto parent = parentView->lock();
+            return parent ? parent->pointScaleFactor() : 1.0f;
+        }
+
+      private:
+        double _extent = 0;
+        bool _vertical = true;
+    };
+
+    ContentVirtualizer::ContentVirtualizer(std::shared_ptr<ContainerView> content) : _content(std::move(content))
+    {
+        _leadingPlaceholder = std::make_shared<Placeholder>(_content->viewCoreFactory());
+        _trailingPlaceholder = std::make_shared<Placeholder>(_content->viewCoreFactory());
+
+        _extents.assign(_content->childViewCount(), 0.);
+        _measured.assign(_extents.size(), false);
+        rebuildTree();
+
+        _content->setVirtualization(
+            _leadingPlaceholder, _trailingPlaceholder,
+            [this](size_t index, size_t count, bool inserted) { childrenChanged(index, count, inserted); });
+    }
+
+    ContentVirtualizer::~ContentVirtualizer() { _content->clearVirtualization(); }
+
+    void ContentVirtualizer::update(const Rect &visibleRect, double overscan, double estimatedExtent, bool vertical)
+    {
+        _statistics.updateCount++;
+
+        bool axisChanged = vertical != _vertical;
+        if (axisChanged) {
+            // Extents along the other axis are of no use
+            _vertical = vertical;
+            std::fill(_measured.begin(), _measured.end(), false);
+        } else {
+            collectExtents();
+        }
+
+        if (axisChanged || estimatedExtent != _estimatedExtent) {
+            _estimatedExtent = estimatedExtent;
+            for (size_t i = 0; i < _extents.size(); i++) {
+                if (!_measured[i]) {
+                    _extents[i] = estimatedExtent;
+                }
+            }
+            rebuildTree();
+        }
+
+        _visibleRect = visibleRect;
+        _overscan = overscan;
+        materialize();
+    }
+
+    void ContentVirtualizer::childrenChanged(size_t index, size_t count, bool inserted)
+    {
+        if (inserted) {
+            if (index == _extents.size()) {
+                for (size_t i = 0; i < count; i++) {
+                    appendExtent(_estimatedExtent);
+                }
+            } else {
+                auto position = static_cast<std::ptrdiff_t>(index);
+                _extents.insert(_extents.begin() + position, count, _estimatedExtent);
+                _measured.insert(_measured.begin() + position, count, false);
+                rebuildTree();
+            }
+        } else {
+            if (index + count == _extents.size()) {
+                // Removing from the back leaves the tree nodes of the other children unchanged
+                _extents.resize(index);
+                _measured.resize(index);
+                _tree.resize(index + 1);
+            } else {
+                auto position = static_cast<std::ptrdiff_t>(index);
+                auto end = static_cast<std::ptrdiff_t>(index + count);
+                _extents.erase(_extents.begin() + position, _extents.begin() + end);
+                _measured.erase(_measured.begin() + position, _measured.begin() + end);
+                rebuildTree();
+            }
+        }
+
+        materialize();
+    }
+
+    void ContentVirtualizer::collectExtents()
+    {
+        auto [first, last] = _content->materializedRange();
+        for (size_t i = first; i < last && i < _extents.size(); i++) {
+            const auto &child = _content->childViewAt(i);
+            Rect geometry = child->geometry.get();
+
+            // Children that have not been laid out yet keep their estimate
+            if (!child->visible.get()) {
+                setExtent(i, 0);
+                _measured[i] = true;
+            } else if (geometry.width > 0 || geometry.height > 0) {
+                setExtent(i, _vertical ? geometry.height : geometry.width);
+                _measured[i] = true;
+            }
+        }
+    }
+
+    void ContentVirtualizer::materialize()
+    {
+        const double start = (_vertical ? _visibleRect.y : _visibleRect.x) - _overscan;
+        const double end = (_vertical ? _visibleRect.y + _visibleRect.height : _visibleRect.x + _visibleRect.width) +
+                           _overscan;
+
+        // Children that end before start are skipped, the child that contains end is included
+        size_t last = std::min(_extents.size(), countBefore(end) + 1);
+        size_t first = std::min(countBefore(start), last);
+
+        auto [oldFirst, oldLast] = _content->materializedRange();
+        size_t overlap = std::min(last, oldLast) > std::max(first, oldFirst)
+                             ? std::min(last, oldLast) - std::max(first, oldFirst)
+                             : 0;
+        _statistics.materializedCount += (last - first) - overlap;
+        _statistics.releasedCount += (oldLast - oldFirst) - overlap;
+
+        _content->setMaterializedRange(first, last);
+
+        _leadingPlaceholder->setExtent(prefix(first), _vertical);
+        _trailingPlaceholder->setExtent(totalExtent() - prefix(last), _vertical);
+    }
+
+    void ContentVirtualizer::setExtent(size_t index, double extent)
+    {
+        double delta = extent - _extents[index];
+        if (delta == 0) {
+            return;
+        }
+
+        _extents[index] = extent;
+        for (size_t i = index + 1; i < _tree.size(); i += lowestBit(i)) {
+            _tree[i] += delta;
+        }
+    }
+
+    void ContentVirtualizer::appendExtent(double extent)
+    {
+        _extents.push_back(extent);
+        _measured.push_back(false);
+
+        // The new node covers the extents (i - lowestBit(i), i]
+        size_t i = _extents.size();
+        _tree.push_back(extent + prefix(i - 1) - prefix(i - lowestBit(i)));
+    }
+
+    void ContentVirtualizer::rebuildTree()
+    {
+        _tree.assign(_extents.size() + 1, 0.);
+        for (size_t i = 1; i < _tree.size(); i++) {
+            _tree[i] += _extents[i - 1];
+            if (size_t parent = i + lowestBit(i); parent < _tree.size()) {
+                _tree[parent] += _tree[i];
+            }
+        }
+    }
+
+    double ContentVirtualizer::prefix(size_t count) const
+    {
+        double sum = 0;
+        for (size_t i = count; i > 0; i -= lowestBit(i)) {
+            sum += _tree[i];
+        }
+        return sum;
+    }
+
+    size_t ContentVirtualizer::countBefore(double offset) const
+    {
+        if (offset < 0) {
+            return 0;
+        }
+
+        size_t step = 1;
+        while (step * 2 < _tree.size()) {
+            step *= 2;
+        }
+
+        // Descends the tree to the largest count of children whose extents add up to at most offset
+        size_t position = 0;
+        double remaining = offset;
+        for (; step > 0; step /= 2) {
+            if (position + step < _tree.size() && _tree[position + step] <= remaining) {
+                position += step;
+                remaining -= _tree[position];
+            }
+        }
+        return position;
+    }
+}
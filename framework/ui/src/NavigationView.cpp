@@ -30,7 +30,7 @@ namespace bdn::ui
 
     std::vector<std::shared_ptr<View>> NavigationView::childViews() const
     {
-        if (auto navigationViewCore = core<NavigationView::Core>()) {
+        if (auto navigationViewCore = existingCore<NavigationView::Core>()) {
             return navigationViewCore->childViews();
         }
         return {};
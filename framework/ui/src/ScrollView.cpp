@@ -14,9 +14,21 @@ namespace bdn::ui
         : View(std::move(viewCoreFactory)), verticalScrollingEnabled(true)
     {
         detail::VIEW_CORE_REGISTER(ScrollView, View::viewCoreFactory());
-        contentView.onChange() += [=](auto &property) { _contentView.update(shared_from_this(), property.get()); };
+        contentView.onChange() += [=](auto &property) {
+            _contentView.update(shared_from_this(), property.get());
+            updateContentVirtualization();
+        };
+
+        virtualizeContent.onChange() += [=](auto &) { updateContentVirtualization(); };
+        visibleClientRect.onChange() += [=](auto &) { updateVirtualizedContent(); };
+        virtualizationOverscan.onChange() += [=](auto &) { updateVirtualizedContent(); };
+        estimatedChildExtent.onChange() += [=](auto &) { updateVirtualizedContent(); };
+        verticalScrollingEnabled.onChange() += [=](auto &) { updateVirtualizedContent(); };
+        horizontalScrollingEnabled.onChange() += [=](auto &) { updateVirtualizedContent(); };
     }
 
+    ScrollView::~ScrollView() = default;
+
     void ScrollView::bindViewCore()
     {
         View::bindViewCore();
@@ -25,6 +37,7 @@ namespace bdn::ui
         scrollCore->contentView.bind(contentView);
         scrollCore->horizontalScrollingEnabled.bind(horizontalScrollingEnabled);
         scrollCore->verticalScrollingEnabled.bind(verticalScrollingEnabled);
+        scrollCore->visibleClientRect.bind(visibleClientRect);
     }
 
     void ScrollView::scrollClientRectToVisible(const Rect &area)
@@ -35,6 +48,39 @@ namespace bdn::ui
         scrollCore->scrollClientRectToVisible(area);
     }
 
+    void ScrollView::updateContentVirtualization()
+    {
+        auto content = std::dynamic_pointer_cast<ContainerView>(contentView.get());
+        if (!virtualizeContent.get() || !content) {
+            _contentVirtualizer.reset();
+            return;
+        }
+
+        if (!_contentVirtualizer || _contentVirtualizer->content() != content) {
+            // The old virtualizer has to let go of its content first
+            _contentVirtualizer.reset();
+            _contentVirtualizer = std::make_unique<ContentVirtualizer>(content);
+        }
+
+        updateVirtualizedContent();
+    }
+
+    void ScrollView::updateVirtualizedContent()
+    {
+        if (!_contentVirtualizer) {
+            return;
+        }
+
+        Rect visibleRect = visibleClientRect.get();
+        if (visibleRect.width <= 0 && visibleRect.height <= 0) {
+            // Before the core reported a visible rect, assume the client area starts at the top left corner
+            visibleRect = Rect{Point{0, 0}, geometry->size()};
+        }
+
+        bool vertical = verticalScrollingEnabled.get() || !horizontalScrollingEnabled.get();
+        _contentVirtualizer->update(visibleRect, virtualizationOverscan.get(), estimatedChildExtent.get(), vertical);
+    }
+
     std::vector<std::shared_ptr<View>> ScrollView::childViews() const
     {
         assert(Application::isMainThread());
@@ -45,4 +91,11 @@ namespace bdn::ui
 
         return {};
     }
+
+    void ScrollView::visitChildViews(const std::function<void(View &)> &visitor) const
+    {
+        if (auto content = contentView.get()) {
+            visitor(*content);
+        }
+    }
 }
@@ -3,73 +3,276 @@
 
 namespace bdn::ui
 {
+    namespace
+    {
+        // Each program cycles through a few states at most, like portrait and landscape
+        constexpr size_t maximumCachedResultCount = 8;
+
+        template <class Mask> void setBit(Mask &mask, size_t index, bool value)
+        {
+            size_t word = index / 64;
+            uint64_t bit = uint64_t(1) << (index % 64);
+            if (value) {
+                if (mask.size() <= word) {
+                    mask.resize(word + 1, 0);
+                }
+                mask[word] |= bit;
+            } else if (word < mask.size()) {
+                mask[word] &= ~bit;
+            }
+        }
+
+        template <class Mask> bool testBit(const Mask &mask, size_t index)
+        {
+            size_t word = index / 64;
+            return word < mask.size() && (mask[word] & (uint64_t(1) << (index % 64))) != 0;
+        }
+
+        template <class Mask> bool contains(const Mask &mask, const Mask &required)
+        {
+            for (size_t word = 0; word < required.size(); word++) {
+                uint64_t bits = word < mask.size() ? mask[word] : 0;
+                if ((bits & required[word]) != required[word]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
     void Styler::setStyleSheet(std::shared_ptr<View> view, json json)
     {
-        _data[view] = Data{json};
-        rematchView(view);
+        if (!json.is_array()) {
+            throw std::runtime_error("Root must be an array");
+        }
+
+        auto programIt = _programs.find(json);
+        if (programIt == _programs.end()) {
+            Program program = compile(json);
+            programIt = _programs.emplace(std::move(json), std::move(program)).first;
+            index(programIt->second);
+            _statistics.compiledProgramCount++;
+        } else {
+            _statistics.sharedProgramCount++;
+        }
+
+        if (auto it = _entries.find(view.get()); it != _entries.end() && it->second != programIt) {
+            detach(view.get(), it->second);
+        }
+
+        programIt->second.views[view.get()] = view;
+        _entries[view.get()] = programIt;
+
+        if (_updateDepth > 0) {
+            _pendingViews[view.get()] = view;
+            return;
+        }
+
+        applyResult(view, programIt->second);
     }
 
     void Styler::setCondition(std::string name, std::shared_ptr<Styler::condition> condition)
     {
         _conditions[name] = condition;
-        rematchAllViews(name);
+
+        auto usersIt = _conditionUsers.find(name);
+        if (usersIt == _conditionUsers.end()) {
+            return;
+        }
+
+        // Many programs test the same values, each of them is evaluated only once
+        std::map<json, bool> results;
+        auto evaluate = [&](const json &value) {
+            auto it = results.find(value);
+            if (it == results.end()) {
+                it = results.emplace(value, (*condition)(value)).first;
+                _statistics.evaluatedConditionCount++;
+            }
+            return it->second;
+        };
+
+        // Only the tests of this condition are evaluated again, the others keep their result
+        for (Program *program : usersIt->second) {
+            for (size_t testIndex : program->testsByCondition.at(name)) {
+                setBit(program->testResults, testIndex, evaluate(program->tests[testIndex].second));
+            }
+            _pendingPrograms.insert(program);
+        }
+
+        if (_updateDepth == 0) {
+            applyPendingChanges();
+        }
     }
 
-    void Styler::rematchView(const std::shared_ptr<View> &view)
+    void Styler::beginUpdates() { _updateDepth++; }
+
+    void Styler::endUpdates()
+    {
+        if (_updateDepth == 0) {
+            throw std::logic_error("Styler::endUpdates() called without beginUpdates()");
+        }
+
+        if (--_updateDepth == 0) {
+            applyPendingChanges();
+        }
+    }
+
+    void Styler::applyPendingChanges()
     {
-        auto it = _data.find(view);
-        if (it != _data.end()) {
-            json result;
+        std::unordered_set<Program *> programs;
+        programs.swap(_pendingPrograms);
+        std::unordered_map<const View *, std::weak_ptr<View>> views;
+        views.swap(_pendingViews);
+
+        for (Program *program : programs) {
+            if (updateResult(*program)) {
+                views.insert(program->views.begin(), program->views.end());
+            }
+        }
 
-            if (!it->second.json.is_array()) {
-                throw std::runtime_error("Root must be an array");
+        std::vector<std::shared_ptr<View>> changedViews;
+        changedViews.reserve(views.size());
+        for (const auto &[viewPointer, weakView] : views) {
+            if (auto view = weakView.lock()) {
+                changedViews.push_back(std::move(view));
+                continue;
             }
 
-            for (auto &option : it->second.json.items()) {
-                if (option.value().count("if") == 0) {
-                    result.merge_patch(option.value());
+            // The address may already belong to a new view with a stylesheet of its own
+            if (auto it = _entries.find(viewPointer); it != _entries.end()) {
+                auto programIt = it->second;
+                if (programIt->second.views.at(viewPointer).expired()) {
+                    _entries.erase(it);
+                    detach(viewPointer, programIt);
+                }
+            }
+        }
+
+        // Assigning a stylesheet can call back into the styler, so the index is not iterated anymore
+        for (const auto &view : changedViews) {
+            if (auto it = _entries.find(view.get()); it != _entries.end()) {
+                _statistics.rematchedViewCount++;
+                applyResult(view, it->second->second);
+            }
+        }
+    }
+
+    Styler::Program Styler::compile(const json &stylesheet)
+    {
+        Program program;
+        std::map<std::pair<std::string, json>, size_t> testIndices;
+
+        for (const auto &option : stylesheet) {
+            if (option.count("if") == 0) {
+                if (program.patches.empty()) {
+                    program.base.merge_patch(option);
                 } else {
-                    auto &v_if = option.value().at("if");
+                    program.patches.push_back(Patch{{}, option});
+                }
+                continue;
+            }
+
+            Patch patch{{}, option};
+            patch.values.erase("if");
 
-                    bool doesMatch = true;
+            for (auto &matches : option.at("if").items()) {
+                auto matcher = _conditions.find(matches.key());
 
-                    for (auto &matches : v_if.items()) {
-                        auto matcher = _conditions.find(matches.key());
+                if (matcher == _conditions.end()) {
+                    throw std::runtime_error("Invalid matcher specified");
+                }
+
+                auto [it, inserted] = testIndices.emplace(std::make_pair(matches.key(), matches.value()),
+                                                          program.tests.size());
+                if (inserted) {
+                    program.tests.push_back(it->first);
+                    program.testsByCondition[matches.key()].push_back(it->second);
+                    setBit(program.testResults, it->second, (*matcher->second)(matches.value()));
+                    _statistics.evaluatedConditionCount++;
+                }
 
-                        if (matcher == _conditions.end()) {
-                            throw std::runtime_error("Invalid matcher specified");
-                        }
+                setBit(patch.required, it->second, true);
+            }
 
-                        it->second.usedMatchers.insert(matches.key());
+            program.patches.push_back(std::move(patch));
+        }
 
-                        if (!(*matcher->second)(matches.value())) {
-                            doesMatch = false;
-                        }
-                    }
+        updateResult(program);
+        return program;
+    }
 
-                    if (doesMatch) {
-                        result.merge_patch(option.value());
-                    }
+    void Styler::index(Program &program)
+    {
+        for (const auto &[conditionName, testIndices] : program.testsByCondition) {
+            _conditionUsers[conditionName].insert(&program);
+        }
+    }
+
+    void Styler::unindex(Program &program)
+    {
+        for (const auto &[conditionName, testIndices] : program.testsByCondition) {
+            if (auto it = _conditionUsers.find(conditionName); it != _conditionUsers.end()) {
+                it->second.erase(&program);
+                if (it->second.empty()) {
+                    _conditionUsers.erase(it);
                 }
             }
+        }
+    }
 
-            view->stylesheet = result;
+    void Styler::detach(const View *view, Programs::iterator programIt)
+    {
+        programIt->second.views.erase(view);
+        if (programIt->second.views.empty()) {
+            _pendingPrograms.erase(&programIt->second);
+            unindex(programIt->second);
+            _programs.erase(programIt);
         }
     }
 
-    void Styler::rematchAllViews(const std::string &matcherName)
+    bool Styler::updateResult(Program &program)
     {
-        for (auto it = _data.begin(); it != _data.end();) {
-            if (it->second.usedMatchers.find(matcherName) != it->second.usedMatchers.end()) {
-                if (auto view = it->first.lock()) {
-                    rematchView(view);
-                } else {
-                    it = _data.erase(it);
-                    continue;
+        Mask matchingPatches;
+        for (size_t i = 0; i < program.patches.size(); i++) {
+            if (contains(program.testResults, program.patches[i].required)) {
+                setBit(matchingPatches, i, true);
+            }
+        }
+
+        if (program.result != nullptr && matchingPatches == program.matchingPatches) {
+            return false;
+        }
+        program.matchingPatches = std::move(matchingPatches);
+
+        auto it = program.results.find(program.matchingPatches);
+        if (it == program.results.end()) {
+            if (program.results.size() >= maximumCachedResultCount) {
+                program.results.clear();
+            }
+
+            json result = program.base;
+            for (size_t i = 0; i < program.patches.size(); i++) {
+                if (testBit(program.matchingPatches, i)) {
+                    result.merge_patch(program.patches[i].values);
                 }
             }
 
-            ++it;
+            it = program.results.emplace(program.matchingPatches, std::move(result)).first;
+            _statistics.mergedResultCount++;
+        }
+
+        program.result = &it->second;
+        return true;
+    }
+
+    void Styler::applyResult(const std::shared_ptr<View> &view, const Program &program)
+    {
+        if (view->stylesheet.get() == *program.result) {
+            _statistics.unchangedStylesheetCount++;
+            return;
         }
+
+        _statistics.assignedStylesheetCount++;
+        view->stylesheet = *program.result;
     }
 }
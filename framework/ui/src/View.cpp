@@ -1,11 +1,46 @@
+#include <bdn/ui/CommitPhase.h>
 #include <bdn/ui/UIApplicationController.h>
 #include <bdn/ui/View.h>
 #include <bdn/ui/ViewCoreFactory.h>
 
+#include <atomic>
+#include <tuple>
 #include <utility>
 
 namespace bdn::ui
 {
+    namespace
+    {
+        // Incremented whenever a layout is assigned or the hierarchy changes. Views cache the layout
+        // they inherit together with the generation it was looked up in.
+        std::atomic<uint64_t> s_layoutGeneration{1};
+
+        // Changes of the core reach the view directly, changes of the view go through the CommitPhase.
+        // Both directions are plain subscriptions, so that releasing the core leaves nothing behind.
+        template <class T>
+        auto bindThroughCommitPhase(const View *view, Property<T> &viewProperty, const std::shared_ptr<View::Core> &core,
+                                    Property<T> View::Core::*coreMember, CommitPhase::Target target)
+        {
+            (core.get()->*coreMember) = viewProperty.get();
+
+            auto coreSubscription = (core.get()->*coreMember).onChange().subscribe([&viewProperty](auto &property) {
+                viewProperty = property.get();
+            });
+
+            std::weak_ptr<View::Core> weakCore = core;
+            auto viewSubscription =
+                viewProperty.onChange().subscribe([view, weakCore, coreMember, target](auto &property) {
+                    CommitPhase::record(view, target, [weakCore, coreMember, value = property.get()]() {
+                        if (auto core = weakCore.lock()) {
+                            (core.get()->*coreMember) = value;
+                        }
+                    });
+                });
+
+            return std::make_pair(viewSubscription, coreSubscription);
+        }
+    }
+
     bool &View::debugViewEnabled()
     {
         static bool s_debugViewEnabled = false;
@@ -18,6 +53,12 @@ namespace bdn::ui
         return s_debugViewBaselineEnabled;
     }
 
+    bool &View::releaseCoresOnDetach()
+    {
+        static bool s_releaseCoresOnDetach = false;
+        return s_releaseCoresOnDetach;
+    }
+
     View::View(std::shared_ptr<ViewCoreFactory> viewCoreFactory)
         : _viewCoreFactory(viewCoreFactory ? std::move(viewCoreFactory)
                                            : UIApplicationController::ViewCoreFactoryStack::top())
@@ -27,85 +68,225 @@ namespace bdn::ui
         }
 
         stylesheet.onChange() += [=](auto &property) {
-            updateFromStylesheet();
-            if (auto layout = _layout.get()) {
-                layout->updateStylesheet(this);
+            if (hasViewCore()) {
+                updateFromStylesheet();
+            }
+            if (_registeredLayout) {
+                _registeredLayout->updateStylesheet(this);
+            }
+            if (_parentLayout) {
+                _parentLayout->updateStylesheet(this);
             }
         };
 
-        isLayoutRoot.onChange() += [=](auto) { updateLayout(_layout.get(), _layout.get()); };
+        isLayoutRoot.onChange() += [=](auto) {
+            if (auto layout = _registeredLayout) {
+                layout->unregisterView(this);
+                layout->registerView(this);
+            }
+        };
 
         visible.onChange() += [=](auto) {
-            if (auto layout = _layout.get()) {
-                layout->updateStylesheet(this);
+            if (_registeredLayout) {
+                _registeredLayout->updateVisibility(this);
+            }
+            if (_parentLayout) {
+                _parentLayout->updateVisibility(this);
             }
         };
-
-        registerCoreCreatingProperties(this, &visible, &geometry, &stylesheet);
     }
 
     View::~View()
     {
-        if (auto layout = _layout.get()) {
-            layout->unregisterView(this);
+        unsubscribeFromCore();
+        if (_registeredLayout) {
+            _registeredLayout->unregisterView(this);
+        }
+        if (_parentLayout) {
+            _parentLayout->unregisterView(this);
         }
     }
 
     void View::setLayout(std::shared_ptr<Layout> layout)
     {
-        auto oldLayout = _layout.set(std::move(layout));
-        updateLayout(oldLayout, _layout.get());
+        if (layout != _ownLayout) {
+            _ownLayout = std::move(layout);
+            layoutChanged();
+        }
     }
 
     void View::setFallbackLayout(std::shared_ptr<Layout> layout)
     {
-        auto oldLayout = _layout.setFallback(std::move(layout));
+        if (layout != _fallbackLayout) {
+            _fallbackLayout = std::move(layout);
+            layoutChanged();
+        }
+    }
 
-        updateLayout(oldLayout, _layout.get());
+    void View::layoutChanged()
+    {
+        s_layoutGeneration++;
+
+        // Registration happens when the view is laid out next. The children inherit the layout.
+        _layoutSyncAllChildren = true;
+        markLayoutSyncPending();
+        scheduleLayout();
     }
 
-    void View::updateLayout(const std::shared_ptr<Layout> &oldLayout, const std::shared_ptr<Layout> &newLayout)
+    void View::markLayoutSyncPending()
     {
-        if (oldLayout == newLayout) {
-            return;
+        // Each pending view is recorded with its parent, so that the next pass only visits the path
+        // to it. A pending view always has pending ancestors, so we can stop at the first one.
+        for (View *view = this; !view->_layoutSyncPending;) {
+            view->_layoutSyncPending = true;
+
+            auto parent = view->parentView.get().lock();
+            if (!parent) {
+                break;
+            }
+            parent->_pendingLayoutChildren.push_back(view->weak_from_this());
+            view = parent.get();
         }
+    }
 
-        if (oldLayout) {
-            oldLayout->unregisterView(this);
+    void View::markChildLayoutSyncPending(const std::shared_ptr<View> &child)
+    {
+        _pendingLayoutChildren.push_back(child);
+        markLayoutSyncPending();
+        if (_registeredLayout) {
+            _registeredLayout->markDirty(this);
         }
+    }
 
-        if (newLayout) {
-            newLayout->registerView(this);
+    std::shared_ptr<Layout> View::getLayout()
+    {
+        if (_ownLayout) {
+            return _ownLayout;
         }
 
-        if (oldLayout != newLayout) {
-            viewCore()->setLayout(newLayout);
+        auto generation = s_layoutGeneration.load();
+        if (_inheritedLayoutGeneration != generation) {
+            auto parent = parentView.get().lock();
+            _inheritedLayout = parent ? parent->getLayout() : nullptr;
+            if (!_inheritedLayout) {
+                _inheritedLayout = _fallbackLayout;
+            }
+            _inheritedLayoutGeneration = generation;
+        }
+
+        return _inheritedLayout;
+    }
+
+    void View::ensureLayoutRegistration()
+    {
+        auto layout = getLayout();
+
+        if (layout != _registeredLayout) {
+            if (_registeredLayout) {
+                _registeredLayout->unregisterView(this);
+            }
+            _registeredLayout = layout;
+            if (layout) {
+                layout->registerView(this);
+            }
+            if (_core) {
+                _core->setLayout(layout);
+            }
+
+            // Descendants are still registered with the old layout
+            _layoutSyncPending = true;
+            _layoutSyncAllChildren = true;
+        }
+
+        // Layouts and parents only change together with the generation
+        if (auto generation = s_layoutGeneration.load(); generation != _parentLayoutGeneration) {
+            _parentLayoutGeneration = generation;
+
+            auto parent = parentView.get().lock();
+            auto parentLayout = parent ? parent->getLayout() : nullptr;
+            if (parentLayout == layout) {
+                parentLayout = nullptr;
+            }
+            if (parentLayout != _parentLayout) {
+                if (_parentLayout) {
+                    _parentLayout->unregisterView(this);
+                }
+                _parentLayout = std::move(parentLayout);
+                if (_parentLayout) {
+                    _parentLayout->registerView(this);
+                }
+            }
+        }
+
+        if (!_layoutSyncPending) {
+            return;
+        }
+        _layoutSyncPending = false;
+
+        bool allChildren = std::exchange(_layoutSyncAllChildren, false);
+        auto pendingChildren = std::exchange(_pendingLayoutChildren, {});
+
+        if (layout) {
+            layout->beginUpdates(this);
+        }
+        if (allChildren) {
+            visitChildViews([](View &child) { child.ensureLayoutRegistration(); });
+        } else {
+            // Children that were removed or are not visited anymore in the meantime are skipped
+            for (const auto &weakChild : pendingChildren) {
+                if (auto child = weakChild.lock(); child && indexOfChildView(*child)) {
+                    child->ensureLayoutRegistration();
+                }
+            }
+        }
+        if (layout) {
+            layout->endUpdates(this);
         }
+    }
 
+    void View::visitChildViews(const std::function<void(View &)> &visitor) const
+    {
         for (const auto &child : childViews()) {
-            child->setFallbackLayout(newLayout);
+            visitor(*child);
         }
     }
 
-    std::shared_ptr<Layout> View::getLayout() { return _layout.get(); }
+    std::optional<size_t> View::indexOfChildView(const View &child) const
+    {
+        std::optional<size_t> result;
+        size_t index = 0;
+        visitChildViews([&](View &childView) {
+            if (&childView == &child) {
+                result = index;
+            }
+            index++;
+        });
+        return result;
+    }
 
     void View::updateFromStylesheet()
     {
         if (auto core = viewCore()) {
+            std::optional<Color> backgroundColor;
             if (stylesheet->count("background-color")) {
-                core->backgroundColor = stylesheet->at("background-color");
-            } else {
-                core->backgroundColor = std::nullopt;
+                backgroundColor = stylesheet->at("background-color").get<Color>();
             }
 
+            std::weak_ptr<View::Core> weakCore = core;
+            CommitPhase::record(this, CommitPhase::Target::backgroundColor, [weakCore, backgroundColor]() {
+                if (auto core = weakCore.lock()) {
+                    core->backgroundColor = backgroundColor;
+                }
+            });
+
             core->updateFromStylesheet(stylesheet.get());
         }
     }
 
     void View::scheduleLayout()
     {
-        if (auto core = viewCore()) {
-            core->scheduleLayout();
+        if (_core) {
+            _core->scheduleLayout();
         } else {
             _hasLayoutSchedulePending = true;
         }
@@ -122,8 +303,43 @@ namespace bdn::ui
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
         auto un_const_this = const_cast<View *>(this);
 
+        // The core belongs to the same arena as the view, even if another one is active now
+        MemoryArena::Scope scope(_memoryArena);
         _core = _viewCoreFactory->createViewCore(typeInfoForCoreCreation());
+
+        // Replay the state that accumulated while the view had no core
         un_const_this->bindViewCore();
+        if (auto layout = un_const_this->getLayout()) {
+            _core->setLayout(layout);
+        }
+        if (!stylesheet->is_null()) {
+            un_const_this->updateFromStylesheet();
+        }
+        if (_hasLayoutSchedulePending) {
+            un_const_this->_hasLayoutSchedulePending = false;
+            _core->scheduleLayout();
+        }
+    }
+
+    void View::releaseViewCore()
+    {
+        assert(parentView.get().lock() == nullptr || !parentView.get().lock()->hasViewCore());
+        releaseDetachedViewCore(*this);
+    }
+
+    void View::releaseDetachedViewCore(View &view)
+    {
+        if (!view._core) {
+            return;
+        }
+
+        // The children are attached to the core that is released with them
+        view.visitChildViews([](View &child) { releaseDetachedViewCore(child); });
+
+        view.unsubscribeFromCore();
+        view._layoutCallbackReceiver.reset();
+        view._dirtyCallbackReceiver.reset();
+        view._core.reset();
     }
 
     std::shared_ptr<View::Core> View::viewCore()
@@ -140,41 +356,123 @@ namespace bdn::ui
 
     void View::bindViewCore()
     {
-        viewCore()->visible.bind(visible);
-        viewCore()->geometry.bind(geometry);
+        unsubscribeFromCore();
+        std::tie(_visibleSubscription, _coreVisibleSubscription) =
+            bindThroughCommitPhase(this, visible, viewCore(), &View::Core::visible, CommitPhase::Target::visible);
+        std::tie(_geometrySubscription, _coreGeometrySubscription) =
+            bindThroughCommitPhase(this, geometry, viewCore(), &View::Core::geometry, CommitPhase::Target::geometry);
 
         _layoutCallbackReceiver = viewCore()->_layoutCallback.set([=]() { onCoreLayout(); });
         _dirtyCallbackReceiver = viewCore()->_dirtyCallback.set([=]() { onCoreDirty(); });
     }
 
+    void View::unsubscribeFromCore()
+    {
+        if (_visibleSubscription) {
+            visible.onChange().unsubscribe(_visibleSubscription);
+            _visibleSubscription.reset();
+        }
+        if (_geometrySubscription) {
+            geometry.onChange().unsubscribe(_geometrySubscription);
+            _geometrySubscription.reset();
+        }
+        if (_core && _coreVisibleSubscription) {
+            _core->visible.onChange().unsubscribe(_coreVisibleSubscription);
+        }
+        if (_core && _coreGeometrySubscription) {
+            _core->geometry.onChange().unsubscribe(_coreGeometrySubscription);
+        }
+        _coreVisibleSubscription.reset();
+        _coreGeometrySubscription.reset();
+    }
+
     void View::setParentViewOfView(const std::shared_ptr<View> &view, const std::shared_ptr<View> &parentView)
     {
         assert(view->parentView.get().lock() == nullptr || parentView == nullptr);
 
         view->internalParentView = parentView;
+        s_layoutGeneration++;
 
         if (parentView) {
-            view->setFallbackLayout(parentView->getLayout());
+            // The view is registered with the layout when the parent is laid out next. Marking the
+            // parent dirty makes sure that this happens.
+            parentView->markChildLayoutSyncPending(view);
         } else {
-            view->setFallbackLayout(nullptr);
+            // Only the view itself leaves the layout. Its descendants stay registered, so moving a
+            // subtree does not register it again.
+            unregisterFromLayouts(*view);
+
+            // The former parent removed the view from its core before detaching it, so the core is
+            // released unconditionally
+            if (releaseCoresOnDetach()) {
+                releaseDetachedViewCore(*view);
+            }
+        }
+    }
+
+    void View::unregisterFromLayouts(View &view)
+    {
+        if (view._registeredLayout) {
+            view._registeredLayout->unregisterView(&view);
+            view._registeredLayout = nullptr;
+        }
+        if (view._parentLayout) {
+            view._parentLayout->unregisterView(&view);
+            view._parentLayout = nullptr;
+        }
+        // The next pass registers the view with its parent's layout again
+        view._parentLayoutGeneration = 0;
+    }
+
+    void View::unregisterSubtreeFromLayouts(View &view)
+    {
+        // Descendants first, so that their nodes leave their parents' nodes before those are released
+        view.visitChildViews([](View &child) { unregisterSubtreeFromLayouts(child); });
+        unregisterFromLayouts(view);
+    }
+
+    void View::childLayoutRegistrationChanged()
+    {
+        _layoutSyncAllChildren = true;
+        markLayoutSyncPending();
+        if (_registeredLayout) {
+            _registeredLayout->markDirty(this);
         }
     }
 
     void View::onCoreLayout()
     {
         if (auto layout = getLayout()) {
+            ensureLayoutRegistration();
             layout->layout(this);
         }
     }
 
     void View::onCoreDirty()
     {
-        if (auto layout = getLayout()) {
-            layout->markDirty(this);
+        if (_registeredLayout) {
+            _registeredLayout->markDirty(this);
+        }
+        invalidateSizeInParentLayout();
+    }
+
+    void View::invalidateSizeInParentLayout()
+    {
+        if (_parentLayout) {
+            _parentLayout->markDirty(this);
         }
     }
 
-    Size View::sizeForSpace(Size availableSpace) const { return viewCore()->sizeForSpace(availableSpace); }
+    Size View::sizeForSpace(Size availableSpace) const
+    {
+        // A view that uses a different layout than its parent is sized by its own layout
+        if (_parentLayout && _registeredLayout) {
+            if (auto size = _registeredLayout->sizeForSpace(*this, availableSpace)) {
+                return *size;
+            }
+        }
+        return viewCore()->sizeForSpace(availableSpace);
+    }
 
     float View::baseline(Size forSize) const { return viewCore()->baseline(forSize); }
 
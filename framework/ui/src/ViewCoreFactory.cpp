@@ -2,15 +2,69 @@
 
 namespace bdn::ui
 {
-    std::shared_ptr<View::Core> ViewCoreFactory::createViewCore(const std::type_info &viewType)
+    namespace
     {
-        auto core = create(viewType.name(), shared_from_this());
+        template <class Entry> bool typeLess(const Entry &entry, const std::type_index &type)
+        {
+            return entry.first < type;
+        }
+    }
 
-        if (!core) {
+    ViewCoreFactory::ViewCoreFactory() { publish(std::make_unique<Registry>()); }
+
+    std::shared_ptr<View::Core> ViewCoreFactory::createViewCore(const std::type_info &viewType)
+    {
+        const auto &constructors = _registry.load(std::memory_order_acquire)->coreConstructors;
+        std::type_index type(viewType);
+        auto it = std::lower_bound(constructors.begin(), constructors.end(), type,
+                                   typeLess<std::pair<std::type_index, CoreConstructor>>);
+        if (it == constructors.end() || it->first != type) {
             throw ViewCoreTypeNotSupportedError(viewType.name());
         }
 
-        return *core;
+        return it->second(shared_from_this());
+    }
+
+    bool ViewCoreFactory::registerCoreConstructor(const std::type_info &viewType, CoreConstructor constructor)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        const auto &constructors = _registry.load(std::memory_order_relaxed)->coreConstructors;
+        std::type_index type(viewType);
+        auto it = std::lower_bound(constructors.begin(), constructors.end(), type,
+                                   typeLess<std::pair<std::type_index, CoreConstructor>>);
+        if (it != constructors.end() && it->first == type) {
+            return false;
+        }
+
+        auto registry = std::make_unique<Registry>(*_registry.load(std::memory_order_relaxed));
+        registry->coreConstructors.emplace(registry->coreConstructors.begin() + (it - constructors.begin()), type,
+                                           constructor);
+        publish(std::move(registry));
+        return true;
+    }
+
+    void ViewCoreFactory::registerOnceLocked(const void *key, RegisterFunction registerFunction)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        const auto &keys = _registry.load(std::memory_order_relaxed)->keys;
+        if (std::binary_search(keys.begin(), keys.end(), key)) {
+            return;
+        }
+
+        registerFunction(shared_from_this());
+
+        // The key is published after the constructors, so a reader that sees it finds them as well
+        auto registry = std::make_unique<Registry>(*_registry.load(std::memory_order_relaxed));
+        registry->keys.insert(std::upper_bound(registry->keys.begin(), registry->keys.end(), key), key);
+        publish(std::move(registry));
+    }
+
+    void ViewCoreFactory::publish(std::unique_ptr<Registry> registry)
+    {
+        _registry.store(registry.get(), std::memory_order_release);
+        _registries.push_back(std::move(registry));
     }
 
     ViewCoreFactory::ContextStack *ViewCoreFactory::contextStack()
@@ -0,0 +1,55 @@
+#include <bdn/Application.h>
+#include <bdn/ui/UIApplicationController.h>
+#include <bdn/ui/ViewCoreFactory.h>
+#include <bdn/ui/ViewTreeBuilder.h>
+
+#include <exception>
+#include <utility>
+
+namespace bdn::ui
+{
+    void buildViewTreeAsync(const std::shared_ptr<DispatchQueue> &workerQueue, ViewTreeBuildFunction build,
+                            ViewTreeAttachFunction attach, std::shared_ptr<ViewCoreFactory> viewCoreFactory)
+    {
+        if (!viewCoreFactory) {
+            viewCoreFactory = UIApplicationController::ViewCoreFactoryStack::top();
+        }
+
+        auto mainQueue = App()->dispatchQueue();
+
+        // Arenas are not synchronized, so the worker builds into an arena of its own. The tree keeps
+        // it alive once it is handed to the main thread.
+        std::shared_ptr<MemoryArena> arena;
+        if (auto *callerArena = MemoryArena::active()) {
+            arena = MemoryArena::create(callerArena->kind());
+        }
+
+        workerQueue->dispatchAsync([mainQueue, arena, viewCoreFactory, build = std::move(build),
+                                    attach = std::move(attach)]() mutable {
+            std::shared_ptr<View> root;
+            std::exception_ptr error;
+
+            // The factory stack is thread local, so the worker needs its own entry
+            UIApplicationController::ViewCoreFactoryStack::push(std::move(viewCoreFactory));
+            try {
+                MemoryArena::Scope scope(arena);
+                root = build();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            UIApplicationController::ViewCoreFactoryStack::pop();
+
+            mainQueue->dispatchAsync([root = std::move(root), error, attach = std::move(attach)]() {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+
+                if (root) {
+                    root->viewCore();
+                }
+                attach(root);
+            });
+        });
+    }
+}
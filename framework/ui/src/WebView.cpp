@@ -13,8 +13,11 @@ namespace bdn::ui
     {
         detail::VIEW_CORE_REGISTER(WebView, View::viewCoreFactory());
 
-        registerCoreCreatingProperties(this, &url);
-        url.onChange() += [this](auto) { loadURL(url); };
+        url.onChange() += [this](auto) {
+            if (hasViewCore()) {
+                loadURL(url);
+            }
+        };
     }
 
     void WebView::loadURL(const std::string &url)
@@ -30,5 +33,9 @@ namespace bdn::ui
         auto webViewCore = core<WebView::Core>();
         webViewCore->redirectHandler.bind(redirectHandler, BindMode::unidirectional);
         webViewCore->userAgent.bind(userAgent);
+
+        if (!url->empty()) {
+            webViewCore->loadURL(url);
+        }
     }
 }
@@ -62,6 +62,13 @@ namespace bdn::ui
         return {};
     }
 
+    void Window::visitChildViews(const std::function<void(View &)> &visitor) const
+    {
+        if (auto content = contentView.get()) {
+            visitor(*content);
+        }
+    }
+
     void Window::bindViewCore()
     {
         View::bindViewCore();
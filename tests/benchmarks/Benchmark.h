@@ -0,0 +1,39 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <chrono>
+#include <string>
+
+namespace bdn::benchmark
+{
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    /** Runs function the given number of times and returns the average duration of a single run.*/
+    template <class Function> Duration measure(size_t iterations, Function &&function)
+    {
+        StopWatch watch;
+        for (size_t i = 0; i < iterations; i++) {
+            function();
+        }
+        return Duration(watch.elapsed()) / static_cast<double>(iterations > 0 ? iterations : 1);
+    }
+
+    /** Logs a benchmark result and records it as a property of the current test, so that it shows
+        up in the gtest XML output.*/
+    inline void report(const std::string &name, Duration duration, const std::string &details = std::string())
+    {
+        bdn::logstream() << "[benchmark] " << name << ": " << duration.count() << " ms"
+                         << (details.empty() ? "" : " (" + details + ")");
+        ::testing::Test::RecordProperty(name, std::to_string(duration.count()));
+    }
+
+    inline void report(const std::string &name, size_t count)
+    {
+        bdn::logstream() << "[benchmark] " << name << ": " << count;
+        ::testing::Test::RecordProperty(name, std::to_string(count));
+    }
+}
@@ -0,0 +1,141 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        std::vector<std::shared_ptr<View>> makeChildren(const std::shared_ptr<ui::ViewCoreFactory> &factory,
+                                                        size_t count)
+        {
+            std::vector<std::shared_ptr<View>> children;
+            children.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                auto label = std::make_shared<Label>(factory);
+                label->text = "Child " + std::to_string(i);
+                children.push_back(label);
+            }
+            return children;
+        }
+
+        template <class Add> void benchmarkAddChildren(const std::string &name, Add &&add)
+        {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            for (size_t count : std::initializer_list<size_t>{10, 100, 1000, 10000}) {
+                auto container = std::make_shared<ContainerView>(factory);
+                container->setLayout(std::make_shared<yoga::Layout>());
+                container->viewCore();
+                auto children = makeChildren(factory, count);
+
+                auto duration = benchmark::measure(1, [&]() { add(container, children); });
+                benchmark::report(name + "." + std::to_string(count), duration, std::to_string(count) + " children");
+            }
+        }
+    }
+
+    TEST(BenchmarkContainerView, AddChildren)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            benchmarkAddChildren("AddChildView", [](auto &container, auto &children) {
+                for (auto &child : children) {
+                    container->addChildView(child);
+                }
+            });
+
+            benchmarkAddChildren("AddChildViews",
+                                 [](auto &container, auto &children) { container->addChildViews(children); });
+        });
+    }
+
+    TEST(BenchmarkContainerView, ChildIteration)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t wideChildCount = 10000;
+            constexpr size_t deepLevelCount = 1000;
+            constexpr size_t iterations = 100;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            auto wide = std::make_shared<ContainerView>(factory);
+            wide->addChildViews(makeChildren(factory, wideChildCount));
+
+            auto deep = std::make_shared<ContainerView>(factory);
+            auto level = deep;
+            for (size_t i = 0; i < deepLevelCount; i++) {
+                auto next = std::make_shared<ContainerView>(factory);
+                level->addChildView(next);
+                level = next;
+            }
+
+            const std::string wideDetails = std::to_string(wideChildCount) + " children";
+            const std::string deepDetails = std::to_string(deepLevelCount) + " levels";
+
+            size_t visible = 0;
+            auto copying = benchmark::measure(iterations, [&]() {
+                for (auto &child : wide->childViews()) {
+                    visible += child->visible.get() ? 1 : 0;
+                }
+            });
+            benchmark::report("ChildIteration.Wide.ChildViews", copying, wideDetails);
+
+            auto visiting = benchmark::measure(iterations, [&]() {
+                wide->visitChildViews([&](View &child) { visible += child.visible.get() ? 1 : 0; });
+            });
+            benchmark::report("ChildIteration.Wide.VisitChildViews", visiting, wideDetails);
+
+            auto last = wide->childViewAt(wideChildCount - 1);
+            auto index = benchmark::measure(iterations, [&]() { visible += *wide->childIndex(last); });
+            benchmark::report("ChildIteration.Wide.ChildIndex", index, wideDetails);
+
+            std::function<void(View &)> countDeep = [&](View &view) {
+                visible++;
+                view.visitChildViews(countDeep);
+            };
+            auto deepVisit = benchmark::measure(iterations, [&]() { countDeep(*deep); });
+            benchmark::report("ChildIteration.Deep.VisitChildViews", deepVisit, deepDetails);
+
+            // Fallback layout propagation walks the whole tree
+            auto layout = std::make_shared<yoga::Layout>();
+            auto propagate = benchmark::measure(1, [&]() {
+                deep->setLayout(layout);
+                deep->setLayout(nullptr);
+            });
+            benchmark::report("ChildIteration.Deep.SetLayout", propagate, deepDetails);
+
+            EXPECT_GT(visible, 0u);
+        });
+    }
+
+    TEST(BenchmarkContainerView, ToggleChildVisibility)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t iterations = 1000;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            for (size_t count : std::initializer_list<size_t>{10, 100, 1000, 10000}) {
+                auto layout = std::make_shared<yoga::Layout>();
+                auto container = std::make_shared<ContainerView>(factory);
+                container->setLayout(layout);
+                container->addChildViews(makeChildren(factory, count));
+                container->ensureLayoutRegistration();
+
+                auto middle = container->childViewAt(count / 2);
+                auto duration = benchmark::measure(iterations, [&]() {
+                    middle->visible = false;
+                    middle->visible = true;
+                });
+                benchmark::report("ToggleChildVisibility." + std::to_string(count), duration,
+                                  std::to_string(count) + " children");
+            }
+        });
+    }
+}
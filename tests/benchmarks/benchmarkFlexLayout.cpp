@@ -0,0 +1,118 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/flex.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        // Nested columns, each with a fixed size leaf and the next column, 50 levels deep
+        void addDeepTree(const std::shared_ptr<ContainerView> &root, size_t nodeCount)
+        {
+            constexpr size_t depth = 50;
+            const json columnStyle = FlexJsonStringify({"padding" : {"all" : 1}});
+            const json leafStyle = FlexJsonStringify({"size" : {"height" : 4}});
+
+            root->stylesheet = FlexJsonStringify({"direction" : "Row", "flexWrap" : "Wrap"});
+            for (size_t count = 0; count + 2 * depth <= nodeCount; count += 2 * depth) {
+                auto parent = root;
+                for (size_t level = 0; level < depth; level++) {
+                    auto column = std::make_shared<ContainerView>(root->viewCoreFactory());
+                    column->stylesheet = columnStyle;
+                    auto leaf = std::make_shared<ContainerView>(root->viewCoreFactory());
+                    leaf->stylesheet = leafStyle;
+                    column->addChildView(leaf);
+                    parent->addChildView(column);
+                    parent = column;
+                }
+            }
+        }
+
+        // A single column of rows
+        void addWideTree(const std::shared_ptr<ContainerView> &root, size_t nodeCount)
+        {
+            const json rowStyle = FlexJsonStringify({"size" : {"height" : 10}, "margin" : {"bottom" : 1}});
+
+            std::vector<std::shared_ptr<View>> rows;
+            for (size_t i = 0; i < nodeCount; i++) {
+                auto row = std::make_shared<ContainerView>(root->viewCoreFactory());
+                row->stylesheet = rowStyle;
+                rows.push_back(row);
+            }
+            root->addChildViews(rows);
+        }
+
+        // Fixed size tiles that wrap into rows
+        void addWrappingTree(const std::shared_ptr<ContainerView> &root, size_t nodeCount)
+        {
+            const json tileStyle = FlexJsonStringify({"size" : {"width" : 30, "height" : 20}, "margin" : {"all" : 2}});
+
+            root->stylesheet =
+                FlexJsonStringify({"direction" : "Row", "flexWrap" : "Wrap", "justifyContent" : "SpaceBetween"});
+            std::vector<std::shared_ptr<View>> tiles;
+            for (size_t i = 0; i < nodeCount; i++) {
+                auto tile = std::make_shared<ContainerView>(root->viewCoreFactory());
+                tile->stylesheet = tileStyle;
+                tiles.push_back(tile);
+            }
+            root->addChildViews(tiles);
+        }
+    }
+
+    TEST(BenchmarkFlexLayout, CompareWithYoga)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            using TreeFunction = void (*)(const std::shared_ptr<ContainerView> &, size_t);
+            const std::vector<std::pair<std::string, TreeFunction>> trees = {
+                {"Deep", &addDeepTree}, {"Wide", &addWideTree}, {"Wrapping", &addWrappingTree}};
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            for (const auto &[treeName, addTree] : trees) {
+                for (size_t nodeCount : {1000, 10000, 100000}) {
+                    const size_t iterations = nodeCount >= 100000 ? 3 : 10;
+                    const std::string details = std::to_string(nodeCount) + " nodes";
+
+                    for (bool useFlex : {false, true}) {
+                        std::shared_ptr<ui::Layout> layout;
+                        if (useFlex) {
+                            layout = std::make_shared<flex::Layout>();
+                        } else {
+                            layout = std::make_shared<yoga::Layout>();
+                        }
+
+                        auto root = std::make_shared<ContainerView>(factory);
+                        root->setLayout(layout);
+                        root->geometry = Rect{0, 0, 1024, 768};
+                        addTree(root, nodeCount);
+                        root->ensureLayoutRegistration();
+
+                        const std::string name =
+                            "FlexLayout." + treeName + "." + std::to_string(nodeCount) + (useFlex ? ".Flex" : ".Yoga");
+
+                        auto initial = benchmark::measure(1, [&]() { layout->layout(root.get()); });
+                        benchmark::report(name + ".Initial", initial, details);
+
+                        // A new root width lays out the whole tree again
+                        bool narrow = false;
+                        auto resize = benchmark::measure(iterations, [&]() {
+                            narrow = !narrow;
+                            root->geometry = Rect{0, 0, narrow ? 800. : 1024., 768};
+                            layout->layout(root.get());
+                        });
+                        benchmark::report(name + ".Resize", resize, details);
+
+                        auto unchanged = benchmark::measure(iterations, [&]() { layout->layout(root.get()); });
+                        benchmark::report(name + ".Unchanged", unchanged, details);
+                    }
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/flex.h>
+#include <bdn/ui/grid.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        constexpr int galleryColumns = 50;
+        constexpr int galleryRows = 50;
+
+        // One grid container with a fr column per tile
+        void addGridGallery(const std::shared_ptr<ContainerView> &root)
+        {
+            json columns = json::array();
+            for (int column = 0; column < galleryColumns; column++) {
+                columns.push_back("1fr");
+            }
+            json style = GridJsonStringify({"columnGap" : 2, "rowGap" : 2, "padding" : 4});
+            style["grid"]["columns"] = columns;
+            root->stylesheet = style;
+
+            const json tileStyle = GridJsonStringify({"size" : {"height" : 20}});
+
+            std::vector<std::shared_ptr<View>> tiles;
+            for (int i = 0; i < galleryColumns * galleryRows; i++) {
+                auto tile = std::make_shared<ContainerView>(root->viewCoreFactory());
+                tile->stylesheet = tileStyle;
+                tiles.push_back(tile);
+            }
+            root->addChildViews(tiles);
+        }
+
+        // A column of rows, each row a flex container with growing tiles
+        void addFlexGallery(const std::shared_ptr<ContainerView> &root)
+        {
+            root->stylesheet = FlexJsonStringify({"padding" : {"all" : 4}});
+
+            const json rowStyle = FlexJsonStringify({"direction" : "Row", "margin" : {"bottom" : 2}});
+            const json tileStyle = FlexJsonStringify(
+                {"flexGrow" : 1, "flexBasis" : 0, "size" : {"height" : 20}, "margin" : {"right" : 2}});
+
+            std::vector<std::shared_ptr<View>> rows;
+            for (int row = 0; row < galleryRows; row++) {
+                auto rowView = std::make_shared<ContainerView>(root->viewCoreFactory());
+                rowView->stylesheet = rowStyle;
+
+                std::vector<std::shared_ptr<View>> tiles;
+                for (int column = 0; column < galleryColumns; column++) {
+                    auto tile = std::make_shared<ContainerView>(root->viewCoreFactory());
+                    tile->stylesheet = tileStyle;
+                    tiles.push_back(tile);
+                }
+                rowView->addChildViews(tiles);
+                rows.push_back(rowView);
+            }
+            root->addChildViews(rows);
+        }
+    }
+
+    TEST(BenchmarkGridLayout, TileGallery)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            constexpr size_t iterations = 20;
+            const std::string details = std::to_string(galleryColumns) + "x" + std::to_string(galleryRows) + " tiles";
+
+            const std::vector<std::string> layoutNames = {"Grid", "Yoga", "Flex"};
+            for (const auto &layoutName : layoutNames) {
+                std::shared_ptr<ui::Layout> layout;
+                if (layoutName == "Grid") {
+                    layout = std::make_shared<grid::Layout>();
+                } else if (layoutName == "Yoga") {
+                    layout = std::make_shared<yoga::Layout>();
+                } else {
+                    layout = std::make_shared<flex::Layout>();
+                }
+
+                auto root = std::make_shared<ContainerView>(factory);
+                root->setLayout(layout);
+                root->geometry = Rect{0, 0, 1024, 768};
+                if (layoutName == "Grid") {
+                    addGridGallery(root);
+                } else {
+                    addFlexGallery(root);
+                }
+                root->ensureLayoutRegistration();
+
+                const std::string name = "GridLayout.Gallery." + layoutName;
+
+                auto initial = benchmark::measure(1, [&]() { layout->layout(root.get()); });
+                benchmark::report(name + ".Initial", initial, details);
+
+                // Every tile gets a new width
+                bool narrow = false;
+                auto resize = benchmark::measure(iterations, [&]() {
+                    narrow = !narrow;
+                    root->geometry = Rect{0, 0, narrow ? 800. : 1024., 768};
+                    layout->layout(root.get());
+                });
+                benchmark::report(name + ".Resize", resize, details);
+
+                auto unchanged = benchmark::measure(iterations, [&]() { layout->layout(root.get()); });
+                benchmark::report(name + ".Unchanged", unchanged, details);
+            }
+        });
+    }
+}
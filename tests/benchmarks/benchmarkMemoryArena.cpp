@@ -0,0 +1,130 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/MemoryArena.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+
+#include <map>
+#include <optional>
+#include <sstream>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        constexpr size_t screenViewCount = 2000;
+        constexpr size_t modelPropertyCount = 20000;
+        constexpr size_t defaultPathAllocationCount = 100000;
+
+        std::string arenaName(std::optional<MemoryArena::Kind> kind)
+        {
+            if (!kind) {
+                return "heap";
+            }
+            return *kind == MemoryArena::Kind::Monotonic ? "monotonic" : "pooled";
+        }
+
+        std::string describe(const std::shared_ptr<MemoryArena> &arena)
+        {
+            if (!arena) {
+                return std::string();
+            }
+            auto statistics = arena->statistics();
+            std::ostringstream stream;
+            stream << statistics.allocationCount << " allocations, " << statistics.peakBytesInUse << " peak bytes";
+            return stream.str();
+        }
+
+        template <class Build> void benchmarkBuildAndTeardown(const std::string &name, Build &&build)
+        {
+            for (std::optional<MemoryArena::Kind> kind :
+                 {std::optional<MemoryArena::Kind>(), std::optional<MemoryArena::Kind>(MemoryArena::Kind::Monotonic),
+                  std::optional<MemoryArena::Kind>(MemoryArena::Kind::Pooled)}) {
+                std::shared_ptr<MemoryArena> arena = kind ? MemoryArena::create(*kind, 1024 * 1024) : nullptr;
+
+                decltype(build()) screen;
+                auto buildDuration = benchmark::measure(1, [&]() {
+                    MemoryArena::Scope scope(arena);
+                    screen = build();
+                });
+                std::string statistics = describe(arena);
+                arena.reset();
+
+                auto teardownDuration = benchmark::measure(1, [&]() { screen = {}; });
+
+                benchmark::report(name + ".build." + arenaName(kind), buildDuration, statistics);
+                benchmark::report(name + ".teardown." + arenaName(kind), teardownDuration);
+            }
+        }
+    }
+
+    // Without a scope, arena aware allocations must cost the same as the standard ones
+    TEST(BenchmarkMemoryArena, DefaultPath)
+    {
+        ASSERT_EQ(MemoryArena::active(), nullptr);
+
+        std::vector<std::shared_ptr<int>> values(defaultPathAllocationCount);
+        auto makeShared = benchmark::measure(1, [&]() {
+            for (size_t i = 0; i < defaultPathAllocationCount; i++) {
+                values[i] = std::make_shared<int>(static_cast<int>(i));
+            }
+        });
+        values.assign(defaultPathAllocationCount, nullptr);
+        auto allocateSharedDuration = benchmark::measure(1, [&]() {
+            for (size_t i = 0; i < defaultPathAllocationCount; i++) {
+                values[i] = allocateShared<int>(static_cast<int>(i));
+            }
+        });
+        values.clear();
+
+        auto fillMap = [](auto &map) {
+            for (size_t i = 0; i < defaultPathAllocationCount; i++) {
+                map.emplace(static_cast<int>(i), static_cast<int>(i));
+            }
+        };
+        std::map<int, int> standardMap;
+        auto standardMapDuration = benchmark::measure(1, [&]() { fillMap(standardMap); });
+        std::map<int, int, std::less<>, ArenaAllocator<std::pair<const int, int>>> arenaMap;
+        auto arenaMapDuration = benchmark::measure(1, [&]() { fillMap(arenaMap); });
+
+        benchmark::report("DefaultPath.make_shared", makeShared);
+        benchmark::report("DefaultPath.allocateShared", allocateSharedDuration);
+        benchmark::report("DefaultPath.map.allocator", standardMapDuration);
+        benchmark::report("DefaultPath.map.ArenaAllocator", arenaMapDuration);
+        benchmark::report("DefaultPath.ArenaAllocatorBytes", sizeof(ArenaAllocator<int>));
+    }
+
+    TEST(BenchmarkMemoryArena, PropertyModel)
+    {
+        benchmarkBuildAndTeardown("PropertyModel", []() {
+            std::vector<std::shared_ptr<Property<int>>> properties;
+            properties.reserve(modelPropertyCount);
+            for (size_t i = 0; i < modelPropertyCount; i++) {
+                auto property = allocateShared<Property<int>>(static_cast<int>(i));
+                if (!properties.empty()) {
+                    property->bind(*properties.back(), BindMode::unidirectional);
+                }
+                properties.push_back(property);
+            }
+            return properties;
+        });
+    }
+
+    TEST(BenchmarkMemoryArena, Screen)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            benchmarkBuildAndTeardown("Screen", []() {
+                auto container = allocateShared<ContainerView>();
+                for (size_t i = 0; i < screenViewCount; i++) {
+                    auto label = allocateShared<Label>();
+                    label->text = "Label " + std::to_string(i);
+                    container->addChildView(label);
+                }
+                return container;
+            });
+        });
+    }
+}
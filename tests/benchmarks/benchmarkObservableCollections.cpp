@@ -0,0 +1,124 @@
+#include "Benchmark.h"
+
+#include <bdn/ObservableMap.h>
+#include <bdn/ObservableVector.h>
+#include <bdn/property/Property.h>
+
+#include <numeric>
+
+namespace bdn
+{
+    namespace
+    {
+        constexpr size_t collectionSize = 10000;
+        constexpr size_t editCount = 1000;
+
+        std::vector<int> makeItems()
+        {
+            std::vector<int> items(collectionSize);
+            std::iota(items.begin(), items.end(), 0);
+            return items;
+        }
+    }
+
+    TEST(BenchmarkObservableCollections, PropertyVectorSmallEdits)
+    {
+        Property<std::vector<int>> property(makeItems());
+
+        // A consumer of Property<std::vector> has to revisit every element on each change
+        size_t touchedItems = 0;
+        property.onChange() += [&touchedItems](auto &p) { touchedItems += p.get().size(); };
+
+        auto duration = benchmark::measure(editCount, [&]() {
+            auto items = property.get();
+            items[items.size() / 2]++;
+            property = items;
+        });
+
+        benchmark::report("PropertyVector.edit", duration);
+        benchmark::report("PropertyVector.touchedItems", touchedItems);
+    }
+
+    TEST(BenchmarkObservableCollections, ObservableVectorSmallEdits)
+    {
+        ObservableVector<int> vector(makeItems());
+
+        size_t touchedItems = 0;
+        vector.onChange() += [&touchedItems](const auto &, const IndexChangeSet &changeSet) {
+            for (const auto &range : changeSet.inserted) {
+                touchedItems += range.count;
+            }
+            touchedItems += changeSet.updated.size() + changeSet.moved.size();
+        };
+
+        auto duration = benchmark::measure(editCount, [&]() {
+            vector.modify(vector.size() / 2, [](int &value) { value++; });
+        });
+        benchmark::report("ObservableVector.update", duration);
+
+        duration = benchmark::measure(editCount, [&]() {
+            vector.insert(vector.size() / 2, 1);
+            vector.erase(vector.size() / 3);
+        });
+        benchmark::report("ObservableVector.insertErase", duration);
+
+        duration = benchmark::measure(editCount, [&]() { vector.move(10, vector.size() - 10); });
+        benchmark::report("ObservableVector.move", duration);
+
+        benchmark::report("ObservableVector.touchedItems", touchedItems);
+    }
+
+    TEST(BenchmarkObservableCollections, ObservableVectorBatchedEdits)
+    {
+        ObservableVector<int> vector(makeItems());
+
+        size_t notifications = 0;
+        vector.onChange() += [&notifications](const auto &, const auto &) { notifications++; };
+
+        auto duration = benchmark::measure(editCount / 10, [&]() {
+            vector.update([&]() {
+                for (size_t i = 0; i < 10; i++) {
+                    vector.set(i * 100, static_cast<int>(i));
+                    vector.insert(i * 200, 1);
+                    vector.erase(i * 300);
+                }
+            });
+        });
+
+        benchmark::report("ObservableVector.batchOf30", duration);
+        benchmark::report("ObservableVector.batchNotifications", notifications);
+    }
+
+    TEST(BenchmarkObservableCollections, ObservableMapSmallEdits)
+    {
+        std::map<int, int> items;
+        for (size_t i = 0; i < collectionSize; i++) {
+            items[static_cast<int>(i)] = static_cast<int>(i);
+        }
+        ObservableMap<int, int> map(items);
+
+        size_t touchedItems = 0;
+        map.onChange() += [&touchedItems](const auto &, const auto &changeSet) {
+            touchedItems += changeSet.inserted.size() + changeSet.removed.size() + changeSet.updated.size();
+        };
+
+        int key = 0;
+        auto duration = benchmark::measure(editCount, [&]() {
+            map.set(key % static_cast<int>(collectionSize), key);
+            key++;
+        });
+        benchmark::report("ObservableMap.set", duration);
+
+        duration = benchmark::measure(editCount / 10, [&]() {
+            map.update([&]() {
+                for (int i = 0; i < 10; i++) {
+                    map.erase(key);
+                    map.set(key, i);
+                    key++;
+                }
+            });
+        });
+        benchmark::report("ObservableMap.batchOf20", duration);
+        benchmark::report("ObservableMap.touchedItems", touchedItems);
+    }
+}
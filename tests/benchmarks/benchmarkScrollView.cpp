@@ -0,0 +1,70 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/ScrollView.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    TEST(BenchmarkScrollView, ScrollLargeContent)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            constexpr size_t rowCount = 50000;
+            constexpr size_t steps = 50;
+            const std::string details = std::to_string(rowCount) + " rows";
+
+            const json rowStyle = FlexJsonStringify({"flexShrink" : 0, "size" : {"height" : 44}});
+
+            for (bool virtualize : {true, false}) {
+                auto layout = std::make_shared<yoga::Layout>();
+                auto scrollView = std::make_shared<ScrollView>(factory);
+                scrollView->setLayout(layout);
+                scrollView->geometry = Rect{0, 0, 320, 480};
+                scrollView->virtualizeContent = virtualize;
+
+                auto content = std::make_shared<ContainerView>(factory);
+                content->stylesheet = FlexJsonStringify({"flexShrink" : 0});
+
+                std::vector<std::shared_ptr<View>> rows;
+                rows.reserve(rowCount);
+                for (size_t i = 0; i < rowCount; i++) {
+                    auto row = std::make_shared<ContainerView>(factory);
+                    row->stylesheet = rowStyle;
+                    rows.push_back(row);
+                }
+                content->addChildViews(rows);
+
+                const std::string name = std::string("ScrollView.") + (virtualize ? "Virtualized" : "Full");
+
+                std::shared_ptr<headless::ScrollViewCore> core;
+                auto initial = benchmark::measure(1, [&]() {
+                    scrollView->contentView = content;
+                    core = scrollView->core<headless::ScrollViewCore>();
+                    scrollView->ensureLayoutRegistration();
+                    layout->layout(scrollView.get());
+                });
+                benchmark::report(name + ".Initial", initial, details);
+
+                // Scrolls down by a bit more than two rows per step
+                double position = 0;
+                auto scroll = benchmark::measure(steps, [&]() {
+                    position += 100;
+                    core->scrollTo(Point{0, position});
+                    scrollView->ensureLayoutRegistration();
+                    layout->layout(scrollView.get());
+                });
+                benchmark::report(name + ".Scroll", scroll, details);
+
+                if (const auto *virtualizer = scrollView->contentVirtualizer()) {
+                    benchmark::report(name + ".Materialized", virtualizer->statistics().materializedCount);
+                    benchmark::report(name + ".Released", virtualizer->statistics().releasedCount);
+                }
+            }
+        });
+    }
+}
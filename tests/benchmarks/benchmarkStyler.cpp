@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Styler.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+#include <functional>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    TEST(BenchmarkStyler, ToggleConditions)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t viewCount = 10000;
+            constexpr size_t toggles = 20;
+            const std::string details = std::to_string(viewCount) + " views";
+
+            Styler styler;
+            styler.setCondition("theme", std::make_shared<Styler::equals_condition>("light"));
+            styler.setCondition("width", std::make_shared<Styler::greater_equal_condition>(400));
+            styler.setCondition("os", std::make_shared<Styler::equals_condition>("ios"));
+
+            // A tenth of the views depends on the width, the others only on the theme
+            const json themed = JsonStringify([
+                {"flex" : {"margin" : {"all" : 5}}}, {"if" : {"theme" : "dark"}, "backgroundColor" : "#000000"},
+                {"if" : {"theme" : "light"}, "backgroundColor" : "#FFFFFF"}
+            ]);
+            const json responsive = JsonStringify([
+                {"flex" : {"margin" : {"all" : 5}}}, {"if" : {"width" : 600}, "flex" : {"padding" : {"all" : 10}}}
+            ]);
+
+            std::vector<std::shared_ptr<ContainerView>> views;
+            views.reserve(viewCount);
+            auto assign = benchmark::measure(1, [&]() {
+                for (size_t i = 0; i < viewCount; i++) {
+                    auto view = std::make_shared<ContainerView>();
+                    styler.setStyleSheet(view, i % 10 == 0 ? responsive : themed);
+                    views.push_back(view);
+                }
+            });
+            benchmark::report("Styler.SetStyleSheet", assign, details);
+            benchmark::report("Styler.SetStyleSheet.Compiled", styler.statistics().compiledProgramCount);
+
+            auto report = [&](const std::string &name) {
+                auto statistics = styler.statistics();
+                benchmark::report(name + ".Rematched", statistics.rematchedViewCount);
+                benchmark::report(name + ".Evaluated", statistics.evaluatedConditionCount);
+                benchmark::report(name + ".Assigned", statistics.assignedStylesheetCount);
+                benchmark::report(name + ".Unchanged", statistics.unchangedStylesheetCount);
+                benchmark::report(name + ".Merged", statistics.mergedResultCount);
+            };
+
+            // No stylesheet tests the os
+            styler.resetStatistics();
+            auto unrelated = benchmark::measure(toggles, [&, i = 0]() mutable {
+                styler.setCondition("os", std::make_shared<Styler::equals_condition>(i++ % 2 ? "ios" : "android"));
+            });
+            benchmark::report("Styler.UnrelatedCondition", unrelated, details);
+            report("Styler.UnrelatedCondition");
+
+            // Only the step from 600 to 650 and back changes the matches of the responsive views
+            styler.resetStatistics();
+            auto width = benchmark::measure(toggles, [&, i = 0]() mutable {
+                styler.setCondition("width", std::make_shared<Styler::greater_equal_condition>(500 + 50 * (i++ % 4)));
+            });
+            benchmark::report("Styler.WidthCondition", width, details);
+            report("Styler.WidthCondition");
+
+            styler.resetStatistics();
+            auto theme = benchmark::measure(toggles, [&, i = 0]() mutable {
+                styler.setCondition("theme", std::make_shared<Styler::equals_condition>(i++ % 2 ? "light" : "dark"));
+            });
+            benchmark::report("Styler.ThemeCondition", theme, details);
+            report("Styler.ThemeCondition");
+        });
+    }
+
+    TEST(BenchmarkStyler, RotateWithMultipleConditions)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t rowCount = 2000;
+            constexpr size_t rotations = 10;
+            const std::string details = std::to_string(rowCount) + " rows";
+
+            // Rotating changes all four conditions, each of which changes the style of every row
+            const json rowStyle = JsonStringify([
+                {"flex" : {"direction" : "Row", "size" : {"height" : 44}}},
+                {"if" : {"orientation" : "landscape"}, "flex" : {"size" : {"height" : 32}}},
+                {"if" : {"width" : 400}, "flex" : {"padding" : {"left" : 24, "right" : 24}}},
+                {"if" : {"height" : 400}, "flex" : {"margin" : {"top" : 2}}},
+                {"if" : {"dark" : true}, "backgroundColor" : "#000000"}
+            ]);
+
+            // Calls notified after each condition, like separate notifications of the platform would
+            auto setConditions = [](Styler &styler, bool landscape, const std::function<void()> &notified) {
+                Size size = landscape ? Size{480, 320} : Size{320, 480};
+                styler.setCondition("orientation",
+                                    std::make_shared<Styler::equals_condition>(landscape ? "landscape" : "portrait"));
+                notified();
+                styler.setCondition("width", std::make_shared<Styler::less_condition>(size.width));
+                notified();
+                styler.setCondition("height", std::make_shared<Styler::less_condition>(size.height));
+                notified();
+                styler.setCondition("dark", std::make_shared<Styler::equals_condition>(landscape));
+                notified();
+            };
+            auto nothing = []() {};
+
+            // Sequential: the conditions are set one after the other and laid out once
+            // PerNotification: the list is laid out after each condition that changed a stylesheet
+            // Batched: the conditions are set in a single Styler::update()
+            for (const std::string mode : {"Sequential", "PerNotification", "Batched"}) {
+                auto factory = std::make_shared<headless::ViewCoreFactory>();
+                auto layout = std::make_shared<yoga::Layout>();
+                auto list = std::make_shared<ContainerView>(factory);
+                list->setLayout(layout);
+                list->geometry = Rect{0, 0, 320, 480};
+
+                Styler styler;
+                setConditions(styler, false, nothing);
+
+                std::vector<std::shared_ptr<View>> rows;
+                rows.reserve(rowCount);
+                for (size_t i = 0; i < rowCount; i++) {
+                    auto row = std::make_shared<ContainerView>(factory);
+                    styler.setStyleSheet(row, rowStyle);
+                    rows.push_back(row);
+                }
+                list->addChildViews(rows);
+                list->ensureLayoutRegistration();
+                layout->layout(list.get());
+
+                styler.resetStatistics();
+                size_t layoutCount = 0;
+                size_t laidOutAssignments = 0;
+                auto layoutIfChanged = [&]() {
+                    if (styler.statistics().assignedStylesheetCount != laidOutAssignments) {
+                        laidOutAssignments = styler.statistics().assignedStylesheetCount;
+                        layout->layout(list.get());
+                        layoutCount++;
+                    }
+                };
+
+                bool landscape = false;
+                auto rotate = benchmark::measure(rotations, [&]() {
+                    landscape = !landscape;
+                    list->geometry = landscape ? Rect{0, 0, 480, 320} : Rect{0, 0, 320, 480};
+
+                    if (mode == "Batched") {
+                        styler.update([&]() { setConditions(styler, landscape, nothing); });
+                    } else if (mode == "PerNotification") {
+                        setConditions(styler, landscape, layoutIfChanged);
+                    } else {
+                        setConditions(styler, landscape, nothing);
+                    }
+                    layoutIfChanged();
+                });
+
+                const std::string name = "Styler.Rotate." + mode;
+                benchmark::report(name, rotate, details);
+                benchmark::report(name + ".Assigned", styler.statistics().assignedStylesheetCount);
+                benchmark::report(name + ".Layouts", layoutCount);
+            }
+        });
+    }
+}
@@ -0,0 +1,57 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/Button.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        constexpr size_t viewCount = 100000;
+
+        template <class ViewType> void benchmarkCreateViews(const std::string &name)
+        {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            std::vector<std::shared_ptr<View>> views;
+            views.reserve(viewCount);
+
+            auto duration = benchmark::measure(1, [&]() {
+                for (size_t i = 0; i < viewCount; i++) {
+                    auto view = std::make_shared<ViewType>(factory);
+                    view->viewCore();
+                    views.push_back(view);
+                }
+            });
+
+            benchmark::report(name, duration, std::to_string(viewCount) + " views");
+        }
+    }
+
+    TEST(BenchmarkViewCoreFactory, CreateViews)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            benchmarkCreateViews<ContainerView>("CreateViews.ContainerView");
+            benchmarkCreateViews<Label>("CreateViews.Label");
+            benchmarkCreateViews<Button>("CreateViews.Button");
+        });
+    }
+
+    TEST(BenchmarkViewCoreFactory, CreateViewCore)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            auto duration = benchmark::measure(1, [&]() {
+                for (size_t i = 0; i < viewCount; i++) {
+                    factory->createViewCore(typeid(Label));
+                }
+            });
+            benchmark::report("CreateViewCore.Label", duration, std::to_string(viewCount) + " cores");
+        });
+    }
+}
@@ -0,0 +1,76 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        // A subtree of the given depth where every level also holds a few labels
+        std::shared_ptr<ContainerView> makeDeepSubtree(const std::shared_ptr<ui::ViewCoreFactory> &factory,
+                                                       size_t depth, size_t labelsPerLevel)
+        {
+            auto top = std::make_shared<ContainerView>(factory);
+            auto level = top;
+            for (size_t i = 0; i < depth; i++) {
+                for (size_t j = 0; j < labelsPerLevel; j++) {
+                    level->addChildView(std::make_shared<Label>(factory));
+                }
+                auto next = std::make_shared<ContainerView>(factory);
+                level->addChildView(next);
+                level = next;
+            }
+            return top;
+        }
+    }
+
+    TEST(BenchmarkViewLayout, ReparentDeepSubtree)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t moves = 100;
+            constexpr size_t labelsPerLevel = 4;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            for (size_t depth : std::initializer_list<size_t>{10, 100, 1000}) {
+                auto root = std::make_shared<ContainerView>(factory);
+                auto left = std::make_shared<ContainerView>(factory);
+                auto right = std::make_shared<ContainerView>(factory);
+                root->setLayout(std::make_shared<yoga::Layout>());
+                root->addChildView(left);
+                root->addChildView(right);
+
+                auto subtree = makeDeepSubtree(factory, depth, labelsPerLevel);
+                left->addChildView(subtree);
+                root->ensureLayoutRegistration();
+
+                const std::string details = std::to_string(depth) + " levels, " +
+                                            std::to_string(depth * (labelsPerLevel + 1)) + " views, " +
+                                            std::to_string(moves) + " moves";
+
+                auto duration = benchmark::measure(1, [&]() {
+                    for (size_t i = 0; i < moves; i++) {
+                        auto from = (i % 2 == 0) ? left : right;
+                        auto to = (i % 2 == 0) ? right : left;
+                        from->removeChildView(subtree);
+                        to->addChildView(subtree);
+                        root->ensureLayoutRegistration();
+                    }
+                });
+                benchmark::report("ReparentDeepSubtree." + std::to_string(depth), duration, details);
+
+                auto switchLayout = benchmark::measure(1, [&]() {
+                    root->setLayout(std::make_shared<yoga::Layout>());
+                    root->ensureLayoutRegistration();
+                });
+                benchmark::report("SwitchRootLayout." + std::to_string(depth), switchLayout, details);
+            }
+        });
+    }
+}
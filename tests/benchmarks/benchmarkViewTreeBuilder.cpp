@@ -0,0 +1,76 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/Button.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/ViewTreeBuilder.h>
+#include <bdn/ui/headless.h>
+
+#include <future>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        constexpr size_t rowCount = 400;
+        constexpr size_t viewsPerRow = 5;
+
+        // A page of rowCount rows, each a container with a title, two detail labels and a button
+        std::shared_ptr<View> buildPage(const std::shared_ptr<ui::ViewCoreFactory> &factory)
+        {
+            auto page = std::make_shared<ContainerView>(factory);
+            for (size_t i = 0; i < rowCount; i++) {
+                auto row = std::make_shared<ContainerView>(factory);
+                row->stylesheet = json{{"flexDirection", "row"}};
+
+                for (size_t j = 0; j < viewsPerRow - 2; j++) {
+                    auto label = std::make_shared<Label>(factory);
+                    label->text = "Row " + std::to_string(i) + " label " + std::to_string(j);
+                    row->addChildView(label);
+                }
+
+                auto button = std::make_shared<Button>(factory);
+                button->label = std::string("Open");
+                row->addChildView(button);
+
+                page->addChildView(row);
+            }
+            return page;
+        }
+    }
+
+    TEST(BenchmarkViewTreeBuilder, Page2000Views)
+    {
+        auto factory = std::make_shared<headless::ViewCoreFactory>();
+        const std::string details = std::to_string(rowCount * viewsPerRow) + " views";
+
+        benchmark::Duration mainThreadOnly;
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            mainThreadOnly = benchmark::measure(1, [&]() { buildPage(factory)->viewCore(); });
+        });
+        benchmark::report("Page2000Views.BuildOnMainThread", mainThreadOnly, details);
+
+        // Split into the part that runs on the worker and the part that blocks the main thread
+        std::shared_ptr<View> page;
+        auto worker = std::make_shared<DispatchQueue>();
+        benchmark::Duration workerBuild;
+        worker->dispatchSync([&]() { workerBuild = benchmark::measure(1, [&]() { page = buildPage(factory); }); });
+        benchmark::report("Page2000Views.WorkerBuild", workerBuild, details);
+
+        benchmark::Duration mainThreadAttach;
+        bdn::App()->dispatchQueue()->dispatchSync(
+            [&]() { mainThreadAttach = benchmark::measure(1, [&]() { page->viewCore(); }); });
+        benchmark::report("Page2000Views.MainThreadAttach", mainThreadAttach, details);
+
+        std::promise<void> attached;
+        auto endToEnd = benchmark::measure(1, [&]() {
+            buildViewTreeAsync(
+                worker, [&]() { return buildPage(factory); }, [&](auto) { attached.set_value(); }, factory);
+            attached.get_future().wait();
+        });
+        benchmark::report("Page2000Views.BuildViewTreeAsyncLatency", endToEnd, details);
+    }
+}
@@ -0,0 +1,210 @@
+#include "Benchmark.h"
+
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        // A list of rows with a fixed size icon, a label placeholder and an accessory, none of
+        // which needs to be measured
+        std::shared_ptr<ContainerView> makeList(const std::shared_ptr<ui::ViewCoreFactory> &factory, size_t rowCount)
+        {
+            const json rowStyle = FlexJsonStringify({"direction" : "Row", "size" : {"height" : 44}});
+            const json fixedStyle = FlexJsonStringify({"size" : {"width" : 40, "height" : 40}});
+            const json growStyle = FlexJsonStringify({"flexGrow" : 1, "flexBasis" : 0, "size" : {"height" : 20}});
+
+            auto list = std::make_shared<ContainerView>(factory);
+            for (size_t i = 0; i < rowCount; i++) {
+                auto row = std::make_shared<ContainerView>(factory);
+                row->stylesheet = rowStyle;
+                for (const auto &style : {fixedStyle, growStyle, fixedStyle}) {
+                    auto cell = std::make_shared<ContainerView>(factory);
+                    cell->stylesheet = style;
+                    row->addChildView(cell);
+                }
+                list->addChildView(row);
+            }
+            return list;
+        }
+    }
+
+    TEST(BenchmarkYogaLayout, RestyleRows)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t rowCount = 5000;
+            constexpr size_t iterations = 10;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto list = std::make_shared<ContainerView>(factory);
+            list->setLayout(layout);
+            list->geometry = Rect{0, 0, 320, 480};
+
+            const json rowStyle = FlexJsonStringify(
+                {"direction" : "Row", "size" : {"height" : 44}, "padding" : {"left" : 16, "right" : 16}});
+            const json selectedRowStyle = FlexJsonStringify(
+                {"direction" : "Row", "size" : {"height" : 64}, "padding" : {"left" : 16, "right" : 16}});
+
+            std::vector<std::shared_ptr<View>> rows;
+            rows.reserve(rowCount);
+            for (size_t i = 0; i < rowCount; i++) {
+                rows.push_back(std::make_shared<ContainerView>(factory));
+                rows.back()->stylesheet = rowStyle;
+            }
+            list->addChildViews(rows);
+            list->ensureLayoutRegistration();
+            layout->layout(list.get());
+
+            const std::string details = std::to_string(rowCount) + " rows";
+
+            bool selected = false;
+            auto restyle = benchmark::measure(iterations, [&]() {
+                selected = !selected;
+                for (auto &row : rows) {
+                    row->stylesheet = selected ? selectedRowStyle : rowStyle;
+                }
+            });
+            benchmark::report("RestyleRows.Changed", restyle, details);
+
+            auto toggleVisible = benchmark::measure(iterations, [&]() {
+                for (auto &row : rows) {
+                    row->visible = false;
+                    row->visible = true;
+                }
+            });
+            benchmark::report("RestyleRows.ToggleVisible", toggleVisible, details);
+
+            auto relayout = benchmark::measure(iterations, [&]() { layout->layout(list.get()); });
+            benchmark::report("RestyleRows.Layout", relayout, details);
+
+            benchmark::report("RestyleRows.CompiledStylesheets", layout->stylesheetCache().size());
+        });
+    }
+
+    TEST(BenchmarkYogaLayout, MeasureCache)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t labelCount = 1000;
+            constexpr size_t iterations = 10;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            for (bool cacheEnabled : {false, true}) {
+                yoga::MeasureCache::enabled() = cacheEnabled;
+                yoga::MeasureCache::resetStatistics();
+
+                auto layout = std::make_shared<yoga::Layout>();
+                auto list = std::make_shared<ContainerView>(factory);
+                list->setLayout(layout);
+                list->geometry = Rect{0, 0, 320, 480};
+
+                std::vector<std::shared_ptr<View>> labels;
+                for (size_t i = 0; i < labelCount; i++) {
+                    auto label = std::make_shared<Label>(factory);
+                    label->text = "Row " + std::to_string(i);
+                    labels.push_back(label);
+                }
+                list->addChildViews(labels);
+                list->viewCore();
+                list->ensureLayoutRegistration();
+                layout->layout(list.get());
+
+                // Showing the rows again makes yoga measure them from scratch, the headless cores
+                // count how often that reaches the core
+                headless::ViewCore::resetStatistics();
+                auto duration = benchmark::measure(iterations, [&]() {
+                    for (auto &label : labels) {
+                        label->visible = false;
+                    }
+                    for (auto &label : labels) {
+                        label->visible = true;
+                    }
+                    layout->layout(list.get());
+                });
+
+                const std::string name = std::string("MeasureCache.") + (cacheEnabled ? "Enabled" : "Disabled");
+                benchmark::report(name, duration, std::to_string(labelCount) + " labels");
+                benchmark::report(name + ".CoreMeasureCalls", headless::ViewCore::statistics().measureCount);
+                benchmark::report(name + ".Hits", yoga::MeasureCache::statistics().measureHitCount);
+            }
+
+            yoga::MeasureCache::enabled() = true;
+        });
+    }
+
+    TEST(BenchmarkYogaLayout, RelayoutOneLeaf)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t rowCount = 5000;
+            constexpr size_t iterations = 100;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto list = makeList(factory, rowCount);
+            list->setLayout(layout);
+            list->geometry = Rect{0, 0, 320, 480};
+            list->ensureLayoutRegistration();
+            layout->layout(list.get());
+
+            auto icon = list->childViewAt(rowCount / 2)->childViews().front();
+            const json smallIcon = FlexJsonStringify({"size" : {"width" : 40, "height" : 40}});
+            const json largeIcon = FlexJsonStringify({"size" : {"width" : 44, "height" : 44}});
+
+            yoga::ViewData::ApplyStatistics total;
+            bool large = false;
+            auto duration = benchmark::measure(iterations, [&]() {
+                large = !large;
+                icon->stylesheet = large ? largeIcon : smallIcon;
+                layout->layout(list.get());
+                total.visitedCount += layout->lastApplyStatistics().visitedCount;
+                total.changedCount += layout->lastApplyStatistics().changedCount;
+            });
+
+            benchmark::report("RelayoutOneLeaf", duration, std::to_string(rowCount * 4) + " views");
+            benchmark::report("RelayoutOneLeaf.VisitedPerPass", total.visitedCount / iterations);
+            benchmark::report("RelayoutOneLeaf.ChangedPerPass", total.changedCount / iterations);
+        });
+    }
+
+    TEST(BenchmarkYogaLayout, Rotate)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            constexpr size_t rowCount = 5000;
+            constexpr size_t iterations = 20;
+
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            const size_t defaultCapacity = yoga::LayoutResultCache::capacity();
+
+            for (size_t capacity : {size_t(0), defaultCapacity}) {
+                yoga::LayoutResultCache::capacity() = capacity;
+                yoga::LayoutResultCache::resetStatistics();
+
+                auto layout = std::make_shared<yoga::Layout>();
+                auto list = makeList(factory, rowCount);
+                list->setLayout(layout);
+                list->geometry = Rect{0, 0, 320, 480};
+                list->ensureLayoutRegistration();
+                layout->layout(list.get());
+
+                bool landscape = false;
+                auto duration = benchmark::measure(iterations, [&]() {
+                    landscape = !landscape;
+                    list->geometry = landscape ? Rect{0, 0, 480, 320} : Rect{0, 0, 320, 480};
+                    layout->layout(list.get());
+                });
+
+                const std::string name = std::string("Rotate.") + (capacity > 0 ? "ResultCache" : "NoResultCache");
+                benchmark::report(name, duration, std::to_string(rowCount * 4) + " views");
+                benchmark::report(name + ".Hits", yoga::LayoutResultCache::statistics().hitCount);
+            }
+
+            yoga::LayoutResultCache::capacity() = defaultCapacity;
+        });
+    }}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <bdn/BindingInstrumentation.h>
+#include <bdn/Notifier.h>
+#include <bdn/property/Property.h>
+
+namespace bdn
+{
+    class BindingInstrumentationTest : public ::testing::Test
+    {
+      protected:
+        void SetUp() override
+        {
+            BindingInstrumentation::enabled() = true;
+            _previousThreshold = BindingInstrumentation::stormThreshold();
+        }
+
+        void TearDown() override
+        {
+            BindingInstrumentation::enabled() = false;
+            BindingInstrumentation::stormThreshold() = _previousThreshold;
+            BindingInstrumentation::setStormHandler(nullptr);
+        }
+
+        size_t _previousThreshold = 0;
+    };
+
+    TEST_F(BindingInstrumentationTest, CountsNotifications)
+    {
+        Property<int> a;
+        a.setDebugName("a");
+        a.onChange() += [](auto &) {};
+
+        a = 1;
+        a = 2;
+
+        auto stats = BindingInstrumentation::statistics()[&a.backing()->onChange()];
+        EXPECT_EQ("a", stats.debugName);
+        EXPECT_EQ(2u, stats.notificationCount);
+        EXPECT_EQ(2u, stats.subscriberCallCount);
+        EXPECT_EQ(1u, stats.maximumFanOut);
+    }
+
+    TEST_F(BindingInstrumentationTest, DisabledDoesNotCount)
+    {
+        BindingInstrumentation::enabled() = false;
+
+        Property<int> a;
+        a.setDebugName("a");
+        a = 1;
+
+        auto stats = BindingInstrumentation::statistics()[&a.backing()->onChange()];
+        EXPECT_EQ(0u, stats.notificationCount);
+    }
+
+    TEST_F(BindingInstrumentationTest, ForgetsDestroyedNotifiers)
+    {
+        const void *address = nullptr;
+        {
+            Notifier<int> notifier;
+            notifier += [](int) {};
+            notifier.notify(1);
+
+            address = &notifier;
+            EXPECT_EQ(1u, BindingInstrumentation::statistics().count(address));
+        }
+
+        EXPECT_EQ(0u, BindingInstrumentation::statistics().count(address));
+    }
+
+    TEST_F(BindingInstrumentationTest, RecordsEdges)
+    {
+        Property<int> source;
+        source.setDebugName("source");
+
+        std::string dot;
+        {
+            Property<int> target;
+            target.setDebugName("target");
+            target.bind(source, BindMode::unidirectional);
+
+            dot = BindingInstrumentation::toDot();
+            EXPECT_NE(std::string::npos, BindingInstrumentation::toJson().find("\"target\""));
+        }
+
+        EXPECT_NE(std::string::npos, dot.find("source"));
+        EXPECT_NE(std::string::npos, dot.find("target"));
+        EXPECT_NE(std::string::npos, dot.find("->"));
+
+        dot = BindingInstrumentation::toDot();
+        EXPECT_EQ(std::string::npos, dot.find("target"));
+        EXPECT_EQ(std::string::npos, dot.find("->"));
+    }
+
+    TEST_F(BindingInstrumentationTest, DetectsStorms)
+    {
+        BindingInstrumentation::stormThreshold() = 3;
+
+        std::string stormName;
+        size_t stormCount = 0;
+        BindingInstrumentation::setStormHandler(
+            [&](const void *, const std::string &debugName, size_t count) {
+                stormName = debugName;
+                stormCount = count;
+            });
+
+        Property<int> trigger;
+        Property<int> stormy;
+        stormy.setDebugName("stormy");
+
+        trigger.onChange() += [&stormy](auto &) {
+            for (int i = 0; i < 5; i++) {
+                stormy = i + 1;
+            }
+        };
+
+        trigger = 1;
+
+        EXPECT_EQ("stormy", stormName);
+        EXPECT_EQ(4u, stormCount);
+        EXPECT_EQ(1u, BindingInstrumentation::statistics()[&stormy.backing()->onChange()].stormCount);
+
+        // Separate dispatch cycles do not accumulate
+        stormName.clear();
+        for (int i = 0; i < 5; i++) {
+            stormy = i + 10;
+        }
+        EXPECT_TRUE(stormName.empty());
+    }
+}
@@ -0,0 +1,95 @@
+#include <bdn/Application.h>
+#include <bdn/ui/CommitPhase.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <gtest/gtest.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    TEST(CommitPhase, DisabledAppliesImmediately)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto label = std::make_shared<Label>(factory);
+            auto core = label->viewCore();
+
+            label->geometry = Rect{1, 2, 3, 4};
+            EXPECT_EQ(core->geometry.get(), Rect(1, 2, 3, 4));
+            EXPECT_FALSE(CommitPhase::hasPendingChanges());
+        });
+    }
+
+    TEST(CommitPhase, CoalescesChangesUntilFlush)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto container = std::make_shared<ContainerView>(factory);
+            auto label = std::make_shared<Label>(factory);
+            container->addChildView(label);
+            container->viewCore();
+            auto core = label->viewCore();
+
+            CommitPhase::enabled() = true;
+            CommitPhase::resetStatistics();
+
+            label->geometry = Rect{0, 0, 10, 10};
+            label->geometry = Rect{0, 0, 20, 20};
+            label->geometry = Rect{0, 0, 30, 30};
+            label->visible = false;
+            container->geometry = Rect{0, 0, 100, 100};
+
+            EXPECT_EQ(core->geometry.get(), Rect());
+            EXPECT_TRUE(core->visible.get());
+            EXPECT_TRUE(CommitPhase::hasPendingChanges());
+
+            CommitPhase::flush();
+
+            EXPECT_EQ(core->geometry.get(), Rect(0, 0, 30, 30));
+            EXPECT_FALSE(core->visible.get());
+            EXPECT_EQ(container->viewCore()->geometry.get(), Rect(0, 0, 100, 100));
+            EXPECT_FALSE(CommitPhase::hasPendingChanges());
+
+            auto statistics = CommitPhase::statistics();
+            EXPECT_EQ(statistics.recordedCount, 5u);
+            EXPECT_EQ(statistics.elidedCount, 2u);
+            EXPECT_EQ(statistics.committedCount, 3u);
+            EXPECT_EQ(statistics.flushCount, 1u);
+
+            // Changes made by the core are not deferred
+            core->geometry = Rect{5, 5, 5, 5};
+            EXPECT_EQ(label->geometry.get(), Rect(5, 5, 5, 5));
+
+            CommitPhase::flush();
+            CommitPhase::enabled() = false;
+        });
+    }
+
+    TEST(CommitPhase, FlushesInTreeOrder)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto container = std::make_shared<ContainerView>(factory);
+            auto first = std::make_shared<ContainerView>(factory);
+            auto firstChild = std::make_shared<Label>(factory);
+            auto second = std::make_shared<Label>(factory);
+            container->addChildViews({first, second});
+            first->addChildView(firstChild);
+
+            CommitPhase::enabled() = true;
+
+            std::vector<const View *> recorded{second.get(), firstChild.get(), first.get(), container.get()};
+            std::vector<const View *> order;
+            for (const View *view : recorded) {
+                CommitPhase::record(view, CommitPhase::Target::geometry, [&order, view]() { order.push_back(view); });
+            }
+            CommitPhase::flush();
+            CommitPhase::enabled() = false;
+
+            std::vector<const View *> expected{container.get(), first.get(), firstChild.get(), second.get()};
+            EXPECT_EQ(order, expected);
+        });
+    }
+}
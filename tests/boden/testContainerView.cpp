@@ -1,6 +1,10 @@
 #include <bdn/Application.h>
 #include <bdn/ui/Button.h>
 #include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/Window.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
 #include <gtest/gtest.h>
 
 namespace bdn
@@ -29,4 +33,191 @@ namespace bdn
             }
         });
     }
+
+    TEST(ContainerView, DeferredCoreCreation)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto container = std::make_shared<ContainerView>(factory);
+            auto label = std::make_shared<Label>(factory);
+
+            label->text = "Hello";
+            label->stylesheet = json{{"background-color", "#ff0000"}};
+            label->geometry = Rect{0, 0, 10, 10};
+            container->addChildView(label);
+
+            EXPECT_FALSE(container->hasViewCore());
+            EXPECT_FALSE(label->hasViewCore());
+            EXPECT_EQ(container->childIndex(label), 0u);
+
+            auto window = std::make_shared<Window>(factory);
+            window->contentView = container;
+
+            EXPECT_TRUE(container->hasViewCore());
+            ASSERT_TRUE(label->hasViewCore());
+            EXPECT_EQ(std::get<std::string>(label->existingCore<headless::LabelCore>()->text.get()), "Hello");
+            EXPECT_EQ(label->viewCore()->geometry.get(), Rect(0, 0, 10, 10));
+            EXPECT_TRUE(label->viewCore()->backgroundColor.get().has_value());
+            EXPECT_EQ(container->existingCore<headless::ContainerViewCore>()->childViews().size(), 1u);
+        });
+    }
+
+    TEST(ContainerView, ReleaseCoresOnDetach)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto container = std::make_shared<ContainerView>(factory);
+            auto label = std::make_shared<Label>(factory);
+
+            container->addChildView(label);
+            container->viewCore();
+            ASSERT_TRUE(label->hasViewCore());
+
+            View::releaseCoresOnDetach() = true;
+            container->removeChildView(label);
+            View::releaseCoresOnDetach() = false;
+
+            EXPECT_FALSE(label->hasViewCore());
+            EXPECT_TRUE(container->hasViewCore());
+            EXPECT_TRUE(container->childViews().empty());
+
+            label->text = "Again";
+            container->addChildView(label);
+            ASSERT_TRUE(label->hasViewCore());
+            EXPECT_EQ(std::get<std::string>(label->existingCore<headless::LabelCore>()->text.get()), "Again");
+        });
+    }
+
+    TEST(ContainerView, ReleasingCoresLeavesNoBindings)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto label = std::make_shared<Label>(factory);
+
+            for (int i = 0; i < 10; i++) {
+                label->viewCore();
+                label->releaseViewCore();
+            }
+
+            EXPECT_EQ(label->geometry.backing()->bindingCount(), 0u);
+            EXPECT_EQ(label->visible.backing()->bindingCount(), 0u);
+
+            // The core still reaches the view
+            label->viewCore()->geometry = Rect{1, 2, 3, 4};
+            EXPECT_EQ(label->geometry.get(), Rect(1, 2, 3, 4));
+            label->viewCore()->visible = false;
+            EXPECT_FALSE(label->visible.get());
+        });
+    }
+
+    TEST(ContainerView, BatchedChildInsertion)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->viewCore();
+
+            std::vector<std::shared_ptr<View>> children;
+            for (int i = 0; i < 5; i++) {
+                children.push_back(std::make_shared<Label>(factory));
+            }
+
+            container->beginUpdates();
+            container->addChildViews(children);
+            container->removeChildView(children[1]);
+
+            EXPECT_TRUE(container->childViews().empty());
+            EXPECT_EQ(children[0]->parentView.get().lock(), nullptr);
+            EXPECT_EQ(children[0]->getLayout(), nullptr);
+
+            container->endUpdates();
+
+            ASSERT_EQ(container->childViews().size(), 4u);
+            EXPECT_EQ(container->childIndex(children[2]), 1u);
+            EXPECT_EQ(children[1]->parentView.get().lock(), nullptr);
+            for (auto &child : container->childViews()) {
+                EXPECT_EQ(child->parentView.get().lock(), container);
+                EXPECT_EQ(child->getLayout(), layout);
+                EXPECT_TRUE(child->hasViewCore());
+            }
+            EXPECT_EQ(container->existingCore<headless::ContainerViewCore>()->childViews().size(), 4u);
+
+            container->replaceChildViews({children[1]});
+            ASSERT_EQ(container->childViews().size(), 1u);
+            EXPECT_EQ(children[0]->parentView.get().lock(), nullptr);
+            EXPECT_EQ(children[1]->parentView.get().lock(), container);
+
+            EXPECT_THROW(container->endUpdates(), std::logic_error);
+        });
+    }
+
+    TEST(ContainerView, IndexedChildStorage)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto container = std::make_shared<ContainerView>(factory);
+
+            std::vector<std::shared_ptr<View>> children;
+            for (int i = 0; i < 4; i++) {
+                children.push_back(std::make_shared<Label>(factory));
+                container->addChildView(children.back());
+            }
+
+            container->removeChildView(container->childViewAt(1));
+
+            ASSERT_EQ(container->childViewCount(), 3u);
+            EXPECT_EQ(container->childIndex(children[0]), 0u);
+            EXPECT_EQ(container->childIndex(children[1]), std::nullopt);
+            EXPECT_EQ(container->childIndex(children[2]), 1u);
+            EXPECT_EQ(container->childIndex(children[3]), 2u);
+            EXPECT_EQ(container->childViewAt(2), children[3]);
+
+            std::vector<View *> visited;
+            container->visitChildViews([&](View &child) { visited.push_back(&child); });
+            EXPECT_EQ(visited, (std::vector<View *>{children[0].get(), children[2].get(), children[3].get()}));
+        });
+    }
+
+    TEST(ContainerView, YogaKeepsChildOrderWhenVisibilityChanges)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 100};
+
+            std::vector<std::shared_ptr<View>> children;
+            for (int i = 0; i < 4; i++) {
+                children.push_back(std::make_shared<ContainerView>(factory));
+                children.back()->stylesheet = FlexJsonStringify({"size" : {"height" : 10}});
+                container->addChildView(children.back());
+            }
+
+            auto layoutAndCheck = [&](const std::vector<double> &expectedY) {
+                container->ensureLayoutRegistration();
+                layout->layout(container.get());
+                for (size_t i = 0; i < children.size(); i++) {
+                    if (children[i]->visible.get()) {
+                        EXPECT_EQ(children[i]->geometry->y, expectedY[i]) << "child " << i;
+                    }
+                }
+            };
+
+            layoutAndCheck({0, 10, 20, 30});
+
+            children[1]->visible = false;
+            children[3]->visible = false;
+            layoutAndCheck({0, 0, 10, 0});
+
+            children[3]->visible = true;
+            children[1]->visible = true;
+            layoutAndCheck({0, 10, 20, 30});
+
+            container->removeChildView(children[0]);
+            layoutAndCheck({0, 0, 10, 20});
+        });
+    }
 }
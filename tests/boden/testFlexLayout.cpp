@@ -0,0 +1,230 @@
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/flex.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+#include <gtest/gtest.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        std::shared_ptr<ContainerView> makeRoot(const std::shared_ptr<ui::ViewCoreFactory> &factory,
+                                                const std::shared_ptr<ui::Layout> &layout, const json &style)
+        {
+            auto root = std::make_shared<ContainerView>(factory);
+            root->setLayout(layout);
+            root->geometry = Rect{0, 0, 100, 100};
+            root->stylesheet = style;
+            return root;
+        }
+
+        std::shared_ptr<ContainerView> addChild(const std::shared_ptr<ContainerView> &parent, const json &style)
+        {
+            auto child = std::make_shared<ContainerView>(parent->viewCoreFactory());
+            child->stylesheet = style;
+            parent->addChildView(child);
+            return child;
+        }
+
+        void layoutRoot(const std::shared_ptr<ContainerView> &root)
+        {
+            root->ensureLayoutRegistration();
+            root->getLayout()->layout(root.get());
+        }
+    }
+
+    TEST(FlexLayout, GrowPaddingAndMargin)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto root = makeRoot(factory, std::make_shared<flex::Layout>(),
+                                 FlexJsonStringify({"direction" : "Row", "padding" : {"all" : 10}}));
+            root->geometry = Rect{0, 0, 200, 100};
+
+            auto fixed = addChild(root, FlexJsonStringify({"size" : {"width" : 50}}));
+            auto grow = addChild(root, FlexJsonStringify({"flexGrow" : 1, "flexBasis" : 0, "margin" : {"left" : 5}}));
+            auto accessory = addChild(root, FlexJsonStringify({"size" : {"width" : 30, "height" : 20}}));
+
+            layoutRoot(root);
+
+            EXPECT_EQ(fixed->geometry.get(), Rect(10, 10, 50, 80));
+            EXPECT_EQ(grow->geometry.get(), Rect(65, 10, 95, 80));
+            EXPECT_EQ(accessory->geometry.get(), Rect(160, 10, 30, 20));
+        });
+    }
+
+    TEST(FlexLayout, WrapJustifyAndAlign)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<flex::Layout>();
+
+            auto wrapping = makeRoot(factory, layout,
+                                     FlexJsonStringify({"direction" : "Row", "flexWrap" : "Wrap",
+                                                        "alignContents" : "FlexStart"}));
+            std::vector<std::shared_ptr<ContainerView>> items;
+            for (int i = 0; i < 5; i++) {
+                items.push_back(addChild(wrapping, FlexJsonStringify({"size" : {"width" : 40, "height" : 20}})));
+            }
+            layoutRoot(wrapping);
+            EXPECT_EQ(items[1]->geometry.get(), Rect(40, 0, 40, 20));
+            EXPECT_EQ(items[2]->geometry.get(), Rect(0, 20, 40, 20));
+            EXPECT_EQ(items[4]->geometry.get(), Rect(0, 40, 40, 20));
+
+            auto centered = makeRoot(factory, layout,
+                                     FlexJsonStringify({"justifyContent" : "Center", "alignItems" : "Center"}));
+            auto child = addChild(centered, FlexJsonStringify({"size" : {"width" : 20, "height" : 10}}));
+            layoutRoot(centered);
+            EXPECT_EQ(child->geometry.get(), Rect(40, 45, 20, 10));
+
+            auto reversed = makeRoot(factory, layout, FlexJsonStringify({"direction" : "RowReverse"}));
+            auto first = addChild(reversed, FlexJsonStringify({"size" : {"width" : 30}}));
+            auto second = addChild(reversed, FlexJsonStringify({"size" : {"width" : 30}}));
+            layoutRoot(reversed);
+            EXPECT_EQ(first->geometry->x, 70.0);
+            EXPECT_EQ(second->geometry->x, 40.0);
+        });
+    }
+
+    TEST(FlexLayout, AbsoluteAndPercentSizes)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto root = makeRoot(factory, std::make_shared<flex::Layout>(), json{});
+
+            auto half = addChild(root, FlexJsonStringify({"size" : {"width" : "50%", "height" : "25%"}}));
+            auto limited =
+                addChild(root, FlexJsonStringify({"size" : {"height" : 10}, "maximumSize" : {"width" : 60}}));
+            auto overlay = addChild(root, FlexJsonStringify({
+                "positionType" : "Absolute",
+                "position" : {"right" : 10, "bottom" : 5},
+                "size" : {"width" : 20, "height" : 20}
+            }));
+
+            layoutRoot(root);
+
+            EXPECT_EQ(half->geometry.get(), Rect(0, 0, 50, 25));
+            EXPECT_EQ(limited->geometry.get(), Rect(0, 25, 60, 10));
+            EXPECT_EQ(overlay->geometry.get(), Rect(70, 75, 20, 20));
+        });
+    }
+
+    TEST(FlexLayout, MatchesYogaLayout)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            auto build = [&](const std::shared_ptr<ui::Layout> &layout) {
+                auto root = makeRoot(factory, layout, FlexJsonStringify({"padding" : {"top" : 8}}));
+                for (int i = 0; i < 3; i++) {
+                    auto row = addChild(root, FlexJsonStringify({
+                        "direction" : "Row",
+                        "alignItems" : "Center",
+                        "justifyContent" : "SpaceBetween",
+                        "size" : {"height" : 30},
+                        "padding" : {"left" : 4, "right" : 4}
+                    }));
+                    addChild(row, FlexJsonStringify({"size" : {"width" : 20, "height" : 20}}));
+                    addChild(row, FlexJsonStringify({"flexGrow" : 1, "flexBasis" : 0, "size" : {"height" : 10}}));
+                    addChild(row, FlexJsonStringify({"size" : {"width" : 12, "height" : 12}, "margin" : {"left" : 6}}));
+                }
+                layoutRoot(root);
+                return root;
+            };
+
+            std::vector<Rect> yogaGeometries;
+            auto collect = [](const std::shared_ptr<View> &root, std::vector<Rect> &geometries) {
+                for (auto &row : root->childViews()) {
+                    geometries.push_back(row->geometry.get());
+                    for (auto &cell : row->childViews()) {
+                        geometries.push_back(cell->geometry.get());
+                    }
+                }
+            };
+
+            collect(build(std::make_shared<yoga::Layout>()), yogaGeometries);
+
+            std::vector<Rect> flexGeometries;
+            collect(build(std::make_shared<flex::Layout>()), flexGeometries);
+
+            EXPECT_EQ(flexGeometries, yogaGeometries);
+        });
+    }
+
+    TEST(FlexLayout, OnlyChangedPathsAreLaidOutAgain)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<flex::Layout>();
+            auto root = makeRoot(factory, layout, json{});
+
+            std::vector<std::shared_ptr<ContainerView>> cells;
+            for (int i = 0; i < 10; i++) {
+                auto row = addChild(root, FlexJsonStringify({"direction" : "Row", "size" : {"height" : 44}}));
+                for (int j = 0; j < 10; j++) {
+                    cells.push_back(addChild(row, FlexJsonStringify({"size" : {"width" : 8, "height" : 8}})));
+                }
+            }
+
+            layoutRoot(root);
+            EXPECT_EQ(layout->lastApplyStatistics().visitedCount, 110u);
+            EXPECT_EQ(layout->rebuildCount(), 1u);
+
+            // The rows are visited as children of the root, but only the cells of the dirty row
+            layout->markDirty(cells[42].get());
+            layout->layout(root.get());
+            EXPECT_EQ(layout->lastApplyStatistics().visitedCount, 20u);
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 0u);
+
+            cells[42]->stylesheet = FlexJsonStringify({"size" : {"width" : 16, "height" : 8}});
+            layout->layout(root.get());
+            EXPECT_EQ(cells[43]->geometry->x, 32.0);
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 8u);
+
+            // Hiding a view rebuilds the tree
+            cells[0]->visible = false;
+            layout->layout(root.get());
+            EXPECT_EQ(layout->rebuildCount(), 2u);
+            EXPECT_EQ(cells[1]->geometry->x, 0.0);
+        });
+    }
+
+    TEST(FlexLayout, ChangesOnlyRebuildTheTreesThatContainTheView)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<flex::Layout>();
+            auto first = makeRoot(factory, layout, json{});
+            auto second = makeRoot(factory, layout, json{});
+
+            auto cellStyle = FlexJsonStringify({"size" : {"width" : 8, "height" : 8}});
+            auto firstCell = addChild(first, cellStyle);
+            auto secondCell = addChild(second, cellStyle);
+            auto nested = addChild(second, FlexJsonStringify({"size" : {"height" : 20}}));
+            nested->isLayoutRoot = true;
+            auto nestedCell = addChild(nested, cellStyle);
+
+            layoutRoot(first);
+            layoutRoot(second);
+            layoutRoot(nested);
+            EXPECT_EQ(layout->rebuildCount(), 3u);
+
+            firstCell->visible = false;
+            layout->layout(first.get());
+            layout->layout(second.get());
+            layout->layout(nested.get());
+            EXPECT_EQ(layout->rebuildCount(), 4u);
+
+            // The cell of the nested root is part of both trees of the second root
+            nestedCell->visible = false;
+            layout->layout(first.get());
+            layout->layout(second.get());
+            layout->layout(nested.get());
+            EXPECT_EQ(layout->rebuildCount(), 6u);
+            EXPECT_EQ(secondCell->geometry->height, 8.0);
+        });
+    }
+}
@@ -0,0 +1,159 @@
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/grid.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+#include <gtest/gtest.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        std::shared_ptr<ContainerView> addChild(const std::shared_ptr<ContainerView> &parent, const json &style)
+        {
+            auto child = std::make_shared<ContainerView>(parent->viewCoreFactory());
+            child->stylesheet = style;
+            parent->addChildView(child);
+            return child;
+        }
+    }
+
+    TEST(GridLayout, TracksGapsAndSpans)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<grid::Layout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            root->setLayout(layout);
+            root->geometry = Rect{0, 0, 200, 100};
+            root->stylesheet = GridJsonStringify({
+                "columns" : [ 50, "auto", "1fr" ],
+                "rows" : [20],
+                "columnGap" : 10,
+                "rowGap" : 5,
+                "padding" : 5
+            });
+
+            auto fixed = addChild(root, json{});
+            auto automatic = addChild(root, GridJsonStringify({"size" : {"width" : 30}}));
+            auto fraction = addChild(root, json{});
+            auto spanning = addChild(root, GridJsonStringify({"columnSpan" : 2}));
+            auto tall = addChild(root, GridJsonStringify({"size" : {"height" : 25}}));
+            auto centered = addChild(root, GridJsonStringify({
+                "column" : 3,
+                "row" : 3,
+                "justifySelf" : "Center",
+                "size" : {"width" : 20, "height" : 10}
+            }));
+
+            root->ensureLayoutRegistration();
+            layout->layout(root.get());
+
+            EXPECT_EQ(fixed->geometry.get(), Rect(5, 5, 50, 20));
+            EXPECT_EQ(automatic->geometry.get(), Rect(65, 5, 30, 20));
+            EXPECT_EQ(fraction->geometry.get(), Rect(105, 5, 90, 20));
+            EXPECT_EQ(spanning->geometry.get(), Rect(5, 30, 90, 25));
+            EXPECT_EQ(tall->geometry.get(), Rect(105, 30, 90, 25));
+            EXPECT_EQ(centered->geometry.get(), Rect(140, 60, 20, 10));
+        });
+    }
+
+    TEST(GridLayout, ColumnFlowAndNestedGrids)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<grid::Layout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            root->setLayout(layout);
+            root->geometry = Rect{0, 0, 100, 100};
+            root->stylesheet = GridJsonStringify({"rows" : [ "1fr", "1fr" ], "autoFlow" : "Column"});
+
+            auto first = addChild(root, GridJsonStringify({"size" : {"width" : 40}}));
+            auto second = addChild(root, GridJsonStringify({"size" : {"width" : 20}}));
+            auto nested = addChild(root, GridJsonStringify({"columns" : [ 10, 10 ], "columnGap" : 5}));
+            auto left = addChild(nested, GridJsonStringify({"size" : {"height" : 10}}));
+            auto right = addChild(nested, GridJsonStringify({"size" : {"height" : 10}}));
+
+            root->ensureLayoutRegistration();
+            layout->layout(root.get());
+
+            // The first column is as wide as its widest item, the nested grid is measured to 25
+            EXPECT_EQ(first->geometry.get(), Rect(0, 0, 40, 50));
+            EXPECT_EQ(second->geometry.get(), Rect(0, 50, 20, 50));
+            EXPECT_EQ(nested->geometry.get(), Rect(40, 0, 25, 50));
+            EXPECT_EQ(left->geometry.get(), Rect(0, 0, 10, 10));
+            EXPECT_EQ(right->geometry.get(), Rect(15, 0, 10, 10));
+        });
+    }
+
+    TEST(GridLayout, GridInsideYogaTree)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto yogaLayout = std::make_shared<yoga::Layout>();
+            auto gridLayout = std::make_shared<grid::Layout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            root->setLayout(yogaLayout);
+            root->geometry = Rect{0, 0, 300, 400};
+
+            auto header = addChild(root, FlexJsonStringify({"size" : {"height" : 20}}));
+            auto gallery = addChild(root, GridJsonStringify({"columns" : [ "1fr", "1fr" ], "rowGap" : 10}));
+            gallery->setLayout(gridLayout);
+
+            std::vector<std::shared_ptr<ContainerView>> tiles;
+            for (int i = 0; i < 3; i++) {
+                tiles.push_back(addChild(gallery, GridJsonStringify({"size" : {"height" : 40}})));
+            }
+
+            root->ensureLayoutRegistration();
+            yogaLayout->layout(root.get());
+            EXPECT_EQ(gallery->geometry.get(), Rect(0, 20, 300, 90));
+
+            gridLayout->layout(gallery.get());
+            EXPECT_EQ(tiles[0]->geometry.get(), Rect(0, 0, 150, 40));
+            EXPECT_EQ(tiles[1]->geometry.get(), Rect(150, 0, 150, 40));
+            EXPECT_EQ(tiles[2]->geometry.get(), Rect(0, 50, 150, 40));
+
+            // Hiding a tile removes a row, which the yoga layout picks up through the gallery's size
+            tiles[2]->visible = false;
+            yogaLayout->layout(root.get());
+            EXPECT_EQ(gallery->geometry.get(), Rect(0, 20, 300, 40));
+
+            // The measurement is cached until the gallery's content changes
+            gridLayout->layout(gallery.get());
+            gallery->sizeForSpace(Size{300, Size::componentNone()});
+            EXPECT_EQ(gridLayout->lastStatistics().measuredCount, 0u);
+        });
+    }
+
+    TEST(GridLayout, YogaTreeInsideGridItem)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto gridLayout = std::make_shared<grid::Layout>();
+            auto yogaLayout = std::make_shared<yoga::Layout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            root->setLayout(gridLayout);
+            root->geometry = Rect{0, 0, 200, 100};
+            root->stylesheet = GridJsonStringify({"columns" : [ "1fr", "1fr" ]});
+
+            auto card = addChild(root, GridJsonStringify({"size" : {"height" : 60}}));
+            card->setLayout(yogaLayout);
+            auto title = addChild(card, FlexJsonStringify({"size" : {"height" : 20}}));
+
+            root->ensureLayoutRegistration();
+            gridLayout->layout(root.get());
+            EXPECT_EQ(card->geometry.get(), Rect(0, 0, 100, 60));
+
+            // The grid sizes the item, its own yoga layout treats it as a root
+            yogaLayout->layout(card.get());
+            EXPECT_EQ(title->geometry.get(), Rect(0, 0, 100, 20));
+        });
+    }
+}
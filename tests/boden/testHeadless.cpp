@@ -0,0 +1,284 @@
+#include <bdn/ui/Button.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/ListView.h>
+#include <bdn/ui/ScrollView.h>
+#include <bdn/ui/headless.h>
+#include <gtest/gtest.h>
+
+#include <bdn/Application.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        class FixedHeightDataSource : public ListViewDataSource
+        {
+          public:
+            std::shared_ptr<View> viewForRowIndex(const std::shared_ptr<ListView> &listView, size_t rowIndex,
+                                                  std::shared_ptr<View> reusableView) override
+            {
+                auto label = std::dynamic_pointer_cast<Label>(reusableView);
+                if (!label) {
+                    label = std::make_shared<Label>(listView->viewCoreFactory());
+                    createdViews++;
+                }
+                label->text = std::to_string(rowIndex);
+                return label;
+            }
+
+            size_t numberOfRows(const std::shared_ptr<ListView> &listView) override { return 1000; }
+            float heightForRowIndex(const std::shared_ptr<ListView> &listView, size_t rowIndex) override { return 20; }
+
+            size_t createdViews = 0;
+        };
+    }
+
+    TEST(Headless, FixedTextMetrics)
+    {
+        headless::FixedTextMetrics metrics(10, 20, 15);
+
+        EXPECT_EQ(metrics.measure("", Size::none(), false), Size(0, 0));
+        EXPECT_EQ(metrics.measure("Hello", Size::none(), false), Size(50, 20));
+        EXPECT_EQ(metrics.measure("Hello\nWorld!", Size::none(), false), Size(60, 40));
+        EXPECT_EQ(metrics.measure("\xC3\xA4\xC3\xB6", Size::none(), false), Size(20, 20));
+
+        EXPECT_EQ(metrics.measure("HelloWorld", Size(45, Size::componentNone()), true), Size(40, 60));
+        EXPECT_EQ(metrics.measure("HelloWorld", Size(45, Size::componentNone()), false), Size(100, 20));
+    }
+
+    TEST(Headless, LabelMeasurement)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>(
+                std::make_shared<headless::FixedTextMetrics>(10, 20, 15));
+
+            auto label = std::make_shared<Label>(factory);
+            label->text = "HelloWorld";
+
+            EXPECT_NE(label->core<headless::LabelCore>(), nullptr);
+            EXPECT_EQ(label->sizeForSpace(Size(45, 100)), Size(100, 20));
+            EXPECT_EQ(label->baseline(Size(100, 20)), 15);
+
+            label->wrap = true;
+            EXPECT_EQ(label->sizeForSpace(Size(45, 100)), Size(40, 60));
+        });
+    }
+
+    TEST(Headless, ButtonClick)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto button = std::make_shared<Button>(std::make_shared<headless::ViewCoreFactory>());
+            int clicks = 0;
+            button->onClick() += [&clicks](auto) { clicks++; };
+
+            button->core<headless::ButtonCore>()->click();
+            EXPECT_EQ(clicks, 1);
+        });
+    }
+
+    TEST(Headless, ScrollViewClampsScrollPosition)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto scrollView = std::make_shared<ScrollView>(factory);
+            auto content = std::make_shared<ContainerView>(factory);
+
+            scrollView->geometry = Rect{0, 0, 100, 100};
+            scrollView->contentView = content;
+            content->geometry = Rect{0, 0, 100, 300};
+
+            auto core = scrollView->core<headless::ScrollViewCore>();
+
+            core->scrollTo(Point{50, 150});
+            EXPECT_EQ(scrollView->visibleClientRect.get(), Rect(0, 150, 100, 100));
+
+            core->scrollTo(Point{0, 1000});
+            EXPECT_EQ(scrollView->visibleClientRect.get(), Rect(0, 200, 100, 100));
+
+            scrollView->scrollClientRectToVisible(Rect{0, 10, 100, 20});
+            EXPECT_EQ(scrollView->visibleClientRect.get(), Rect(0, 10, 100, 100));
+        });
+    }
+
+    TEST(Headless, ListViewCreatesOnlyVisibleRows)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto dataSource = std::make_shared<FixedHeightDataSource>();
+            auto listView = std::make_shared<ListView>(std::make_shared<headless::ViewCoreFactory>());
+
+            listView->geometry = Rect{0, 0, 100, 100};
+            listView->dataSource = dataSource;
+
+            auto core = listView->core<headless::ListViewCore>();
+            auto rows = core->visibleRowViews();
+
+            EXPECT_EQ(rows.size(), 5u);
+            EXPECT_EQ(rows.begin()->first, 0u);
+            EXPECT_EQ(listView->rowIndexForView(rows[3]), 3u);
+
+            core->scrollTo(510);
+            rows = core->visibleRowViews();
+
+            EXPECT_EQ(rows.size(), 6u);
+            EXPECT_EQ(rows.begin()->first, 25u);
+            EXPECT_EQ(dataSource->createdViews, 6u);
+        });
+    }
+
+    TEST(Headless, ScrollViewVirtualizesContent)
+    {
+        auto factory = std::make_shared<headless::ViewCoreFactory>();
+        std::shared_ptr<ScrollView> scrollView;
+        std::shared_ptr<ContainerView> content;
+        std::vector<std::shared_ptr<View>> rows;
+
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            scrollView = std::make_shared<ScrollView>(factory);
+            content = std::make_shared<ContainerView>(factory);
+
+            for (int i = 0; i < 1000; i++) {
+                rows.push_back(std::make_shared<ContainerView>(factory));
+            }
+            content->addChildViews(rows);
+
+            scrollView->geometry = Rect{0, 0, 100, 100};
+            scrollView->estimatedChildExtent = 20.;
+            scrollView->virtualizationOverscan = 40.;
+            scrollView->virtualizeContent = true;
+            scrollView->contentView = content;
+
+            auto core = scrollView->core<headless::ScrollViewCore>();
+            const auto *virtualizer = scrollView->contentVirtualizer();
+            ASSERT_NE(virtualizer, nullptr);
+            EXPECT_EQ(virtualizer->totalExtent(), 20000.);
+
+            // The visible rows and the overscan of 40 below them
+            EXPECT_EQ(content->materializedRange(), std::pair<size_t, size_t>(0, 8));
+            EXPECT_TRUE(rows[7]->hasViewCore());
+            EXPECT_FALSE(rows[8]->hasViewCore());
+
+            content->geometry = Rect{0, 0, 100, virtualizer->totalExtent()};
+            core->scrollTo(Point{0, 510});
+            EXPECT_EQ(content->materializedRange(), std::pair<size_t, size_t>(23, 33));
+            EXPECT_FALSE(rows[0]->hasViewCore());
+            EXPECT_TRUE(rows[25]->hasViewCore());
+            EXPECT_EQ(virtualizer->offsetOfChild(23), 460.);
+
+            size_t visited = 0;
+            content->visitChildViews([&](View &) { visited++; });
+            EXPECT_EQ(visited, 12u);
+
+            // Rows that come into view above the others are inserted into the core at their position
+            core->scrollTo(Point{0, 490});
+            EXPECT_EQ(content->materializedRange(), std::pair<size_t, size_t>(22, 32));
+            auto coreChildren = content->core<headless::ContainerViewCore>()->childViews();
+            ASSERT_EQ(coreChildren.size(), 10u);
+            EXPECT_EQ(coreChildren.front(), rows[22]);
+            EXPECT_EQ(coreChildren.back(), rows[31]);
+
+            // Appended rows are not materialized while they are out of view
+            auto appended = std::make_shared<ContainerView>(factory);
+            content->addChildView(appended);
+            rows.push_back(appended);
+            EXPECT_EQ(virtualizer->totalExtent(), 20020.);
+            EXPECT_FALSE(appended->hasViewCore());
+
+            // The other rows get their cores with the next iteration of the dispatch queue
+            scrollView->virtualizeContent = false;
+            EXPECT_EQ(scrollView->contentVirtualizer(), nullptr);
+            EXPECT_FALSE(content->isVirtualized());
+            EXPECT_FALSE(rows[0]->hasViewCore());
+        });
+
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            EXPECT_TRUE(rows[0]->hasViewCore());
+            EXPECT_EQ(content->core<headless::ContainerViewCore>()->childViews(), rows);
+
+            scrollView.reset();
+            content.reset();
+            rows.clear();
+        });
+    }
+
+    TEST(Headless, ScrollingVirtualizedContentLeavesNoBindings)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto scrollView = std::make_shared<ScrollView>(factory);
+            auto content = std::make_shared<ContainerView>(factory);
+            std::vector<std::shared_ptr<View>> rows;
+            for (int i = 0; i < 100; i++) {
+                rows.push_back(std::make_shared<ContainerView>(factory));
+            }
+            content->addChildViews(rows);
+
+            scrollView->geometry = Rect{0, 0, 100, 100};
+            scrollView->estimatedChildExtent = 20.;
+            scrollView->virtualizeContent = true;
+            scrollView->contentView = content;
+
+            auto core = scrollView->core<headless::ScrollViewCore>();
+            content->geometry = Rect{0, 0, 100, scrollView->contentVirtualizer()->totalExtent()};
+
+            for (int i = 0; i < 20; i++) {
+                core->scrollTo(Point{0, 1500});
+                EXPECT_FALSE(rows[0]->hasViewCore());
+                core->scrollTo(Point{0, 0});
+                EXPECT_TRUE(rows[0]->hasViewCore());
+            }
+
+            for (const auto &row : rows) {
+                EXPECT_EQ(row->geometry.backing()->bindingCount(), 0u);
+                EXPECT_EQ(row->visible.backing()->bindingCount(), 0u);
+            }
+        });
+    }
+
+    TEST(Headless, DestroyingVirtualizedContentCreatesNoCores)
+    {
+        auto factory = std::make_shared<headless::ViewCoreFactory>();
+        std::vector<std::shared_ptr<View>> rows;
+
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            auto scrollView = std::make_shared<ScrollView>(factory);
+            auto content = std::make_shared<ContainerView>(factory);
+            for (int i = 0; i < 1000; i++) {
+                rows.push_back(std::make_shared<ContainerView>(factory));
+            }
+            content->addChildViews(rows);
+
+            scrollView->geometry = Rect{0, 0, 100, 100};
+            scrollView->estimatedChildExtent = 20.;
+            scrollView->virtualizeContent = true;
+            scrollView->contentView = content;
+            scrollView->viewCore();
+        });
+
+        bdn::App()->dispatchQueue()->dispatchSync([&]() {
+            EXPECT_TRUE(rows[0]->hasViewCore());
+            EXPECT_FALSE(rows[500]->hasViewCore());
+            rows.clear();
+        });
+    }
+
+    TEST(Headless, PendingLayouts)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto label = std::make_shared<Label>(std::make_shared<headless::ViewCoreFactory>());
+            auto core = label->core<headless::LabelCore>();
+
+            headless::ViewCore::performPendingLayouts();
+            headless::ViewCore::resetStatistics();
+
+            label->text = "Hello";
+            EXPECT_TRUE(core->isLayoutScheduled());
+
+            headless::ViewCore::performPendingLayouts();
+            EXPECT_FALSE(core->isLayoutScheduled());
+            EXPECT_EQ(headless::ViewCore::statistics().layoutCount, 1u);
+        });
+    }
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <bdn/MemoryArena.h>
+#include <bdn/property/Property.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bdn
+{
+    TEST(MemoryArena, NoScope)
+    {
+        EXPECT_EQ(nullptr, MemoryArena::current());
+
+        auto arena = MemoryArena::create();
+        auto value = allocateShared<int>(42);
+        EXPECT_EQ(0u, arena->statistics().allocationCount);
+    }
+
+    TEST(MemoryArena, ScopesNest)
+    {
+        auto outer = MemoryArena::create(MemoryArena::Kind::Monotonic);
+        auto inner = MemoryArena::create(MemoryArena::Kind::Pooled);
+
+        {
+            MemoryArena::Scope outerScope(outer);
+            EXPECT_EQ(outer, MemoryArena::current());
+            {
+                MemoryArena::Scope innerScope(inner);
+                EXPECT_EQ(inner, MemoryArena::current());
+            }
+            EXPECT_EQ(outer, MemoryArena::current());
+        }
+
+        EXPECT_EQ(nullptr, MemoryArena::current());
+    }
+
+    TEST(MemoryArena, AllocateShared)
+    {
+        auto arena = MemoryArena::create();
+        std::shared_ptr<std::string> value;
+        {
+            MemoryArena::Scope scope(arena);
+            value = allocateShared<std::string>("Hello");
+        }
+
+        auto statistics = arena->statistics();
+        EXPECT_EQ(1u, statistics.allocationCount);
+        EXPECT_GE(statistics.bytesInUse, sizeof(std::string));
+
+        value.reset();
+        EXPECT_EQ(1u, arena->statistics().deallocationCount);
+        EXPECT_EQ(0u, arena->statistics().bytesInUse);
+    }
+
+    TEST(MemoryArena, AllocatorWithoutArena)
+    {
+        static_assert(sizeof(ArenaAllocator<int>) == sizeof(void *));
+
+        ArenaAllocator<int> allocator;
+        EXPECT_EQ(nullptr, allocator.arena());
+
+        std::weak_ptr<MemoryArena> weakArena;
+        {
+            auto arena = MemoryArena::create();
+            weakArena = arena;
+            ArenaAllocator<int> arenaAllocator(arena);
+            allocator = arenaAllocator;
+        }
+
+        EXPECT_FALSE(weakArena.expired());
+        allocator = ArenaAllocator<int>();
+        EXPECT_TRUE(weakArena.expired());
+    }
+
+    TEST(MemoryArena, AllocatorMoves)
+    {
+        static_assert(std::is_nothrow_move_constructible_v<ArenaAllocator<int>>);
+        static_assert(std::is_nothrow_move_assignable_v<ArenaAllocator<int>>);
+        static_assert(std::is_nothrow_copy_constructible_v<ArenaAllocator<int>>);
+
+        std::weak_ptr<MemoryArena> weakArena;
+        {
+            auto arena = MemoryArena::create();
+            weakArena = arena;
+
+            ArenaAllocator<int> allocator(arena);
+            ArenaAllocator<int> moved(std::move(allocator));
+            // NOLINTNEXTLINE(bugprone-use-after-move)
+            EXPECT_EQ(allocator.arena(), arena.get());
+            EXPECT_EQ(moved.arena(), arena.get());
+
+            std::vector<int, ArenaAllocator<int>> values(moved);
+            values.push_back(1);
+            auto movedValues = std::move(values);
+            EXPECT_EQ(movedValues.get_allocator().arena(), arena.get());
+        }
+
+        EXPECT_TRUE(weakArena.expired());
+    }
+
+    TEST(MemoryArena, ObjectsKeepArenaAlive)
+    {
+        std::weak_ptr<MemoryArena> weakArena;
+        std::shared_ptr<int> value;
+        {
+            auto arena = MemoryArena::create(MemoryArena::Kind::Monotonic);
+            weakArena = arena;
+            MemoryArena::Scope scope(arena);
+            value = allocateShared<int>(42);
+        }
+
+        EXPECT_FALSE(weakArena.expired());
+        EXPECT_EQ(42, *value);
+
+        value.reset();
+        EXPECT_TRUE(weakArena.expired());
+    }
+
+    TEST(MemoryArena, PropertiesAndNotifiers)
+    {
+        auto arena = MemoryArena::create();
+        {
+            MemoryArena::Scope scope(arena);
+
+            Property<int> a;
+            Property<int> b;
+            b.bind(a);
+
+            int calls = 0;
+            b.onChange() += [&calls](auto &) { calls++; };
+            a = 5;
+
+            EXPECT_EQ(5, b.get());
+            EXPECT_EQ(1, calls);
+            EXPECT_GT(arena->statistics().allocationCount, 0u);
+        }
+
+        EXPECT_EQ(0u, arena->statistics().bytesInUse);
+    }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <bdn/ObservableMap.h>
+#include <string>
+
+namespace bdn
+{
+    TEST(ObservableMap, SingleMutations)
+    {
+        ObservableMap<std::string, int> map;
+
+        std::vector<KeyChangeSet<std::string>> changeSets;
+        map.onChange() += [&](const auto &, const auto &changeSet) { changeSets.push_back(changeSet); };
+
+        map.set("a", 1);
+        map.set("a", 2);
+        map.erase("a");
+        EXPECT_FALSE(map.erase("a"));
+
+        ASSERT_EQ(3u, changeSets.size());
+        EXPECT_EQ(std::vector<std::string>{"a"}, changeSets[0].inserted);
+        EXPECT_EQ(std::vector<std::string>{"a"}, changeSets[1].updated);
+        EXPECT_EQ(std::vector<std::string>{"a"}, changeSets[2].removed);
+    }
+
+    TEST(ObservableMap, BatchCoalesces)
+    {
+        ObservableMap<std::string, int> map({{"a", 1}, {"b", 2}, {"c", 3}});
+
+        int notifications = 0;
+        KeyChangeSet<std::string> changeSet;
+        map.onChange() += [&](const auto &, const auto &c) {
+            notifications++;
+            changeSet = c;
+        };
+
+        map.update([&]() {
+            map.set("x", 10);
+            map.erase("x");
+            map.erase("a");
+            map.erase("b");
+            map.set("b", 20);
+            map.modify("c", [](int &value) { value++; });
+            map.set("d", 4);
+        });
+
+        EXPECT_EQ(1, notifications);
+        EXPECT_EQ(std::vector<std::string>{"d"}, changeSet.inserted);
+        EXPECT_EQ(std::vector<std::string>{"a"}, changeSet.removed);
+        EXPECT_EQ((std::vector<std::string>{"b", "c"}), changeSet.updated);
+        EXPECT_EQ(4, map.at("c"));
+    }
+
+    TEST(ObservableMap, Clear)
+    {
+        ObservableMap<std::string, int> map({{"a", 1}, {"b", 2}});
+
+        int notifications = 0;
+        KeyChangeSet<std::string> changeSet;
+        map.onChange() += [&](const auto &, const auto &c) {
+            notifications++;
+            changeSet = c;
+        };
+
+        map.clear();
+
+        EXPECT_EQ(1, notifications);
+        EXPECT_EQ((std::vector<std::string>{"a", "b"}), changeSet.removed);
+        EXPECT_TRUE(map.empty());
+    }
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <bdn/ObservableVector.h>
+#include <string>
+
+namespace bdn
+{
+    namespace
+    {
+        // Reconstructs the new state from the old state as a consumer would
+        std::vector<std::string> applyChangeSet(const std::vector<std::string> &oldItems,
+                                                const std::vector<std::string> &newItems,
+                                                const IndexChangeSet &changeSet)
+        {
+            std::vector<bool> gone(oldItems.size(), false);
+            for (const auto &range : changeSet.removed) {
+                for (size_t i = range.index; i < range.index + range.count; i++) {
+                    gone[i] = true;
+                }
+            }
+            for (const auto &move : changeSet.moved) {
+                gone[move.from] = true;
+            }
+
+            std::vector<bool> filled(newItems.size(), false);
+            std::vector<std::string> result(newItems.size());
+            for (const auto &range : changeSet.inserted) {
+                for (size_t i = range.index; i < range.index + range.count; i++) {
+                    result[i] = newItems[i];
+                    filled[i] = true;
+                }
+            }
+            for (const auto &move : changeSet.moved) {
+                result[move.to] = oldItems[move.from];
+                filled[move.to] = true;
+            }
+
+            size_t next = 0;
+            for (size_t i = 0; i < oldItems.size(); i++) {
+                if (gone[i]) {
+                    continue;
+                }
+                while (filled[next]) {
+                    next++;
+                }
+                result[next++] = oldItems[i];
+            }
+            for (size_t index : changeSet.updated) {
+                result[index] = newItems[index];
+            }
+            return result;
+        }
+    }
+
+    TEST(ObservableVector, SingleMutations)
+    {
+        ObservableVector<std::string> vector{"a", "b", "c"};
+
+        std::vector<IndexChangeSet> changeSets;
+        vector.onChange() += [&](const auto &, const IndexChangeSet &changeSet) { changeSets.push_back(changeSet); };
+
+        vector.insert(1, "x");
+        vector.erase(0);
+        vector.move(0, 2);
+        vector.set(1, "y");
+
+        ASSERT_EQ(4u, changeSets.size());
+        EXPECT_EQ((std::vector<IndexChangeSet::Range>{{1, 1}}), changeSets[0].inserted);
+        EXPECT_EQ((std::vector<IndexChangeSet::Range>{{0, 1}}), changeSets[1].removed);
+        EXPECT_EQ((std::vector<IndexChangeSet::Move>{{0, 2}}), changeSets[2].moved);
+        EXPECT_EQ((std::vector<size_t>{1}), changeSets[3].updated);
+
+        EXPECT_EQ((std::vector<std::string>{"b", "y", "x"}), vector.items());
+    }
+
+    TEST(ObservableVector, BatchCoalesces)
+    {
+        ObservableVector<std::string> vector{"a", "b", "c", "d", "e"};
+        auto oldItems = vector.items();
+
+        int notifications = 0;
+        IndexChangeSet changeSet;
+        vector.onChange() += [&](const auto &, const IndexChangeSet &c) {
+            notifications++;
+            changeSet = c;
+        };
+
+        vector.update([&]() {
+            vector.erase(1);        // a c d e
+            vector.insert(0, "x");  // x a c d e
+            vector.move(4, 1);      // x e a c d
+            vector.set(3, "C");     // x e a C d
+            vector.insert(5, "y");  // x e a C d y
+            vector.insert(6, "z");  // x e a C d y z
+            vector.erase(6);        // x e a C d y
+        });
+
+        EXPECT_EQ(1, notifications);
+        EXPECT_EQ((std::vector<IndexChangeSet::Range>{{1, 1}}), changeSet.removed);
+        EXPECT_EQ((std::vector<IndexChangeSet::Range>{{0, 1}, {5, 1}}), changeSet.inserted);
+        EXPECT_EQ((std::vector<IndexChangeSet::Move>{{4, 1}}), changeSet.moved);
+        EXPECT_EQ((std::vector<size_t>{3}), changeSet.updated);
+
+        EXPECT_EQ(vector.items(), applyChangeSet(oldItems, vector.items(), changeSet));
+    }
+
+    TEST(ObservableVector, NestedBatches)
+    {
+        ObservableVector<std::string> vector{"a"};
+        int notifications = 0;
+        vector.onChange() += [&](const auto &, const auto &) { notifications++; };
+
+        vector.beginUpdates();
+        vector.push_back("b");
+        vector.update([&]() { vector.push_back("c"); });
+        EXPECT_EQ(0, notifications);
+        vector.endUpdates();
+
+        EXPECT_EQ(1, notifications);
+    }
+
+    TEST(ObservableVector, EmptyBatchDoesNotNotify)
+    {
+        ObservableVector<std::string> vector{"a"};
+        int notifications = 0;
+        vector.onChange() += [&](const auto &, const auto &) { notifications++; };
+
+        vector.update([&]() {
+            vector.push_back("b");
+            vector.erase(1);
+        });
+
+        EXPECT_EQ(0, notifications);
+    }
+
+    TEST(ObservableVector, BatchReorder)
+    {
+        ObservableVector<std::string> vector{"a", "b", "c", "d", "e", "f"};
+        auto oldItems = vector.items();
+
+        IndexChangeSet changeSet;
+        vector.onChange() += [&](const auto &, const IndexChangeSet &c) { changeSet = c; };
+
+        vector.update([&]() {
+            vector.move(0, 5);
+            vector.move(0, 3);
+            vector.move(1, 0);
+        });
+
+        EXPECT_TRUE(changeSet.inserted.empty());
+        EXPECT_TRUE(changeSet.removed.empty());
+        EXPECT_EQ(vector.items(), applyChangeSet(oldItems, vector.items(), changeSet));
+    }
+
+    TEST(ObservableVector, OutOfRange)
+    {
+        ObservableVector<std::string> vector{"a"};
+        EXPECT_THROW(vector.insert(2, "x"), std::out_of_range);
+        EXPECT_THROW(vector.erase(1), std::out_of_range);
+        EXPECT_THROW(vector.move(0, 1), std::out_of_range);
+        EXPECT_THROW(vector.endUpdates(), std::logic_error);
+    }
+}
@@ -75,4 +75,167 @@ namespace bdn
             EXPECT_EQ(view->stylesheet->at("hello"), "world");
         });
     }
+
+    TEST(Styler, OnlyViewsUsingTheConditionAreRematched)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto themed = std::make_shared<ContainerView>();
+            auto platform = std::make_shared<ContainerView>();
+            auto combined = std::make_shared<ContainerView>();
+            Styler styler;
+
+            styler.setCondition("os", std::make_shared<Styler::equals_condition>("ios"));
+            styler.setCondition("theme", std::make_shared<Styler::equals_condition>("light"));
+
+            styler.setStyleSheet(themed, JsonStringify([
+                {"if" : {"theme" : "dark"}, "color" : "white"}, {"if" : {"theme" : "light"}, "color" : "black"}
+            ]));
+            styler.setStyleSheet(platform, JsonStringify([ {"if" : {"os" : "ios"}, "padding" : 5} ]));
+            styler.setStyleSheet(combined, JsonStringify([ {"if" : {"theme" : "dark", "os" : "android"}, "x" : 1} ]));
+            EXPECT_EQ(themed->stylesheet->at("color"), "black");
+            EXPECT_EQ(themed->stylesheet->count("if"), 0u);
+
+            styler.resetStatistics();
+            styler.setCondition("theme", std::make_shared<Styler::equals_condition>("dark"));
+            EXPECT_EQ(themed->stylesheet->at("color"), "white");
+            EXPECT_EQ(combined->stylesheet->count("x"), 0u);
+
+            // Each distinct value is tested once, the combined view still does not match
+            auto statistics = styler.statistics();
+            EXPECT_EQ(statistics.evaluatedConditionCount, 2u);
+            EXPECT_EQ(statistics.rematchedViewCount, 1u);
+            EXPECT_EQ(statistics.assignedStylesheetCount, 1u);
+
+            styler.setCondition("theme", std::make_shared<Styler::equals_condition>("dark"));
+            EXPECT_EQ(styler.statistics().rematchedViewCount, 1u);
+        });
+    }
+
+    TEST(Styler, UnchangedStylesheetsAreNotAssigned)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto view = std::make_shared<ContainerView>();
+            Styler styler;
+            styler.setCondition("size", std::make_shared<Styler::equals_condition>("small"));
+
+            const json stylesheet = JsonStringify([
+                {"if" : {"size" : "small"}, "padding" : 4}, {"if" : {"size" : "large"}, "padding" : 4}
+            ]);
+            styler.setStyleSheet(view, stylesheet);
+
+            size_t assignments = 0;
+            view->stylesheet.onChange() += [&](auto &) { assignments++; };
+
+            styler.setCondition("size", std::make_shared<Styler::equals_condition>("large"));
+            styler.setStyleSheet(view, stylesheet);
+            EXPECT_EQ(assignments, 0u);
+            EXPECT_EQ(styler.statistics().unchangedStylesheetCount, 2u);
+            EXPECT_EQ(view->stylesheet->at("padding"), 4);
+        });
+    }
+
+    TEST(Styler, EqualStylesheetsShareAProgram)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            Styler styler;
+            styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("portrait"));
+
+            const json stylesheet = JsonStringify([
+                {"height" : 44}, {"if" : {"orientation" : "landscape"}, "height" : 32}, {"padding" : 2}
+            ]);
+
+            std::vector<std::shared_ptr<ContainerView>> views;
+            for (int i = 0; i < 10; i++) {
+                auto view = std::make_shared<ContainerView>();
+                styler.setStyleSheet(view, stylesheet);
+                views.push_back(view);
+            }
+
+            auto statistics = styler.statistics();
+            EXPECT_EQ(statistics.compiledProgramCount, 1u);
+            EXPECT_EQ(statistics.sharedProgramCount, 9u);
+            EXPECT_EQ(statistics.mergedResultCount, 1u);
+
+            styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("landscape"));
+            styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("portrait"));
+            styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("landscape"));
+
+            // Each state of the conditions is merged once, no matter how many views share the program
+            statistics = styler.statistics();
+            EXPECT_EQ(statistics.mergedResultCount, 2u);
+            EXPECT_EQ(statistics.rematchedViewCount, 30u);
+            for (const auto &view : views) {
+                EXPECT_EQ(view->stylesheet->at("height"), 32);
+                EXPECT_EQ(view->stylesheet->at("padding"), 2);
+            }
+        });
+    }
+
+    TEST(Styler, OptionsAreMergedInOrder)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto view = std::make_shared<ContainerView>();
+            Styler styler;
+            styler.setCondition("test", std::make_shared<Styler::equals_condition>(1));
+
+            styler.setStyleSheet(view, JsonStringify([
+                {"a" : 1, "b" : 1}, {"if" : {"test" : 1}, "a" : 2, "b" : 2}, {"a" : 3}, {"if" : {"test" : 1}, "c" : 4}
+            ]));
+            EXPECT_EQ(view->stylesheet->at("a"), 3);
+            EXPECT_EQ(view->stylesheet->at("b"), 2);
+            EXPECT_EQ(view->stylesheet->at("c"), 4);
+
+            styler.setCondition("test", std::make_shared<Styler::equals_condition>(2));
+            EXPECT_EQ(view->stylesheet->at("a"), 3);
+            EXPECT_EQ(view->stylesheet->at("b"), 1);
+            EXPECT_EQ(view->stylesheet->count("c"), 0u);
+        });
+    }
+
+    TEST(Styler, UpdateMatchesViewsOnce)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto view = std::make_shared<ContainerView>();
+            auto other = std::make_shared<ContainerView>();
+            Styler styler;
+            styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("portrait"));
+            styler.setCondition("dark", std::make_shared<Styler::equals_condition>(false));
+
+            styler.setStyleSheet(view, JsonStringify([
+                {"height" : 44}, {"if" : {"orientation" : "landscape"}, "height" : 32},
+                {"if" : {"dark" : true}, "color" : "white"}
+            ]));
+
+            size_t assignments = 0;
+            view->stylesheet.onChange() += [&](auto &) { assignments++; };
+
+            styler.resetStatistics();
+            styler.update([&]() {
+                styler.setCondition("orientation", std::make_shared<Styler::equals_condition>("landscape"));
+                styler.update([&]() {
+                    styler.setCondition("dark", std::make_shared<Styler::equals_condition>(true));
+                    styler.setStyleSheet(other, JsonStringify([ {"if" : {"dark" : true}, "color" : "white"} ]));
+                });
+
+                // Nothing is assigned until the outermost update ends
+                EXPECT_EQ(assignments, 0u);
+                EXPECT_EQ(other->stylesheet->count("color"), 0u);
+            });
+
+            EXPECT_EQ(assignments, 1u);
+            EXPECT_EQ(styler.statistics().rematchedViewCount, 2u);
+            EXPECT_EQ(view->stylesheet->at("height"), 32);
+            EXPECT_EQ(view->stylesheet->at("color"), "white");
+            EXPECT_EQ(other->stylesheet->at("color"), "white");
+
+            // Changes that cancel out within an update do not assign anything
+            styler.update([&]() {
+                styler.setCondition("dark", std::make_shared<Styler::equals_condition>(false));
+                styler.setCondition("dark", std::make_shared<Styler::equals_condition>(true));
+            });
+            EXPECT_EQ(assignments, 1u);
+
+            EXPECT_THROW(styler.endUpdates(), std::logic_error);
+        });
+    }
 }
@@ -0,0 +1,64 @@
+#include <bdn/Application.h>
+#include <bdn/ui/Button.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <gtest/gtest.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        int s_registerCalls = 0;
+
+        void countingRegister(const std::shared_ptr<ui::ViewCoreFactory> &factory)
+        {
+            s_registerCalls++;
+            factory->registerCoreType<headless::LabelCore, Label>();
+        }
+    }
+
+    TEST(ViewCoreFactory, FirstRegistrationWins)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<ui::ViewCoreFactory>();
+
+            EXPECT_TRUE((factory->registerCoreType<headless::LabelCore, Label>()));
+            EXPECT_FALSE((factory->registerCoreType<headless::ButtonCore, Label>()));
+
+            EXPECT_NE(std::dynamic_pointer_cast<headless::LabelCore>(factory->createViewCore(typeid(Label))), nullptr);
+        });
+    }
+
+    TEST(ViewCoreFactory, FindsEveryRegisteredType)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+
+            EXPECT_NE(std::dynamic_pointer_cast<headless::LabelCore>(factory->createViewCore(typeid(Label))), nullptr);
+            EXPECT_NE(std::dynamic_pointer_cast<headless::ButtonCore>(factory->createViewCore(typeid(Button))),
+                      nullptr);
+        });
+    }
+
+    TEST(ViewCoreFactory, UnsupportedType)
+    {
+        auto factory = std::make_shared<ui::ViewCoreFactory>();
+        EXPECT_THROW(factory->createViewCore(typeid(Button)), ViewCoreTypeNotSupportedError);
+    }
+
+    TEST(ViewCoreFactory, RegisterOnce)
+    {
+        auto factory = std::make_shared<ui::ViewCoreFactory>();
+        static const char key = 0;
+
+        s_registerCalls = 0;
+        factory->registerOnce(&key, &countingRegister);
+        factory->registerOnce(&key, &countingRegister);
+        EXPECT_EQ(s_registerCalls, 1);
+
+        std::make_shared<ui::ViewCoreFactory>()->registerOnce(&key, &countingRegister);
+        EXPECT_EQ(s_registerCalls, 2);
+    }
+}
@@ -0,0 +1,109 @@
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <gtest/gtest.h>
+
+#include <set>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    namespace
+    {
+        class CountingLayout : public ui::Layout
+        {
+          public:
+            void registerView(View *view) override
+            {
+                registerCount++;
+                views.insert(view);
+            }
+            void unregisterView(View *view) override
+            {
+                unregisterCount++;
+                views.erase(view);
+            }
+
+            void markDirty(View *view) override {}
+            void updateStylesheet(View *view) override {}
+            void layout(View *view) override {}
+
+          public:
+            int registerCount = 0;
+            int unregisterCount = 0;
+            std::set<View *> views;
+        };
+
+        std::vector<std::shared_ptr<ContainerView>> makeChain(const std::shared_ptr<ui::ViewCoreFactory> &factory,
+                                                              size_t depth)
+        {
+            std::vector<std::shared_ptr<ContainerView>> chain;
+            for (size_t i = 0; i < depth; i++) {
+                chain.push_back(std::make_shared<ContainerView>(factory));
+                if (i > 0) {
+                    chain[i - 1]->addChildView(chain[i]);
+                }
+            }
+            return chain;
+        }
+    }
+
+    TEST(ViewLayout, InheritedLazily)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<CountingLayout>();
+            auto otherLayout = std::make_shared<CountingLayout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            auto chain = makeChain(factory, 5);
+            root->setLayout(layout);
+            root->addChildView(chain.front());
+
+            EXPECT_EQ(chain.back()->getLayout(), layout);
+            EXPECT_EQ(layout->registerCount, 0);
+
+            root->ensureLayoutRegistration();
+            EXPECT_EQ(layout->registerCount, 6);
+
+            root->setLayout(otherLayout);
+            EXPECT_EQ(chain.back()->getLayout(), otherLayout);
+
+            root->ensureLayoutRegistration();
+            EXPECT_EQ(layout->unregisterCount, 6);
+            EXPECT_TRUE(layout->views.empty());
+            EXPECT_EQ(otherLayout->registerCount, 6);
+        });
+    }
+
+    TEST(ViewLayout, MovingSubtreeOnlyReregistersItsRoot)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<CountingLayout>();
+
+            auto root = std::make_shared<ContainerView>(factory);
+            auto left = std::make_shared<ContainerView>(factory);
+            auto right = std::make_shared<ContainerView>(factory);
+            root->setLayout(layout);
+            root->addChildView(left);
+            root->addChildView(right);
+
+            auto chain = makeChain(factory, 10);
+            left->addChildView(chain.front());
+            root->ensureLayoutRegistration();
+            EXPECT_EQ(layout->registerCount, 13);
+
+            left->removeChildView(chain.front());
+            right->addChildView(chain.front());
+            root->ensureLayoutRegistration();
+
+            EXPECT_EQ(layout->unregisterCount, 1);
+            EXPECT_EQ(layout->registerCount, 14);
+            EXPECT_EQ(layout->views.size(), 13u);
+            EXPECT_EQ(chain.back()->getLayout(), layout);
+        });
+    }
+}
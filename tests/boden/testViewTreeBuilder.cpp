@@ -0,0 +1,69 @@
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/ViewTreeBuilder.h>
+#include <bdn/ui/headless.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+
+using namespace std::chrono_literals;
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    TEST(ViewTreeBuilder, BuildsOnWorkerAndAttachesOnMainThread)
+    {
+        auto factory = std::make_shared<headless::ViewCoreFactory>();
+        auto worker = std::make_shared<DispatchQueue>();
+
+        bool builtOnMainThread = true;
+        bool hadCoreAfterBuild = true;
+        std::promise<std::shared_ptr<View>> attached;
+
+        buildViewTreeAsync(
+            worker,
+            [&]() -> std::shared_ptr<View> {
+                builtOnMainThread = Application::isMainThread();
+
+                // No factory is passed, the builder provides it
+                auto container = std::make_shared<ContainerView>();
+                for (int i = 0; i < 10; i++) {
+                    auto label = std::make_shared<Label>();
+                    label->text = "Row " + std::to_string(i);
+                    label->stylesheet = json{{"background-color", "#00ff00"}};
+                    container->addChildView(label);
+                }
+
+                hadCoreAfterBuild = container->hasViewCore();
+                return container;
+            },
+            [&](std::shared_ptr<View> root) {
+                EXPECT_TRUE(Application::isMainThread());
+                attached.set_value(root);
+            },
+            factory);
+
+        auto future = attached.get_future();
+        ASSERT_EQ(future.wait_for(10s), std::future_status::ready);
+        auto root = std::dynamic_pointer_cast<ContainerView>(future.get());
+
+        EXPECT_FALSE(builtOnMainThread);
+        EXPECT_FALSE(hadCoreAfterBuild);
+        ASSERT_NE(root, nullptr);
+        EXPECT_EQ(root->viewCoreFactory(), factory);
+
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            EXPECT_TRUE(root->hasViewCore());
+
+            auto children = root->childViews();
+            ASSERT_EQ(children.size(), 10u);
+            auto label = std::dynamic_pointer_cast<Label>(children.back());
+            ASSERT_TRUE(label->hasViewCore());
+            EXPECT_EQ(std::get<std::string>(label->existingCore<headless::LabelCore>()->text.get()), "Row 9");
+            EXPECT_TRUE(label->viewCore()->backgroundColor.get().has_value());
+        });
+    }
+}
@@ -0,0 +1,452 @@
+#include <bdn/Application.h>
+#include <bdn/ui/ContainerView.h>
+#include <bdn/ui/ContentVirtualizer.h>
+#include <bdn/ui/Label.h>
+#include <bdn/ui/headless.h>
+#include <bdn/ui/yoga.h>
+#include <gtest/gtest.h>
+
+namespace bdn
+{
+    using namespace bdn::ui;
+
+    TEST(YogaLayout, StylesheetCacheSharesCompiledStylesheets)
+    {
+        yoga::StylesheetCache cache;
+
+        auto row = cache.compile(FlexJsonStringify({"size" : {"height" : 44}}));
+        auto sameRow = cache.compile(FlexJsonStringify({"size" : {"height" : 44}}));
+        EXPECT_EQ(row, sameRow);
+        ASSERT_TRUE(row->size.height.has_value());
+        EXPECT_EQ(row->size.height->value, 44.0f);
+
+        // Only the "flex" entry is compiled
+        auto colored = json::parse(R"({"flex": {"size": {"height": 44}}, "background-color": "#ff0000"})");
+        EXPECT_EQ(cache.compile(colored), row);
+
+        auto other = cache.compile(FlexJsonStringify({"size" : {"height" : 88}}));
+        EXPECT_NE(other, row);
+
+        auto empty = cache.compile(json{});
+        EXPECT_EQ(*empty, yoga::FlexStylesheet());
+        EXPECT_EQ(cache.size(), 3u);
+    }
+
+    TEST(YogaLayout, RestylingAppliesChangedValues)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 100};
+
+            std::vector<std::shared_ptr<View>> rows;
+            for (int i = 0; i < 3; i++) {
+                rows.push_back(std::make_shared<ContainerView>(factory));
+                rows.back()->stylesheet = FlexJsonStringify({"size" : {"height" : 10}});
+                container->addChildView(rows.back());
+            }
+
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            EXPECT_EQ(rows[2]->geometry->y, 20.0);
+            EXPECT_EQ(layout->stylesheetCache().size(), 2u);
+
+            rows[0]->stylesheet = FlexJsonStringify({"size" : {"height" : 30}, "margin" : {"top" : 5}});
+            layout->layout(container.get());
+            EXPECT_EQ(rows[1]->geometry->y, 35.0);
+
+            rows[0]->stylesheet = FlexJsonStringify({"size" : {"height" : 10}});
+            layout->layout(container.get());
+            EXPECT_EQ(rows[0]->geometry->y, 0.0);
+            EXPECT_EQ(rows[2]->geometry->y, 20.0);
+        });
+    }
+
+    TEST(YogaLayout, MeasureCache)
+    {
+        yoga::MeasureCache::resetStatistics();
+        yoga::MeasureCache cache;
+
+        EXPECT_FALSE(cache.findSize(100, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f));
+        cache.storeSize(100, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f, YGSize{80, 16});
+
+        auto size = cache.findSize(100, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f);
+        ASSERT_TRUE(size);
+        EXPECT_EQ(size->width, 80.0f);
+        EXPECT_FALSE(cache.findSize(100, YGMeasureModeExactly, NAN, YGMeasureModeUndefined, 1.0f));
+        EXPECT_FALSE(cache.findSize(100, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 2.0f));
+
+        cache.storeBaseline(80, 16, 12);
+        EXPECT_EQ(cache.findBaseline(80, 16), 12.0f);
+
+        cache.invalidate();
+        EXPECT_FALSE(cache.findSize(100, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f));
+        EXPECT_FALSE(cache.findBaseline(80, 16));
+
+        auto statistics = yoga::MeasureCache::statistics();
+        EXPECT_EQ(statistics.measureHitCount, 1u);
+        EXPECT_EQ(statistics.measureMissCount, 4u);
+        EXPECT_EQ(statistics.baselineHitCount, 1u);
+        EXPECT_EQ(statistics.baselineMissCount, 1u);
+    }
+
+    TEST(YogaLayout, MeasureCacheReusesCompatibleConstraints)
+    {
+        yoga::MeasureCache::resetStatistics();
+        yoga::MeasureCache cache;
+
+        // A label that is 80 wide when it may use up to 300 and has no height limit
+        cache.storeSize(300, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f, YGSize{80, 16});
+
+        // Any height that fits, and any narrower width it still fits into, gives the same result
+        EXPECT_TRUE(cache.findSize(300, YGMeasureModeAtMost, 500, YGMeasureModeAtMost, 1.0f));
+        EXPECT_TRUE(cache.findSize(200, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f));
+        EXPECT_TRUE(cache.findSize(80, YGMeasureModeExactly, NAN, YGMeasureModeUndefined, 1.0f));
+
+        EXPECT_FALSE(cache.findSize(300, YGMeasureModeAtMost, 10, YGMeasureModeAtMost, 1.0f));
+        EXPECT_FALSE(cache.findSize(50, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f));
+        EXPECT_FALSE(cache.findSize(400, YGMeasureModeAtMost, NAN, YGMeasureModeUndefined, 1.0f));
+
+        auto statistics = yoga::MeasureCache::statistics();
+        EXPECT_EQ(statistics.measureHitCount, 3u);
+        EXPECT_EQ(statistics.compatibleHitCount, 3u);
+        EXPECT_EQ(statistics.measureMissCount, 3u);
+    }
+
+    TEST(YogaLayout, MeasurementsAreCachedUntilTheCoreIsDirty)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto metrics = std::make_shared<headless::FixedTextMetrics>();
+            auto factory = std::make_shared<headless::ViewCoreFactory>(metrics);
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 100};
+
+            auto label = std::make_shared<Label>(factory);
+            label->text = "Hello";
+            container->addChildView(label);
+            container->viewCore();
+
+            headless::ViewCore::resetStatistics();
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            auto measureCount = headless::ViewCore::statistics().measureCount;
+            EXPECT_GT(measureCount, 0u);
+            EXPECT_EQ(label->geometry->height, metrics->lineHeight());
+
+            // Removing and inserting the node resets its layout in yoga, but the size is still known.
+            // The stylesheet did not change, so it is not looked up again.
+            auto lookupCount = layout->stylesheetCache().lookupCount();
+            label->visible = false;
+            label->visible = true;
+            layout->layout(container.get());
+            EXPECT_EQ(headless::ViewCore::statistics().measureCount, measureCount);
+            EXPECT_EQ(layout->stylesheetCache().lookupCount(), lookupCount);
+
+            label->text = "Hello World";
+            layout->layout(container.get());
+            EXPECT_GT(headless::ViewCore::statistics().measureCount, measureCount);
+        });
+    }
+
+    TEST(YogaLayout, RegisteringViewsCreatesNoCores)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            auto child = std::make_shared<ContainerView>(factory);
+            container->addChildView(child);
+
+            container->ensureLayoutRegistration();
+            EXPECT_EQ(layout->viewCount(), 2u);
+            EXPECT_FALSE(container->hasViewCore());
+            EXPECT_FALSE(child->hasViewCore());
+        });
+    }
+
+    TEST(YogaLayout, ProfilerRecordsLayoutsAndThrash)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 100};
+
+            auto label = std::make_shared<Label>(factory);
+            label->text = "Hello";
+            container->addChildView(label);
+            container->viewCore();
+
+            yoga::LayoutProfiler::enabled() = true;
+            yoga::LayoutProfiler::reset();
+            yoga::LayoutProfiler::setDebugName(container.get(), "list");
+
+            size_t thrashCount = 0;
+            yoga::LayoutProfiler::setThrashHandler([&](const View *root, size_t layoutCount) {
+                EXPECT_EQ(root, container.get());
+                EXPECT_EQ(layoutCount, 3u);
+                thrashCount++;
+            });
+
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            label->text = "Hello World";
+            layout->layout(container.get());
+            layout->layout(container.get());
+            EXPECT_EQ(thrashCount, 1u);
+
+            yoga::LayoutProfiler::endFrame();
+
+            auto statistics = yoga::LayoutProfiler::statistics();
+            EXPECT_EQ(statistics.frameCount, 1u);
+            EXPECT_EQ(statistics.thrashingFrameCount, 1u);
+            EXPECT_EQ(statistics.layoutCount, 3u);
+            EXPECT_EQ(statistics.maximumLayoutsPerFrame, 3u);
+
+            auto views = yoga::LayoutProfiler::viewStatistics();
+            EXPECT_EQ(views[container.get()].layoutCount, 3u);
+            EXPECT_EQ(views[container.get()].debugName, "list");
+            EXPECT_GT(views[label.get()].measureCount, 0u);
+            auto coreSource = static_cast<size_t>(yoga::LayoutProfiler::DirtySource::core);
+            EXPECT_GT(views[label.get()].dirtyCounts[coreSource], 0u);
+
+            auto profile = json::parse(yoga::LayoutProfiler::toJson());
+            EXPECT_EQ(profile["layouts"], 3);
+            EXPECT_EQ(profile["recentFrames"].size(), 1u);
+            EXPECT_TRUE(profile["recentFrames"][0]["thrashing"].get<bool>());
+
+            // Views that leave the layout are forgotten before their address can be reused
+            container->removeChildView(label);
+            EXPECT_EQ(yoga::LayoutProfiler::viewStatistics().count(label.get()), 0u);
+
+            yoga::LayoutProfiler::setThrashHandler(nullptr);
+            yoga::LayoutProfiler::enabled() = false;
+        });
+    }
+
+    TEST(YogaLayout, OnlyNewLayoutsAreApplied)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 1000};
+
+            std::vector<std::shared_ptr<View>> rows;
+            for (int i = 0; i < 20; i++) {
+                auto row = std::make_shared<ContainerView>(factory);
+                row->stylesheet = FlexJsonStringify({"direction" : "Row", "size" : {"height" : 10}});
+                row->addChildView(std::make_shared<ContainerView>(factory));
+                container->addChildView(row);
+                rows.push_back(row);
+            }
+
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            EXPECT_EQ(layout->lastApplyStatistics().visitedCount, 40u);
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 40u);
+
+            layout->layout(container.get());
+            EXPECT_EQ(layout->lastApplyStatistics().visitedCount, 0u);
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 0u);
+
+            rows.back()->stylesheet = FlexJsonStringify({"direction" : "Row", "size" : {"height" : 20}});
+            layout->layout(container.get());
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 2u);
+            EXPECT_LT(layout->lastApplyStatistics().visitedCount, 40u);
+            EXPECT_EQ(rows.back()->geometry->height, 20.0);
+            EXPECT_EQ(rows.back()->childViews().front()->geometry->height, 20.0);
+        });
+    }
+
+    TEST(YogaLayout, AddingAChildOnlyUpdatesItsParent)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 1000};
+
+            const json rowStyle = FlexJsonStringify({"size" : {"height" : 10}});
+            std::vector<std::shared_ptr<ContainerView>> sections;
+            for (int i = 0; i < 5; i++) {
+                auto section = std::make_shared<ContainerView>(factory);
+                for (int j = 0; j < 10; j++) {
+                    auto row = std::make_shared<ContainerView>(factory);
+                    row->stylesheet = rowStyle;
+                    section->addChildView(row);
+                }
+                container->addChildView(section);
+                sections.push_back(section);
+            }
+
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            EXPECT_EQ(sections[4]->geometry->y, 400.0);
+
+            yoga::LayoutProfiler::enabled() = true;
+            yoga::LayoutProfiler::reset();
+
+            auto row = std::make_shared<ContainerView>(factory);
+            row->stylesheet = rowStyle;
+            sections[3]->addChildView(row);
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+
+            EXPECT_EQ(row->geometry->y, 100.0);
+            EXPECT_EQ(sections[4]->geometry->y, 410.0);
+
+            // The ancestors of the new row keep their yoga children
+            auto views = yoga::LayoutProfiler::viewStatistics();
+            auto childrenSource = static_cast<size_t>(yoga::LayoutProfiler::DirtySource::children);
+            EXPECT_EQ(views[container.get()].dirtyCounts[childrenSource], 0u);
+            EXPECT_EQ(views[sections[2].get()].dirtyCounts[childrenSource], 0u);
+            EXPECT_EQ(views[sections[3].get()].dirtyCounts[childrenSource], 1u);
+
+            yoga::LayoutProfiler::enabled() = false;
+        });
+    }
+
+    TEST(YogaLayout, VirtualizedContentUsesMeasuredExtents)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto content = std::make_shared<ContainerView>(factory);
+            content->setLayout(layout);
+            content->geometry = Rect{0, 0, 100, 100};
+
+            std::vector<std::shared_ptr<View>> rows;
+            for (int i = 0; i < 1000; i++) {
+                auto row = std::make_shared<ContainerView>(factory);
+                row->stylesheet = FlexJsonStringify({"flexShrink" : 0, "size" : {"height" : 30}});
+                row->addChildView(std::make_shared<ContainerView>(factory));
+                rows.push_back(row);
+            }
+            content->addChildViews(rows);
+
+            ContentVirtualizer virtualizer(content);
+            virtualizer.update(Rect{0, 200, 100, 100}, 0, 20, true);
+            EXPECT_EQ(content->materializedRange(), std::pair<size_t, size_t>(10, 16));
+
+            // The leading placeholder stands in for the estimated extent of the first ten rows
+            content->ensureLayoutRegistration();
+            layout->layout(content.get());
+            EXPECT_EQ(rows[10]->geometry.get(), Rect(0, 200, 100, 30));
+            EXPECT_EQ(rows[15]->geometry.get(), Rect(0, 350, 100, 30));
+            // The content, its placeholders and six rows with a child each
+            EXPECT_EQ(layout->viewCount(), 15u);
+
+            // The next update picks up the measured rows, fewer of them fit into the visible rect
+            virtualizer.update(Rect{0, 200, 100, 100}, 0, 20, true);
+            EXPECT_EQ(virtualizer.totalExtent(), 994 * 20. + 6 * 30.);
+            EXPECT_EQ(content->materializedRange(), std::pair<size_t, size_t>(10, 14));
+
+            content->ensureLayoutRegistration();
+            layout->layout(content.get());
+            EXPECT_EQ(rows[13]->geometry.get(), Rect(0, 290, 100, 30));
+
+            // Released rows leave the layout together with their children
+            EXPECT_EQ(layout->viewCount(), 11u);
+        });
+    }
+
+    TEST(YogaLayout, ResultCacheRestoresRecentSizes)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto factory = std::make_shared<headless::ViewCoreFactory>();
+            auto layout = std::make_shared<yoga::Layout>();
+            auto container = std::make_shared<ContainerView>(factory);
+            container->setLayout(layout);
+            container->geometry = Rect{0, 0, 100, 200};
+            container->stylesheet = FlexJsonStringify({"direction" : "Row"});
+
+            std::vector<std::shared_ptr<View>> columns;
+            for (int i = 0; i < 4; i++) {
+                auto column = std::make_shared<ContainerView>(factory);
+                column->stylesheet = FlexJsonStringify({"flexGrow" : 1});
+                column->addChildView(std::make_shared<ContainerView>(factory));
+                container->addChildView(column);
+                columns.push_back(column);
+            }
+
+            yoga::LayoutResultCache::resetStatistics();
+            container->ensureLayoutRegistration();
+            layout->layout(container.get());
+            EXPECT_EQ(columns[1]->geometry.get(), Rect(25, 0, 25, 200));
+
+            // Rotating stores the results of the first size, rotating back restores them
+            container->geometry = Rect{0, 0, 200, 100};
+            layout->layout(container.get());
+            EXPECT_EQ(columns[1]->geometry.get(), Rect(50, 0, 50, 100));
+
+            container->geometry = Rect{0, 0, 100, 200};
+            layout->layout(container.get());
+            EXPECT_EQ(columns[1]->geometry.get(), Rect(25, 0, 25, 200));
+            EXPECT_EQ(columns[1]->childViews().front()->geometry->width, 25.0);
+            EXPECT_EQ(layout->lastApplyStatistics().changedCount, 8u);
+
+            container->geometry = Rect{0, 0, 200, 100};
+            layout->layout(container.get());
+            EXPECT_EQ(columns[3]->geometry.get(), Rect(150, 0, 50, 100));
+
+            auto statistics = yoga::LayoutResultCache::statistics();
+            EXPECT_EQ(statistics.hitCount, 2u);
+            EXPECT_EQ(statistics.missCount, 1u);
+
+            // A changed style makes the stored results unusable
+            columns[0]->stylesheet = FlexJsonStringify({"flexGrow" : 2});
+            container->geometry = Rect{0, 0, 100, 200};
+            layout->layout(container.get());
+            EXPECT_EQ(columns[0]->geometry.get(), Rect(0, 0, 40, 200));
+            EXPECT_EQ(yoga::LayoutResultCache::statistics().hitCount, 2u);
+        });
+    }
+
+    TEST(YogaLayout, ConfigPerPointScaleFactor)
+    {
+        bdn::App()->dispatchQueue()->dispatchSync([=]() {
+            auto layout = std::make_shared<yoga::Layout>();
+
+            std::vector<std::shared_ptr<View>> rows;
+            std::vector<std::shared_ptr<ContainerView>> roots;
+            for (float pointScaleFactor : {1.0f, 2.0f}) {
+                auto factory = std::make_shared<headless::ViewCoreFactory>(nullptr, pointScaleFactor);
+                auto root = std::make_shared<ContainerView>(factory);
+                root->setLayout(layout);
+                root->geometry = Rect{0, 0, 100, 100};
+
+                auto row = std::make_shared<ContainerView>(factory);
+                row->stylesheet = FlexJsonStringify({"size" : {"height" : 10.3}});
+                root->addChildView(row);
+
+                root->ensureLayoutRegistration();
+                layout->layout(root.get());
+                roots.push_back(root);
+                rows.push_back(row);
+            }
+
+            // Results are rounded to the pixel grid of each root's own scale factor
+            EXPECT_EQ(rows[0]->geometry->height, 10.0);
+            EXPECT_EQ(rows[1]->geometry->height, 10.5);
+            EXPECT_EQ(layout->nodePool().configCount(), 2u);
+
+            auto createdCount = layout->nodePool().createdCount();
+            roots[0]->removeAllChildViews();
+            roots[0]->ensureLayoutRegistration();
+            EXPECT_EQ(layout->nodePool().freeCount(), 1u);
+
+            roots[0]->addChildView(std::make_shared<ContainerView>(roots[0]->viewCoreFactory()));
+            roots[0]->ensureLayoutRegistration();
+            EXPECT_EQ(layout->nodePool().freeCount(), 0u);
+            EXPECT_EQ(layout->nodePool().createdCount(), createdCount);
+        });
+    }}